@@ -0,0 +1,38 @@
+
+#ifndef CANCELLATION_TOKEN_HPP_INCLUDED
+#define CANCELLATION_TOKEN_HPP_INCLUDED
+
+#include <atomic>
+#include <memory>
+
+
+/**
+ * @brief Shared cancellation flag
+ *
+ * Copies of token share state, so a token can be passed along with a task
+ * while its owner keeps a copy to cancel the task when result is not needed anymore.
+ */
+class CancellationToken
+{
+    public:
+        CancellationToken()
+            : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+        {
+
+        }
+
+        void cancel()
+        {
+            *m_cancelled = true;
+        }
+
+        bool isCancelled() const
+        {
+            return *m_cancelled;
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+#endif
@@ -22,7 +22,7 @@ namespace ConfigConsts
 namespace ExternalToolsConfigKeys
 {
     [[deprecated]] const char* const convertPath = "tool_path::convert";
-    const char* const aisPath      = "tool_path::align_image_stack";
+    [[deprecated]] const char* const aisPath      = "tool_path::align_image_stack";
     [[deprecated]] const char* const magickPath   = "tool_path::magick";
     [[deprecated]] const char* const ffmpegPath   = "tool_path::ffmpeg";
     [[deprecated]] const char* const ffprobePath  = "tool_path::ffprobe";
@@ -15,7 +15,9 @@ addTestTarget(core
                     implementation/qmodelindex_selector.cpp
                     implementation/qmodelindex_comparator.cpp
                     implementation/tag.cpp
+                    implementation/task_executor.cpp
                     implementation/task_executor_utils.cpp
+                    implementation/thread_utils_null.cpp
                     imodel_compositor_data_source.hpp
 
                     unit_tests/containers_utils_tests.cpp
@@ -27,6 +29,7 @@ addTestTarget(core
                     unit_tests/qmodelindex_comparator_tests.cpp
                     unit_tests/qmodelindex_selector_tests.cpp
                     unit_tests/status_tests.cpp
+                    unit_tests/task_executor_tests.cpp
                     unit_tests/tag_value_tests.cpp
                 LIBRARIES
                     GTest::gtest
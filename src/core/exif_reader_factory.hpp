@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <thread>
 
 #include "iexif_reader.hpp"
@@ -24,6 +25,7 @@ class CORE_EXPORT ExifReaderFactory: public IExifReaderFactory
 
     private:
         std::map<std::thread::id, std::unique_ptr<IExifReader>> m_feeders;
+        std::mutex m_feedersMutex;
 };
 
 #endif
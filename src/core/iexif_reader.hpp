@@ -26,6 +26,7 @@ struct CORE_EXPORT IExifReader
         PixelXDimension,           // long
         PixelYDimension,           // long
         Exposure,                  // float
+        Preview,                   // QByteArray - largest embedded preview image (encoded)
     };
 
     virtual ~IExifReader() = default;
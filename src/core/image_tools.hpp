@@ -14,6 +14,10 @@ namespace Image
     OrientedImage CORE_EXPORT normalized(const QString &,
                                          IExifReader &);      // returns OrientedImage rotated acordingly to exif data
 
+    OrientedImage CORE_EXPORT normalized(const QString &,
+                                         IExifReader &,
+                                         const QSize &);      // as above, but image is downscaled while decoding to cover given size
+
     bool CORE_EXPORT normalize(const QString& src,
                                const QString& dst,
                                IExifReader &);                // save 'src' file as 'dst' with rotation data applied
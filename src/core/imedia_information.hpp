@@ -7,6 +7,8 @@
 #include <QSize>
 #include <QDateTime>
 
+class QImageReader;
+
 
 struct MediaFile
 {
@@ -16,6 +18,8 @@ struct MediaFile
 
 struct ImageFile
 {
+    std::optional<int> sequenceNumber;      // number of shot in series
+    std::optional<float> exposure;          // exposure bias in EV
 };
 
 struct VideoFile
@@ -35,6 +39,14 @@ struct IMediaInformation
     virtual ~IMediaInformation() = default;
 
     virtual FileInformation getInformation(const QString &) const = 0;
+
+    /**
+     * \brief read file information using provided image reader
+     *
+     * Image header is read with given reader, which then can be used to decode image
+     * without opening the file again.
+     */
+    virtual FileInformation getInformation(const QString &, QImageReader &) const = 0;
 };
 
 #endif
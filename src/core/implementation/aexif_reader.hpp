@@ -22,10 +22,9 @@
 
 #include <thread>
 
-#include "iexif_reader.hpp"
-
+#include <QByteArray>
 
-class QByteArray;
+#include "iexif_reader.hpp"
 
 
 class AExifReader: public IExifReader
@@ -40,6 +39,7 @@ class AExifReader: public IExifReader
     protected:
         virtual void collect(const QString &) = 0;
         virtual std::optional<std::string> read(TagType) const = 0;
+        virtual std::optional<QByteArray> readPreview() const = 0;
 
     private:
         std::thread::id m_id;
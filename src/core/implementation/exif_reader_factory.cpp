@@ -10,7 +10,7 @@
 #include "iexif_reader.hpp"
 
 
-ExifReaderFactory::ExifReaderFactory(): m_feeders()
+ExifReaderFactory::ExifReaderFactory(): m_feeders(), m_feedersMutex()
 {
     static bool initialized = false;
     static std::recursive_mutex xmpMutex;
@@ -40,6 +40,7 @@ IExifReader& ExifReaderFactory::get()
 {
     //ExifTool may not be thread safe. Prepare separate object for each thread
     const auto id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_feedersMutex);
     auto it = m_feeders.find(id);
 
     if (it == m_feeders.end())
@@ -0,0 +1,146 @@
+#include "exiftool_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include <QProcess>
+
+#include "exiftool_video_details_reader.hpp"
+#include "thread_utils.hpp"
+
+
+namespace
+{
+    // exiftool prints this marker when done with a command
+    const QByteArray ReadyMarker = "{ready}";
+
+    // time exiftool has for producing any output
+    constexpr int ExiftoolTimeout = 60000;
+}
+
+
+ExiftoolPool::ExiftoolPool(const QString& exiftoolPath, std::size_t workers)
+    : m_exiftoolPath(exiftoolPath)
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(workers, 1); i++)
+        m_workers.emplace_back(&ExiftoolPool::work, this);
+}
+
+
+ExiftoolPool::~ExiftoolPool()
+{
+    m_jobs.stop();
+
+    for (std::thread& worker: m_workers)
+        worker.join();
+}
+
+
+std::shared_ptr<ExiftoolPool> ExiftoolPool::get(const QString& exiftoolPath)
+{
+    static std::mutex poolsMutex;
+    static std::map<QString, std::weak_ptr<ExiftoolPool>> pools;
+
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    std::shared_ptr<ExiftoolPool> pool = pools[exiftoolPath].lock();
+
+    if (pool.get() == nullptr)
+    {
+        const std::size_t workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+
+        pool = std::make_shared<ExiftoolPool>(exiftoolPath, workers);
+        pools[exiftoolPath] = pool;
+    }
+
+    return pool;
+}
+
+
+std::map<QString, ExiftoolPool::Entries> ExiftoolPool::read(const QStringList& paths, const QStringList& tags)
+{
+    const qsizetype workers = static_cast<qsizetype>(m_workers.size());
+    const qsizetype batchSize = (paths.size() + workers - 1) / workers;
+
+    std::vector<std::future<QByteArray>> outputs;
+
+    for (qsizetype i = 0; i < paths.size(); i += batchSize)
+    {
+        auto job = std::make_unique<Job>();
+        job->arguments << "-json" << "-charset" << "filename=utf8" << tags << paths.mid(i, batchSize);
+
+        outputs.push_back(job->output.get_future());
+        m_jobs.push(std::move(job));
+    }
+
+    std::map<QString, Entries> result;
+
+    for (auto& output: outputs)
+        result.merge(ExiftoolUtils::parseJsonOutput(output.get()));
+
+    return result;
+}
+
+
+void ExiftoolPool::work()
+{
+    set_thread_name("Exiftool");
+
+    QProcess exiftool;
+
+    for(;;)
+    {
+        std::optional<std::unique_ptr<Job>> job = m_jobs.pop();
+
+        if (job.has_value() == false)
+            break;
+
+        (*job)->output.set_value(execute(exiftool, (*job)->arguments));
+    }
+
+    if (exiftool.state() == QProcess::Running)
+    {
+        exiftool.write("-stay_open\nFalse\n");
+        exiftool.closeWriteChannel();
+
+        if (exiftool.waitForFinished() == false)
+            exiftool.kill();
+    }
+}
+
+
+QByteArray ExiftoolPool::execute(QProcess& exiftool, const QStringList& arguments) const
+{
+    if (exiftool.state() != QProcess::Running)
+    {
+        exiftool.setStandardErrorFile(QProcess::nullDevice());
+        exiftool.start(m_exiftoolPath, {"-stay_open", "True", "-@", "-"});
+
+        if (exiftool.waitForStarted() == false)
+            return {};
+    }
+
+    // one argument per line, command is executed when -execute is read
+    const QByteArray command = arguments.join('\n').toUtf8() + "\n-execute\n";
+    exiftool.write(command);
+
+    QByteArray output;
+
+    while (output.trimmed().endsWith(ReadyMarker) == false)
+    {
+        if (exiftool.waitForReadyRead(ExiftoolTimeout) == false)
+        {
+            // exiftool hangs or died, it will be restarted with next command
+            exiftool.kill();
+            exiftool.waitForFinished();
+
+            return {};
+        }
+
+        output += exiftool.readAllStandardOutput();
+    }
+
+    output = output.trimmed();
+    output.chop(ReadyMarker.size());
+
+    return output;
+}
@@ -0,0 +1,69 @@
+#ifndef EXIFTOOL_POOL_HPP_INCLUDED
+#define EXIFTOOL_POOL_HPP_INCLUDED
+
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QByteArray>
+#include <QStringList>
+
+#include "ts_queue.hpp"
+
+class QProcess;
+
+
+/**
+ * @brief Pool of long living exiftool processes
+ *
+ * Each worker keeps its own exiftool started in `-stay_open` mode and feeds it
+ * with commands through stdin, so perl interpreter is started once per worker
+ * and not once per file.
+ * Processes are started lazily, with the first command sent to a worker.
+ */
+class ExiftoolPool
+{
+    public:
+        using Entries = std::map<QString, QString>;
+
+        ExiftoolPool(const QString& exiftoolPath, std::size_t workers);
+        ExiftoolPool(const ExiftoolPool &) = delete;
+        ~ExiftoolPool();
+
+        ExiftoolPool& operator=(const ExiftoolPool &) = delete;
+
+        /**
+         * @brief get pool shared by all users of given exiftool executable
+         *
+         * Pool lives as long as anyone holds it.
+         */
+        static std::shared_ptr<ExiftoolPool> get(const QString& exiftoolPath);
+
+        /**
+         * @brief read tags of many files at once
+         * @param paths files to be read
+         * @param tags exiftool tag names (like `-ImageWidth`) to be read. All tags are read when empty.
+         * @return tags of each file which could be read, by file path
+         *
+         * Files are split into one batch per worker and processed in parallel.
+         */
+        std::map<QString, Entries> read(const QStringList& paths, const QStringList& tags = {});
+
+    private:
+        struct Job
+        {
+            QStringList arguments;
+            std::promise<QByteArray> output;
+        };
+
+        const QString m_exiftoolPath;
+        ol::TS_Queue<std::unique_ptr<Job>> m_jobs;
+        std::vector<std::thread> m_workers;
+
+        void work();
+        QByteArray execute(QProcess &, const QStringList& arguments) const;
+};
+
+#endif
@@ -2,57 +2,37 @@
 #include "exiftool_video_details_reader.hpp"
 
 #include <cassert>
+#include <cmath>
 
-#include <QProcess>
-#include <QRegularExpression>
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTimeZone>
 
 
 
 namespace ExiftoolUtils
 {
-    QStringList exiftoolOutput(const QString& exiftoolPath, const QString& filePath)
+    std::map<QString, std::map<QString, QString>> parseJsonOutput(const QByteArray& output)
     {
-        QProcess exiftool_process;
-        exiftool_process.setProcessChannelMode(QProcess::MergedChannels);
+        std::map<QString, std::map<QString, QString>> files;
 
-        const QStringList exiftool_args = { filePath };
+        const QJsonDocument document = QJsonDocument::fromJson(output);
+        const QJsonArray entries = document.array();
 
-        exiftool_process.start(exiftoolPath, exiftool_args );
-        bool status = exiftool_process.waitForFinished();
-        status &= exiftool_process.exitCode() == 0;
-
-        QStringList result;
-        if (status)
-            while(exiftool_process.canReadLine())
-            {
-                const QByteArray line = exiftool_process.readLine();
-                result.append(line.constData());
-            }
-
-        return result;
-    }
+        for(const QJsonValue& entry: entries)
+        {
+            const QJsonObject tags = entry.toObject();
+            std::map<QString, QString> pairs;
 
-    std::map<QString, QString> parseOutput(const QStringList& entries)
-    {
-        std::map<QString, QString> pairs;
+            for(auto it = tags.begin(); it != tags.end(); ++it)
+                pairs.emplace(it.key(), it.value().toVariant().toString());
 
-        for(const QString& entry: entries)
-        {
-            const auto colon = entry.indexOf(":");
-            if (colon != -1)
-            {
-                const QString entryKeyRaw = entry.first(colon);
-                const QString entryKey = entryKeyRaw.trimmed();
-                const QString valueRaw = entry.sliced(colon + 1);
-                const QString value = valueRaw.trimmed();
-
-                pairs.emplace(entryKey, value);
-            }
+            files.emplace(tags.value("SourceFile").toString(), pairs);
         }
 
-        return pairs;
+        return files;
     }
 }
 
@@ -74,8 +54,8 @@ std::optional<QSize> ExiftoolVideoDetailsReader::resolutionOf() const
 {
     std::optional<QSize> result;
 
-    auto widthIt = m_entries.find("Image Width");
-    auto heightIt = m_entries.find("Image Height");
+    auto widthIt = m_entries.find("ImageWidth");
+    auto heightIt = m_entries.find("ImageHeight");
 
     if (widthIt != m_entries.end() && heightIt != m_entries.end())
     {
@@ -97,25 +77,31 @@ std::optional<QSize> ExiftoolVideoDetailsReader::resolutionOf() const
 }
 
 
-std::optional<int> ExiftoolVideoDetailsReader::durationOf() const
+std::optional<std::chrono::milliseconds> ExiftoolVideoDetailsReader::durationOf() const
 {
-    std::optional<int> result;
+    std::optional<std::chrono::milliseconds> result;
 
     auto durationIt = m_entries.find("Duration");
 
     if (durationIt != m_entries.end())
     {
         const QString& durationStr = durationIt->second;
-        if (durationStr.indexOf("s") == -1)
+
+        bool isNumber = false;
+        const double seconds = durationStr.toDouble(&isNumber);
+
+        if (isNumber)                                   // numerical value (-Duration#)
+            result = std::chrono::milliseconds(std::llround(seconds * 1000));
+        else if (durationStr.indexOf("s") == -1)
         {
             const QTime durationTime = QTime::fromString(durationStr, "H:mm:ss");
-            result = QTime(0, 0, 0).secsTo(durationTime);
+            result = std::chrono::milliseconds(QTime(0, 0, 0).msecsTo(durationTime));
         }
         else
         {
             const QString durationStrTrimmed = durationStr.chopped(2);   // remove " s"
             const QTime durationTime = QTime::fromString(durationStrTrimmed, "ss.z");
-            result = QTime(0, 0, 0).secsTo(durationTime);
+            result = std::chrono::milliseconds(QTime(0, 0, 0).msecsTo(durationTime));
         }
     }
 
@@ -127,7 +113,7 @@ std::optional<QDateTime> ExiftoolVideoDetailsReader::creationTime() const
 {
     std::optional<QDateTime> result;
 
-    auto datetimeIt = m_entries.find("Date/Time Original");
+    auto datetimeIt = m_entries.find("DateTimeOriginal");
 
     if (datetimeIt != m_entries.end())
     {
@@ -140,7 +126,7 @@ std::optional<QDateTime> ExiftoolVideoDetailsReader::creationTime() const
             result = datetime;
     }
 
-    if ( !result && (datetimeIt = m_entries.find("Create Date")) != m_entries.end())
+    if ( !result && (datetimeIt = m_entries.find("CreateDate")) != m_entries.end())
     {
         const QString& datetimeStr = datetimeIt->second;
         QDateTime datetime = QDateTime::fromString(datetimeStr, "yyyy:MM:dd hh:mm:ss");
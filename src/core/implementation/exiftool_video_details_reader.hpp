@@ -1,7 +1,10 @@
 
 
+#include <chrono>
+#include <map>
 #include <optional>
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QSize>
 #include <QStringList>
@@ -9,8 +12,8 @@
 
 namespace ExiftoolUtils
 {
-    QStringList exiftoolOutput(const QString& exiftoolPath, const QString& filePath);
-    std::map<QString, QString> parseOutput(const QStringList &);
+    // parse output of `exiftool -json`. Returns tags of each file by file path
+    std::map<QString, std::map<QString, QString>> parseJsonOutput(const QByteArray &);
 }
 
 
@@ -22,7 +25,7 @@ class ExiftoolVideoDetailsReader
         bool hasDetails() const;                        // checks if input data contain any usefull details
 
         std::optional<QSize> resolutionOf() const;
-        std::optional<int> durationOf() const;          // video duration in seconds
+        std::optional<std::chrono::milliseconds> durationOf() const;     // video duration
         std::optional<QDateTime> creationTime() const;  // creation time from video metadata
 
     private:
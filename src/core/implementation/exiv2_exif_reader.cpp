@@ -87,3 +87,30 @@ std::optional<std::string> Exiv2ExifReader::read(AExifReader::TagType type) cons
 
     return result;
 }
+
+
+std::optional<QByteArray> Exiv2ExifReader::readPreview() const
+{
+    std::optional<QByteArray> result;
+
+    if (m_exif_data.get() != nullptr)
+    {
+        try
+        {
+            Exiv2::PreviewManager previewManager(*m_exif_data);
+            const Exiv2::PreviewPropertiesList properties = previewManager.getPreviewProperties();
+
+            // list is sorted by preview size, take the biggest one
+            if (properties.empty() == false)
+            {
+                const Exiv2::PreviewImage preview = previewManager.getPreviewImage(properties.back());
+                result = QByteArray(reinterpret_cast<const char *>(preview.pData()), static_cast<qsizetype>(preview.size()));
+            }
+        }
+        catch (Exiv2::AnyError &)
+        {
+        }
+    }
+
+    return result;
+}
@@ -35,18 +35,27 @@ ImageMediaInformation::ImageMediaInformation(IExifReaderFactory& exif, ILogger&
 
 
 FileInformation ImageMediaInformation::getInformation(const QString& path) const
+{
+    QImageReader reader(path);
+
+    return getInformation(path, reader);
+}
+
+
+FileInformation ImageMediaInformation::getInformation(const QString& path, QImageReader& reader) const
 {
     IExifReader& exif = m_exif.get();
 
     FileInformation info;
-    info.common.dimension = size(path, exif);
+    info.common.dimension = size(path, reader, exif);
     info.common.creationTime = creationTime(path, exif);
+    info.details = details(path, exif);
 
     return info;
 }
 
 
-std::optional<QSize> ImageMediaInformation::size(const QString& path, IExifReader& exif) const
+std::optional<QSize> ImageMediaInformation::size(const QString& path, QImageReader& reader, IExifReader& exif) const
 {
     // Here we could have used exif's
     // Exif.Photo.PixelYDimension or
@@ -58,7 +67,6 @@ std::optional<QSize> ImageMediaInformation::size(const QString& path, IExifReade
 
     std::optional<QSize> result;
 
-    const QImageReader reader(path);
     const QSize size = reader.size();
 
     if (size.isValid())
@@ -146,3 +154,20 @@ std::optional<QDateTime> ImageMediaInformation::creationTime(const QString& path
 
     return result;
 }
+
+
+ImageFile ImageMediaInformation::details(const QString& path, IExifReader& exif) const
+{
+    ImageFile result;
+
+    const auto sequence_raw = exif.get(path, IExifReader::TagType::SequenceNumber);
+    const auto exposure_raw = exif.get(path, IExifReader::TagType::Exposure);
+
+    if (sequence_raw.has_value())
+        result.sequenceNumber = std::any_cast<int>(*sequence_raw);
+
+    if (exposure_raw.has_value())
+        result.exposure = std::any_cast<float>(*exposure_raw);
+
+    return result;
+}
@@ -38,13 +38,15 @@ class CORE_EXPORT ImageMediaInformation
         ImageMediaInformation& operator=(const ImageMediaInformation &) = delete;
 
         FileInformation getInformation(const QString &) const;
+        FileInformation getInformation(const QString &, QImageReader &) const;
 
     private:
         IExifReaderFactory& m_exif;
         ILogger& m_logger;
 
-        std::optional<QSize> size(const QString &, IExifReader &) const;
+        std::optional<QSize> size(const QString &, QImageReader &, IExifReader &) const;
         std::optional<QDateTime> creationTime(const QString &, IExifReader &) const;
+        ImageFile details(const QString &, IExifReader &) const;
 };
 
 #endif // PHOTOINFORMATION_H
@@ -14,6 +14,12 @@ namespace Image
     }
 
 
+    OrientedImage normalized(const QString& src, IExifReader& exif, const QSize& minimalSize)
+    {
+        return OrientedImage(exif, src, minimalSize);
+    }
+
+
     bool normalize(const QString& src, const QString& dst, IExifReader& exif)
     {
         const OrientedImage oi = normalized(src, exif);
@@ -75,3 +75,15 @@ FileInformation MediaInformation::getInformation(const QString& path) const
 
     return info;
 }
+
+
+FileInformation MediaInformation::getInformation(const QString& path, QImageReader& reader) const
+{
+    const QFileInfo fileInfo(path);
+    const QString full_path = fileInfo.absoluteFilePath();
+
+    // reader is useful for images only
+    return MediaTypes::isImageFile(full_path)?
+        m_impl->m_image_info.getInformation(full_path, reader):
+        getInformation(path);
+}
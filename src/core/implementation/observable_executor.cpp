@@ -38,6 +38,12 @@ double ObservableExecutor::executionSpeed() const
 }
 
 
+const QVariantMap& ObservableExecutor::statistics() const
+{
+    return m_statistics;
+}
+
+
 void ObservableExecutor::newTaskInQueue()
 {
     m_awaitingTasks++;
@@ -65,6 +71,20 @@ void ObservableExecutor::taskExecuted()
 }
 
 
+void ObservableExecutor::taskDropped()
+{
+    m_awaitingTasks--;
+
+    emit awaitingTasksChanged(m_awaitingTasks);
+}
+
+
+QVariantMap ObservableExecutor::collectStatistics() const
+{
+    return {};
+}
+
+
 void ObservableExecutor::updateExecutionSpeed()
 {
     const std::size_t bufferSize = m_executionSpeedBuffer.size();
@@ -75,4 +95,7 @@ void ObservableExecutor::updateExecutionSpeed()
     m_executionSpeed = std::accumulate(m_executionSpeedBuffer.begin(), m_executionSpeedBuffer.end(), 0) / static_cast<double>(bufferSize);
 
     emit executionSpeedChanged(m_executionSpeed);
+
+    m_statistics = collectStatistics();
+    emit statisticsChanged(m_statistics);
 }
@@ -17,7 +17,10 @@
  */
 
 
+#include <algorithm>
 #include <any>
+#include <cmath>
+#include <QBuffer>
 #include <QFileInfo>
 #include <QImageReader>
 
@@ -25,30 +28,22 @@
 #include "oriented_image.hpp"
 
 
-OrientedImage::OrientedImage():
-    m_oriented()
+namespace
 {
-}
-
-
-OrientedImage::OrientedImage(IExifReader& exif, const QString& src):
-    m_oriented()
-{
-    QImage img(src);
-    QImage rotated;
-
-    if (img.isNull())
-    {
-        QImageReader check(src);
-        qDebug() << check.errorString();
-    }
-    else
+    int readOrientation(IExifReader& exif, const QString& src)
     {
         const std::optional<std::any> orientation_raw = exif.get(src, IExifReader::TagType::Orientation);
         const int orientation = orientation_raw.has_value()?
                                     std::any_cast<int>(*orientation_raw):
                                     0;
 
+        return orientation;
+    }
+
+    QImage orient(const QImage& img, int orientation)
+    {
+        QImage rotated;
+
         switch(orientation)
         {
             case 0:
@@ -109,9 +104,106 @@ OrientedImage::OrientedImage(IExifReader& exif, const QString& src):
                 break;
             }
         }
+
+        return rotated;
     }
 
-    m_oriented = rotated;
+    // Longer edge of minimal size is used as a requirement for image's shorter edge.
+    // This way requirement is met no matter how image is going to be rotated.
+    int requiredEdge(const QSize& minimal)
+    {
+        return std::max(minimal.width(), minimal.height());
+    }
+
+    QSize scaledSize(const QSize& size, const QSize& minimal)
+    {
+        const int required = requiredEdge(minimal);
+        const int shorter = std::min(size.width(), size.height());
+
+        if (shorter <= required)
+            return size;
+
+        const double factor = static_cast<double>(required) / shorter;
+
+        return QSize(static_cast<int>(std::ceil(size.width() * factor)),
+                     static_cast<int>(std::ceil(size.height() * factor)));
+    }
+
+    QImage read(QImageReader& reader, const QSize& minimal)
+    {
+        if (minimal.isValid())
+        {
+            const QSize size = reader.size();
+
+            // for jpegs decoder will use DCT scaling which is much faster than full decoding
+            if (size.isValid())
+                reader.setScaledSize(scaledSize(size, minimal));
+        }
+
+        return reader.read();
+    }
+
+    QImage readPreview(IExifReader& exif, const QString& src, const QSize& fullSize, const QSize& minimal)
+    {
+        QImage image;
+
+        const std::optional<std::any> preview_raw = exif.get(src, IExifReader::TagType::Preview);
+
+        if (preview_raw.has_value() && fullSize.isValid())
+        {
+            QByteArray previewData = std::any_cast<QByteArray>(*preview_raw);
+            QBuffer buffer(&previewData);
+            QImageReader reader(&buffer);
+
+            const QSize previewSize = reader.size();
+
+            if (previewSize.isValid())
+            {
+                const bool bigEnough = std::min(previewSize.width(), previewSize.height()) >= requiredEdge(minimal);
+
+                // some cameras use previews with black bars (different aspect ratio) - skip them
+                const double fullRatio = static_cast<double>(fullSize.width()) / fullSize.height();
+                const double previewRatio = static_cast<double>(previewSize.width()) / previewSize.height();
+                const bool sameRatio = std::abs(fullRatio - previewRatio) < 0.01;
+
+                if (bigEnough && sameRatio)
+                    image = read(reader, minimal);
+            }
+        }
+
+        return image;
+    }
+}
+
+
+OrientedImage::OrientedImage():
+    m_oriented()
+{
+}
+
+
+OrientedImage::OrientedImage(IExifReader& exif, const QString& src):
+    OrientedImage(exif, src, QSize())
+{
+}
+
+
+OrientedImage::OrientedImage(IExifReader& exif, const QString& src, const QSize& minimalSize):
+    m_oriented()
+{
+    QImageReader reader(src);
+    QImage img;
+
+    if (minimalSize.isValid())
+        img = readPreview(exif, src, reader.size(), minimalSize);
+
+    if (img.isNull())
+        img = read(reader, minimalSize);
+
+    if (img.isNull())
+        qDebug() << reader.errorString();
+    else
+        m_oriented = orient(img, readOrientation(exif, src));
 }
 
 
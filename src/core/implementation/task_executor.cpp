@@ -20,29 +20,174 @@
 #include "task_executor.hpp"
 #include <ilogger.hpp>
 
+#include <cassert>
 #include <chrono>
-#include <iostream>
 #include <thread>
 
 #include <QString>
 
+#include "containers_utils.hpp"
 #include "thread_utils.hpp"
 
 
-TaskExecutor::TaskExecutor(ILogger& logger, int threadsToUse):
-    m_tasks(),
-    m_taskEater(),
+namespace
+{
+    std::size_t queueIndex(ITaskExecutor::Priority priority)
+    {
+        return static_cast<std::size_t>(priority);
+    }
+
+    template<typename T>
+    int queuesSize(const T& queues)
+    {
+        int size = 0;
+
+        for(const auto& queue: queues)
+            size += static_cast<int>(queue.size());
+
+        return size;
+    }
+}
+
+
+struct TaskExecutor::Worker
+{
+    Worker(TaskExecutor* o, std::size_t i)
+        : owner(o)
+        , index(i)
+    {
+
+    }
+
+    PriorityQueues tasks;
+    std::mutex tasksMutex;
+    std::thread thread;
+    TaskExecutor* const owner;
+    const std::size_t index;
+};
+
+
+/**
+ * @brief Pool of threads for light tasks
+ *
+ * Threads are started on demand (up to given limit) and kept alive until pool is stopped.
+ * When limit is reached, tasks wait in queue for a free thread.
+ */
+class TaskExecutor::LightTasksPool
+{
+    public:
+        explicit LightTasksPool(unsigned int maxThreads)
+            : m_maxThreads(maxThreads)
+        {
+
+        }
+
+        ~LightTasksPool()
+        {
+            stop();
+        }
+
+        void add(std::unique_ptr<ITask>&& task)
+        {
+            std::lock_guard<std::mutex> lock(m_tasksMutex);
+            assert(m_working);
+
+            m_tasks.push_back(std::move(task));
+
+            // start a new thread when there are not enough idle ones
+            if (m_tasks.size() > m_idleThreads && m_threads.size() < m_maxThreads)
+                m_threads.emplace_back(&LightTasksPool::run, this);
+
+            m_newTask.notify_one();
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_tasksMutex);
+                m_working = false;
+            }
+
+            m_newTask.notify_all();
+
+            for(auto& thread: m_threads)
+                thread.join();
+
+            m_threads.clear();
+        }
+
+        QVariantMap counters() const
+        {
+            std::lock_guard<std::mutex> lock(m_tasksMutex);
+
+            return {
+                { "lightThreads", static_cast<int>(m_threads.size()) },
+                { "lightTasksQueued", static_cast<int>(m_tasks.size()) },
+            };
+        }
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::deque<std::unique_ptr<ITask>> m_tasks;
+        mutable std::mutex m_tasksMutex;
+        std::condition_variable m_newTask;
+        const unsigned int m_maxThreads;
+        std::size_t m_idleThreads = 0;
+        bool m_working = true;
+
+        void run()
+        {
+            set_thread_name("TE::LightTask");
+
+            std::unique_lock<std::mutex> lock(m_tasksMutex);
+
+            while(true)
+            {
+                m_idleThreads++;
+                m_newTask.wait(lock, [this]
+                {
+                    return m_tasks.empty() == false || m_working == false;
+                });
+                m_idleThreads--;
+
+                // finish all queued tasks before quitting
+                if (m_tasks.empty())
+                    break;
+
+                auto task = take_front(m_tasks);
+
+                lock.unlock();
+
+                if (task->isCancelled() == false)
+                    task->perform();
+
+                task.reset();
+                lock.lock();
+            }
+        }
+};
+
+
+TaskExecutor::TaskExecutor(ILogger& logger, int threadsToUse, int lightThreadsLimit):
+    m_workers(),
+    m_injectionQueue(),
+    m_queuedTasks(0),
+    m_parkedWorkers(0),
+    m_steals(0),
+    m_cancelled(0),
+    m_lightTasks(std::make_unique<LightTasksPool>(static_cast<unsigned int>(std::max(lightThreadsLimit, 1)))),
     m_logger(logger),
-    m_threads(threadsToUse),
-    m_lightTasks(0),
+    m_threads(static_cast<unsigned int>(std::max(threadsToUse, 1))),
     m_working(true)
 {
     m_logger.info(QString("Using %1 threads.").arg(m_threads));
 
-    m_taskEater = std::thread( [&]
-    {
-        this->eat();
-    });
+    for(std::size_t i = 0; i < m_threads; i++)
+        m_workers.push_back(std::make_unique<Worker>(this, i));
+
+    // start threads when all workers are constructed as they will look into each other's queues
+    for(auto& worker: m_workers)
+        worker->thread = std::thread(&TaskExecutor::work, this, std::ref(*worker));
 }
 
 
@@ -55,34 +200,34 @@ TaskExecutor::~TaskExecutor()
 void TaskExecutor::add(std::unique_ptr<ITask>&& task)
 {
     assert(m_working);
-    m_tasks.push(std::move(task));
-}
-
 
-void TaskExecutor::addLight(std::unique_ptr<ITask>&& task)
-{
-    assert(m_working);
+    // increase counter before task is queued so parked workers won't miss it
+    m_queuedTasks++;
 
-    // start a task and increase count of them
-    std::lock_guard<std::mutex> guard(m_lightTasksMutex);
-    ++m_lightTasks;
+    const std::size_t priority = queueIndex(task->priority());
+    Worker* worker = currentWorker();
 
-    auto light_task = std::thread( [this, lt = std::move(task)]
+    if (worker != nullptr && worker->owner == this)
+    {
+        // task created by one of workers - keep it local
+        std::lock_guard<std::mutex> lock(worker->tasksMutex);
+        worker->tasks[priority].push_back(std::move(task));
+    }
+    else
     {
-        set_thread_name("TE::LightTask");
+        std::lock_guard<std::mutex> lock(m_injectionQueueMutex);
+        m_injectionQueue[priority].push_back(std::move(task));
+    }
 
-        // do job
-        lt->perform();
+    wakeUpWorker();
+}
 
-        // notify about finished task
-        std::unique_lock<std::mutex> lock(m_lightTasksMutex);
-        assert(m_lightTasks > 0);
-        --m_lightTasks;
 
-        std::notify_all_at_thread_exit(m_lightTaskFinished, std::move(lock));
-    });
+void TaskExecutor::addLight(std::unique_ptr<ITask>&& task)
+{
+    assert(m_working);
 
-    light_task.detach();
+    m_lightTasks->add(std::move(task));
 }
 
 
@@ -92,116 +237,212 @@ int TaskExecutor::heavyWorkers() const
 }
 
 
+QVariantMap TaskExecutor::counters() const
+{
+    int workersQueues = 0;
+
+    for(const auto& worker: m_workers)
+    {
+        std::lock_guard<std::mutex> lock(worker->tasksMutex);
+        workersQueues += queuesSize(worker->tasks);
+    }
+
+    int injectionQueue = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_injectionQueueMutex);
+        injectionQueue = queuesSize(m_injectionQueue);
+    }
+
+    QVariantMap result = m_lightTasks->counters();
+    result.insert("steals", m_steals.load());
+    result.insert("cancelledTasks", m_cancelled.load());
+    result.insert("queuedTasks", m_queuedTasks.load());
+    result.insert("injectionQueue", injectionQueue);
+    result.insert("workersQueues", workersQueues);
+    result.insert("parkedWorkers", m_parkedWorkers.load());
+
+    return result;
+}
+
+
 void TaskExecutor::stop()
 {
     if (m_working)
     {
         m_working = false;
 
-        // wait for heavy tasks
-        m_tasks.stop();
-        assert(m_taskEater.joinable());
-        m_taskEater.join();
+        // wake up all parked workers so they can finish remaining tasks and quit
+        {
+            std::lock_guard<std::mutex> lock(m_parkingMutex);
+        }
+        m_parkingLot.notify_all();
+
+        for(auto& worker: m_workers)
+        {
+            assert(worker->thread.joinable());
+            worker->thread.join();
+        }
 
         // wait for light tasks
-        std::unique_lock<std::mutex> lock(m_lightTasksMutex);
+        m_lightTasks->stop();
 
-        m_lightTaskFinished.wait(lock, [this]
-        {
-            return m_lightTasks == 0;
-        });
+        m_logger.info("TaskExecutor: shutting down.");
     }
 }
 
 
-void TaskExecutor::eat()
+void TaskExecutor::work(Worker& worker)
 {
-    set_thread_name("TE::eater");
+    set_thread_name("TE::HeavyTask");
+    currentWorker() = &worker;
 
-    using namespace std::chrono_literals;
+    const QString loggerName = QString("Thread #%1").arg(worker.index + 1);
+    auto threadLogger = m_logger.subLogger(loggerName);
 
-    std::atomic<unsigned int> running_tasks(0);
-    std::condition_variable free_worker;
-    std::mutex free_worker_mutex;
-    int id = 0;
+    threadLogger->debug("Starting TaskExecutor thread");
 
-    while(m_working)
+    while(true)
     {
-        //wait for any data in queue
-        m_tasks.wait_for_data();
+        std::unique_ptr<ITask> task = takeTask(worker);
 
-        // if there are tasks and a free worker - give him a job
-        if (running_tasks < m_threads && m_tasks.empty() == false)
+        if (task)
         {
-            ++running_tasks;
+            execute(std::move(task), *threadLogger);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_parkingMutex);
+
+        if (m_working == false && m_queuedTasks == 0)
+            break;
 
-            std::thread thread([&, th_id = ++id]
+        m_parkedWorkers++;
+        m_parkingLot.wait(lock, [this]
+        {
+            return m_queuedTasks > 0 || m_working == false;
+        });
+        m_parkedWorkers--;
+    }
+
+    currentWorker() = nullptr;
+    threadLogger->debug("Quitting TaskExecutor thread");
+}
+
+
+std::unique_ptr<ITaskExecutor::ITask> TaskExecutor::takeTask(Worker& worker)
+{
+    std::unique_ptr<ITask> task;
+    std::size_t priority = 0;
+
+    while(task.get() == nullptr && priority < worker.tasks.size())
+    {
+        task = takeTask(worker, priority);
+
+        if (task.get() == nullptr)
+            priority++;
+        else
+        {
+            m_queuedTasks--;
+
+            // drop tasks nobody waits for and try again on the same level
+            if (task->isCancelled())
             {
+                m_cancelled++;
+                task.reset();
+            }
+        }
+    }
 
-                const QString loggerName = QString("Thread #%1").arg(th_id);
-                auto threadLogger = m_logger.subLogger(loggerName);
+    return task;
+}
 
-                set_thread_name("TE::HeavyTask");
 
-                threadLogger->debug("Starting TaskExecutor thread");
+std::unique_ptr<ITaskExecutor::ITask> TaskExecutor::takeTask(Worker& worker, std::size_t priority)
+{
+    std::unique_ptr<ITask> task;
 
-                while(true)
-                {
-                    std::optional<std::unique_ptr<ITask>> opt_task(m_tasks.pop_for(2000ms));
-                    assert(opt_task.has_value() == false || opt_task->get() != nullptr);
+    // own tasks first. Take most recent one as its data is most likely still in cache
+    {
+        std::lock_guard<std::mutex> lock(worker.tasksMutex);
 
-                    if (opt_task)
-                    {
-                        std::unique_ptr<ITask> task = std::move(*opt_task);
+        if (worker.tasks[priority].empty() == false)
+            task = take_back(worker.tasks[priority]);
+    }
 
-                        assert(task.get() != nullptr);
+    // then tasks from outside of executor
+    if (task.get() == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_injectionQueueMutex);
 
-                        const std::string taskName = task->name();
+        if (m_injectionQueue[priority].empty() == false)
+            task = take_front(m_injectionQueue[priority]);
+    }
 
-                        const auto start = std::chrono::steady_clock::now();
-                        execute(std::move(task));
-                        const auto end = std::chrono::steady_clock::now();
+    // then tasks of other workers
+    if (task.get() == nullptr)
+        task = steal(worker, priority);
 
-                        threadLogger->trace(
-                            QString("task '%1' took %2ms")
-                                .arg(taskName.c_str())
-                                .arg(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count())
-                        );
-                    }
-                    else
-                        break;
-                }
+    return task;
+}
 
-                --running_tasks;
-                threadLogger->debug("Quitting TaskExecutor thread");
 
-                // notify manager that thread is gone
-                free_worker.notify_one();
-            });
+std::unique_ptr<ITaskExecutor::ITask> TaskExecutor::steal(const Worker& thief, std::size_t priority)
+{
+    std::unique_ptr<ITask> task;
 
-            thread.detach();
-        }
+    for(std::size_t i = 1; i < m_workers.size() && task.get() == nullptr; i++)
+    {
+        Worker& victim = *m_workers[(thief.index + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.tasksMutex);
 
-        //wait for all workers to be free
-        std::unique_lock<std::mutex> free_worker_lock(free_worker_mutex);
-        free_worker.wait(free_worker_lock, [&]
+        // steal oldest task
+        if (victim.tasks[priority].empty() == false)
         {
-            return running_tasks < m_threads;
-        });
+            task = take_front(victim.tasks[priority]);
+            m_steals++;
+        }
     }
 
-    //wait for all workers
-    std::unique_lock<std::mutex> workers_lock(free_worker_mutex);
-    free_worker.wait(workers_lock, [&]
-    {
-        return running_tasks == 0;
-    });
+    return task;
+}
 
-    m_logger.info("TaskExecutor: shutting down.");
+
+void TaskExecutor::wakeUpWorker()
+{
+    // Worker increases m_parkedWorkers before checking m_queuedTasks,
+    // and m_queuedTasks was increased before this check,
+    // so either worker will notice new task or we will notice parked worker.
+    if (m_parkedWorkers > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_parkingMutex);
+        }
+        m_parkingLot.notify_one();
+    }
 }
 
 
-void TaskExecutor::execute(const std::shared_ptr<ITask>& task) const
+void TaskExecutor::execute(std::unique_ptr<ITask>&& task, ILogger& logger) const
 {
+    const std::string taskName = task->name();
+
+    const auto start = std::chrono::steady_clock::now();
     task->perform();
+    task.reset();
+    const auto end = std::chrono::steady_clock::now();
+
+    logger.trace(
+        QString("task '%1' took %2ms")
+            .arg(taskName.c_str())
+            .arg(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count())
+    );
+}
+
+
+TaskExecutor::Worker*& TaskExecutor::currentWorker()
+{
+    thread_local Worker* worker = nullptr;
+
+    return worker;
 }
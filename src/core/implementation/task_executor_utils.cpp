@@ -10,9 +10,11 @@ namespace
     class InlineTask: public ITaskExecutor::ITask
     {
         public:
-            InlineTask(const std::string& name, std::function<void()>&& task)
+            InlineTask(const std::string& name, std::function<void()>&& task, ITaskExecutor::Priority priority, const CancellationToken& token)
                 : m_name(name)
                 , m_task(task)
+                , m_token(token)
+                , m_priority(priority)
             {
 
             }
@@ -27,9 +29,21 @@ namespace
                 m_task();
             }
 
+            ITaskExecutor::Priority priority() const override
+            {
+                return m_priority;
+            }
+
+            bool isCancelled() const override
+            {
+                return m_token.isCancelled();
+            }
+
         private:
             const std::string m_name;
             std::function<void()> m_task;
+            const CancellationToken m_token;
+            const ITaskExecutor::Priority m_priority;
     };
 }
 
@@ -63,7 +77,11 @@ struct TasksQueue::IntTask final: ITaskExecutor::ITask
 
     void perform() override
     {
-        m_task->perform();         // client's code
+        // Do not let executor drop this task when client's task gets cancelled,
+        // TasksQueue needs to be notified anyway.
+        if (m_task->isCancelled() == false)
+            m_task->perform();     // client's code
+
         notify();                  // internal jobs
     }
 
@@ -72,6 +90,11 @@ struct TasksQueue::IntTask final: ITaskExecutor::ITask
         return std::string("TasksQueue::IntTask: ") + m_task->name();
     }
 
+    ITaskExecutor::Priority priority() const override
+    {
+        return m_task->priority();
+    }
+
     std::unique_ptr<ITaskExecutor::ITask> m_task;
     TasksQueue* m_queue;
 };
@@ -102,8 +125,7 @@ void TasksQueue::push(std::unique_ptr<ITaskExecutor::ITask>&& callable)
 {
     std::lock_guard<std::recursive_mutex> guard(m_tasksMutex);
 
-    auto task = std::make_unique<IntTask>(std::move(callable), this);
-    m_waitingTasks.push_back(std::move(task));
+    m_waitingTasks.push_back(std::move(callable));
 
     try_to_fire();
 }
@@ -168,7 +190,13 @@ void TasksQueue::fire()
     std::lock_guard<std::recursive_mutex> guard(m_tasksMutex);
     assert(m_waitingTasks.empty() == false);
 
-    auto task = m_mode == Mode::Fifo? take_front(m_waitingTasks): take_back(m_waitingTasks);
+    auto callable = m_mode == Mode::Fifo? take_front(m_waitingTasks): take_back(m_waitingTasks);
+
+    // drop tasks nobody waits for
+    if (callable->isCancelled())
+        return;
+
+    auto task = std::make_unique<IntTask>(std::move(callable), this);
 
     m_executingTasks++;
     m_tasksExecutor->add(std::move(task));
@@ -194,5 +222,11 @@ void TasksQueue::task_finished()
 
 std::unique_ptr<ITaskExecutor::ITask> inlineTask(const std::string& name, std::function<void()>&& task)
 {
-    return std::make_unique<InlineTask>(name, std::move(task));
+    return inlineTask(name, std::move(task), ITaskExecutor::Priority::Normal);
+}
+
+
+std::unique_ptr<ITaskExecutor::ITask> inlineTask(const std::string& name, std::function<void()>&& task, ITaskExecutor::Priority priority, const CancellationToken& token)
+{
+    return std::make_unique<InlineTask>(name, std::move(task), priority, token);
 }
@@ -39,7 +39,7 @@
 
 ThumbnailGenerator::ThumbnailGenerator(ILogger* logger, IConfiguration* config):
     m_logger(logger),
-    m_configuration(config)
+    m_videoMediaInformation(std::make_unique<VideoMediaInformation>(*config))
 {
 
 }
@@ -53,7 +53,7 @@ ThumbnailGenerator::~ThumbnailGenerator()
 
 QImage ThumbnailGenerator::generate(const QString& path, const ThumbnailParameters& params)
 {
-    const QImage frame = readFrame(path);
+    const QImage frame = readFrame(path, std::get<0>(params));
     QImage thumb;
 
     if (frame.isNull() == false)
@@ -69,7 +69,7 @@ QImage ThumbnailGenerator::generateFrom(const QImage& image, const ThumbnailPara
 }
 
 
-QImage ThumbnailGenerator::readFrameFromImage(const QString& path) const
+QImage ThumbnailGenerator::readFrameFromImage(const QString& path, const QSize& minimalSize) const
 {
     IExifReader& reader = m_exifReaderFactory.get();
 
@@ -79,7 +79,7 @@ QImage ThumbnailGenerator::readFrameFromImage(const QString& path) const
     QImage image;
 
     if(QFile::exists(path))
-        image = Image::normalized(path, reader).get();
+        image = Image::normalized(path, reader, minimalSize).get();
 
     if (image.isNull())
     {
@@ -106,8 +106,7 @@ QImage ThumbnailGenerator::readFrameFromVideo(const QString& path) const
     if (pathInfo.exists())
     {
         const QString absolute_path = pathInfo.absoluteFilePath();
-        const VideoMediaInformation videoMediaInfo(*m_configuration);
-        const auto fileInfo = videoMediaInfo.getInformation(absolute_path);
+        const auto fileInfo = m_videoMediaInformation->getInformation(absolute_path);
         const auto videoInfo = std::get<VideoFile>(fileInfo.details);
         const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(videoInfo.duration).count();
 
@@ -155,12 +154,12 @@ QImage ThumbnailGenerator::readFrameFromVideo(const QString& path) const
 }
 
 
-QImage ThumbnailGenerator::readFrame(const QString& path) const
+QImage ThumbnailGenerator::readFrame(const QString& path, const QSize& minimalSize) const
 {
     QImage image;
 
     if (MediaTypes::isImageFile(path))
-        image = readFrameFromImage(path);
+        image = readFrameFromImage(path, minimalSize);
     else if (MediaTypes::isVideoFile(path))
         image = readFrameFromVideo(path);
     else
@@ -21,41 +21,63 @@
 #include <cassert>
 
 #include <QVariant>
-#include <QMediaPlayer>
-#include <QEventLoop>
 
 #include "constants.hpp"
 #include "iconfiguration.hpp"
+#include "exiftool_pool.hpp"
 #include "exiftool_video_details_reader.hpp"
 #include "video_media_information.hpp"
 
 
+namespace
+{
+    const QStringList VideoTags =
+    {
+        "-ImageWidth",
+        "-ImageHeight",
+        "-Rotation",
+        "-Duration#",                       // numerical value - duration in seconds
+        "-DateTimeOriginal",
+        "-CreateDate",
+    };
+}
+
+
 VideoMediaInformation::VideoMediaInformation(IConfiguration& configuration)
+    : m_configuration(configuration)
 {
-    const QVariant exiftoolVar = configuration.getEntry(ExternalToolsConfigKeys::exiftoolPath);
 
-    m_exiftoolPath = exiftoolVar.toString();
 }
 
 
 FileInformation VideoMediaInformation::getInformation(const QString& path) const
 {
-    const auto output = ExiftoolUtils::exiftoolOutput(m_exiftoolPath, path);
-    const auto parsed = ExiftoolUtils::parseOutput(output);
-    const ExiftoolVideoDetailsReader videoDetailsReader(parsed);
+    const auto files = exiftool()->read({path}, VideoTags);
+    const auto fileIt = files.begin();                     // there is at most one file
+    const ExiftoolVideoDetailsReader videoDetailsReader(fileIt == files.end()? ExiftoolPool::Entries(): fileIt->second);
 
     FileInformation info;
     info.common.dimension = videoDetailsReader.resolutionOf();
     info.common.creationTime = videoDetailsReader.creationTime();
+    info.details = VideoFile{.duration = videoDetailsReader.durationOf().value_or(std::chrono::milliseconds(0)) };
+
+    return info;
+}
 
-    QMediaPlayer player;
-    player.setSource(QUrl::fromLocalFile(path));
 
-    QEventLoop eventLoop;
-    QObject::connect(&player, &QMediaPlayer::mediaStatusChanged, &eventLoop, &QEventLoop::exit);
-    eventLoop.exec();
+std::shared_ptr<ExiftoolPool> VideoMediaInformation::exiftool() const
+{
+    const QVariant exiftoolVar = m_configuration.getEntry(ExternalToolsConfigKeys::exiftoolPath);
+    const QString exiftoolPath = exiftoolVar.toString();
 
-    info.details = VideoFile{.duration = std::chrono::milliseconds(player.duration()) };
+    std::lock_guard<std::mutex> lock(m_exiftoolMutex);
 
-    return info;
+    // keep pool (and its processes) alive as long as configured path does not change
+    if (m_exiftool.get() == nullptr || m_exiftoolPath != exiftoolPath)
+    {
+        m_exiftool = ExiftoolPool::get(exiftoolPath);
+        m_exiftoolPath = exiftoolPath;
+    }
+
+    return m_exiftool;
 }
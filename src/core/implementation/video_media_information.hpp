@@ -20,12 +20,22 @@
 #ifndef VIDEOINFORMATION_HPP
 #define VIDEOINFORMATION_HPP
 
+#include <memory>
+#include <mutex>
+
 #include <QString>
 
 #include "imedia_information.hpp"
 
 struct IConfiguration;
+class ExiftoolPool;
 
+/**
+ * @brief Video files metadata reader
+ *
+ * Exiftool path is read from configuration on each use,
+ * so changes in configuration apply to living instances.
+ */
 class VideoMediaInformation
 {
     public:
@@ -41,7 +51,12 @@ class VideoMediaInformation
         FileInformation getInformation(const QString &) const;
 
     private:
-        QString m_exiftoolPath;
+        IConfiguration& m_configuration;
+        mutable std::mutex m_exiftoolMutex;
+        mutable QString m_exiftoolPath;
+        mutable std::shared_ptr<ExiftoolPool> m_exiftool;
+
+        std::shared_ptr<ExiftoolPool> exiftool() const;
 };
 
 #endif // VIDEOINFORMATION_HPP
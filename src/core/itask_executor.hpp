@@ -28,12 +28,23 @@
 
 struct CORE_EXPORT ITaskExecutor
 {
+    /// Task priority. Tasks with higher priority are executed first.
+    enum class Priority
+    {
+        Interactive,            ///< user is waiting for result (thumbnails on screen, open dialogs)
+        Normal,
+        Background,             ///< long lasting processing of whole collection
+    };
+
     struct CORE_EXPORT ITask
     {
         virtual ~ITask() = default;
 
         virtual std::string name() const = 0;               ///< @return task's name
         virtual void perform() = 0;                         ///< @brief perform job
+
+        virtual Priority priority() const { return Priority::Normal; }  ///< @return task's priority
+        virtual bool isCancelled() const { return false; }              ///< @return true if task's result is not needed anymore. Cancelled tasks are dropped without execution.
     };
 
     virtual ~ITaskExecutor() = default;
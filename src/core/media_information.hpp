@@ -42,6 +42,7 @@ class CORE_EXPORT MediaInformation : public IMediaInformation
         MediaInformation& operator=(MediaInformation &&) = delete;
 
         FileInformation getInformation(const QString &) const override;
+        FileInformation getInformation(const QString &, QImageReader &) const override;
 
     private:
         struct Impl;
@@ -3,6 +3,7 @@
 #define OBSERVABLE_EXECUTOR_HPP_INCLUDED
 
 #include <QTimer>
+#include <QVariantMap>
 
 #include <core_export.h>
 
@@ -19,22 +20,29 @@ class CORE_EXPORT ObservableExecutor: public QObject
         Q_PROPERTY(int tasksExecuted READ tasksExecuted NOTIFY tasksExecutedChanged)
         Q_PROPERTY(double executionSpeed READ executionSpeed NOTIFY executionSpeedChanged)
         Q_PROPERTY(QString name READ name NOTIFY nameChanged)
+        Q_PROPERTY(QVariantMap statistics READ statistics NOTIFY statisticsChanged)
 
         int awaitingTasks() const;
         int tasksExecuted() const;
         virtual QString name() const = 0;
         double executionSpeed() const;
+        const QVariantMap& statistics() const;
 
     signals:
         void awaitingTasksChanged(int) const;
         void tasksExecutedChanged(int) const;
         void nameChanged(QString) const;
         void executionSpeedChanged(double) const;
+        void statisticsChanged(const QVariantMap &) const;
 
     protected:
         void newTaskInQueue();
         void taskMovedToExecution();
         void taskExecuted();
+        void taskDropped();
+
+        /// executor specific statistics. Refreshed periodically.
+        virtual QVariantMap collectStatistics() const;
 
     private:
         QTimer m_executionSpeedTimer;
@@ -45,6 +53,7 @@ class CORE_EXPORT ObservableExecutor: public QObject
         std::array<int, 5> m_executionSpeedBuffer;
         std::size_t m_executionSpeedBufferPos = 0;
         double m_executionSpeed = 0.0;
+        QVariantMap m_statistics;
 
         void updateExecutionSpeed();
 };
@@ -25,6 +25,15 @@ class ObservableTaskExecutor: public ObservableExecutor, public T
             return typeid(T).name();
         }
 
+    protected:
+        QVariantMap collectStatistics() const override
+        {
+            if constexpr (requires(const T& executor) { executor.counters(); })
+                return T::counters();
+            else
+                return {};
+        }
+
     private:
         class Task final: public ITaskExecutor::ITask
         {
@@ -36,6 +45,13 @@ class ObservableTaskExecutor: public ObservableExecutor, public T
                     m_executor.newTaskInQueue();
                 }
 
+                ~Task()
+                {
+                    // task was dropped (cancelled or removed from queue)
+                    if (m_performed == false)
+                        m_executor.taskDropped();
+                }
+
                 std::string name() const override
                 {
                     return m_task->name();
@@ -43,14 +59,26 @@ class ObservableTaskExecutor: public ObservableExecutor, public T
 
                 void perform() override
                 {
+                    m_performed = true;
                     m_executor.taskMovedToExecution();
                     m_task->perform();
                     m_executor.taskExecuted();
                 }
 
+                ITaskExecutor::Priority priority() const override
+                {
+                    return m_task->priority();
+                }
+
+                bool isCancelled() const override
+                {
+                    return m_task->isCancelled();
+                }
+
             private:
                 std::unique_ptr<ITaskExecutor::ITask> m_task;
                 ObservableTaskExecutor& m_executor;
+                bool m_performed = false;
         };
 
         friend class Task;
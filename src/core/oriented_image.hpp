@@ -32,6 +32,16 @@ class CORE_EXPORT OrientedImage
         OrientedImage();
         OrientedImage(IExifReader &, const QString& path);
 
+        /**
+         * \brief read image scaled down during decoding
+         * \arg minimalSize size image needs to cover (regardless of rotation)
+         *
+         * Embedded exif preview is used when big enough.
+         * Otherwise image is decoded with reduced resolution (DCT scaling for jpegs).
+         * Orientation is applied on already scaled image.
+         */
+        OrientedImage(IExifReader &, const QString& path, const QSize& minimalSize);
+
         QImage get() const;
         const QImage* operator->() const;
 
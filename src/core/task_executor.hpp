@@ -20,18 +20,40 @@
 #ifndef TASKEXECUTOR_HPP
 #define TASKEXECUTOR_HPP
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <thread>
+#include <vector>
+
+#include <QVariantMap>
 
 #include "core_export.h"
 #include "itask_executor.hpp"
-#include "ts_queue.hpp"
 
 
 struct ILogger;
 
+/**
+ * @brief Work stealing tasks executor
+ *
+ * Executor keeps a constant set of heavy workers alive for its whole life.
+ * Each worker has its own queue of tasks. Tasks added from worker threads
+ * go to worker's queue, tasks added from other threads go to global injection queue.
+ * Workers with no tasks steal them from other workers.
+ * Idle workers are parked until new tasks appear.
+ *
+ * Tasks are taken by priority: all queues are searched for tasks
+ * with higher priority before any task with lower priority is taken.
+ * Cancelled tasks are dropped without execution.
+ *
+ * Light tasks are executed by a separate, bounded pool of threads.
+ */
 struct CORE_EXPORT TaskExecutor: public ITaskExecutor
 {
-    explicit TaskExecutor(ILogger &, int threadsToUse);
+    explicit TaskExecutor(ILogger &, int threadsToUse, int lightThreadsLimit = 32);
     TaskExecutor(const TaskExecutor &) = delete;
     virtual ~TaskExecutor();
 
@@ -42,21 +64,42 @@ struct CORE_EXPORT TaskExecutor: public ITaskExecutor
 
     int heavyWorkers() const override;
 
+    /**
+     * @brief get executor's counters
+     * @return map of counter name to value (steals, queues depths, parked workers etc)
+     */
+    QVariantMap counters() const;
+
     void stop();
 
 private:
-    typedef ol::TS_Queue<std::unique_ptr<ITask>> QueueT;
-    QueueT m_tasks;
-    std::thread m_taskEater;
-    std::mutex m_lightTasksMutex;
-    std::condition_variable m_lightTaskFinished;
+    struct Worker;
+    class LightTasksPool;
+
+    typedef std::array<std::deque<std::unique_ptr<ITask>>, 3> PriorityQueues;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    PriorityQueues m_injectionQueue;
+    mutable std::mutex m_injectionQueueMutex;
+    std::mutex m_parkingMutex;
+    std::condition_variable m_parkingLot;
+    std::atomic<int> m_queuedTasks;
+    std::atomic<int> m_parkedWorkers;
+    std::atomic<long long> m_steals;
+    std::atomic<long long> m_cancelled;
+    std::unique_ptr<LightTasksPool> m_lightTasks;
     ILogger& m_logger;
     unsigned int m_threads;
-    int m_lightTasks;
-    bool m_working;
+    std::atomic<bool> m_working;
+
+    void work(Worker &);
+    std::unique_ptr<ITask> takeTask(Worker &);
+    std::unique_ptr<ITask> takeTask(Worker &, std::size_t priority);
+    std::unique_ptr<ITask> steal(const Worker &, std::size_t priority);
+    void wakeUpWorker();
+    void execute(std::unique_ptr<ITask> &&, ILogger &) const;
 
-    void eat();
-    void execute(const std::shared_ptr<ITask>& task) const;
+    static Worker*& currentWorker();
 };
 
 
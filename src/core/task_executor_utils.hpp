@@ -10,6 +10,7 @@
 #include <QFuture>
 #include <QPromise>
 
+#include "cancellation_token.hpp"
 #include "itask_executor.hpp"
 
 #include "core_export.h"
@@ -77,16 +78,18 @@ void execute(E& executor, T&& task)
 }
 
 
-// Run callable as a task
+// Run callable as a task with given priority.
+// When callable is a safe_callback, task gets cancelled as soon as callable becomes invalid.
 template<typename Callable>
-void runOn(ITaskExecutor& executor, Callable&& callable, const std::string& taskName = std::source_location::current().function_name())
+void runOn(ITaskExecutor& executor, Callable&& callable, ITaskExecutor::Priority priority, const std::string& taskName = std::source_location::current().function_name())
     requires std::is_invocable_v<Callable>
 {
     struct GenericTask: ITaskExecutor::ITask
     {
-        GenericTask(const std::string& name, Callable&& callable)
+        GenericTask(const std::string& name, Callable&& callable, ITaskExecutor::Priority priority)
             : m_callable(std::forward<Callable>(callable))
             , m_name(name)
+            , m_priority(priority)
         {
 
         }
@@ -101,16 +104,39 @@ void runOn(ITaskExecutor& executor, Callable&& callable, const std::string& task
             m_callable();
         }
 
+        ITaskExecutor::Priority priority() const override
+        {
+            return m_priority;
+        }
+
+        bool isCancelled() const override
+        {
+            if constexpr (requires(const Callable& c) { c.is_valid(); })
+                return m_callable.is_valid() == false;
+            else
+                return false;
+        }
+
         private:
             typename std::remove_reference<Callable>::type m_callable;
             std::string m_name;
+            ITaskExecutor::Priority m_priority;
     };
 
-    auto task = std::make_unique<GenericTask>(taskName, std::forward<Callable>(callable));
+    auto task = std::make_unique<GenericTask>(taskName, std::forward<Callable>(callable), priority);
     executor.add(std::move(task));
 }
 
 
+// Run callable as a task
+template<typename Callable>
+void runOn(ITaskExecutor& executor, Callable&& callable, const std::string& taskName = std::source_location::current().function_name())
+    requires std::is_invocable_v<Callable>
+{
+    runOn(executor, std::forward<Callable>(callable), ITaskExecutor::Priority::Normal, taskName);
+}
+
+
 // Run callable as a task
 template<typename R, typename Callable>
 QFuture<R> runOn(ITaskExecutor& executor, Callable&& callable, const std::string& taskName = std::source_location::current().function_name())
@@ -222,5 +248,9 @@ class CORE_EXPORT TasksQueue: public ITaskExecutor
 
 
 CORE_EXPORT std::unique_ptr<ITaskExecutor::ITask> inlineTask(const std::string& name, std::function<void()>&& task);
+CORE_EXPORT std::unique_ptr<ITaskExecutor::ITask> inlineTask(const std::string& name,
+                                                             std::function<void()>&& task,
+                                                             ITaskExecutor::Priority,
+                                                             const CancellationToken& = CancellationToken());
 
 #endif
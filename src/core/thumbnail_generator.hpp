@@ -19,6 +19,8 @@
 #ifndef THUMBNAILGENERATOR_HPP
 #define THUMBNAILGENERATOR_HPP
 
+#include <memory>
+
 #include "core_export.h"
 #include "exif_reader_factory.hpp"
 #include "ithumbnails_generator.hpp"
@@ -27,6 +29,7 @@
 struct IConfiguration;
 struct IExifReaderFactory;
 struct ILogger;
+class VideoMediaInformation;
 
 
 class CORE_EXPORT ThumbnailGenerator: public IThumbnailsGenerator
@@ -45,11 +48,11 @@ class CORE_EXPORT ThumbnailGenerator: public IThumbnailsGenerator
     private:
         ILogger* m_logger;
         mutable ExifReaderFactory m_exifReaderFactory;
-        IConfiguration* m_configuration;
+        std::unique_ptr<VideoMediaInformation> m_videoMediaInformation;
 
-        QImage readFrameFromImage(const QString& path) const;
+        QImage readFrameFromImage(const QString& path, const QSize& minimalSize) const;
         QImage readFrameFromVideo(const QString& path) const;
-        QImage readFrame(const QString& path) const;
+        QImage readFrame(const QString& path, const QSize& minimalSize) const;
         QImage scaleImage(const QImage& path, const ThumbnailParameters& params) const;
 };
 
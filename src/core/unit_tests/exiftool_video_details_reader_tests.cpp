@@ -9,36 +9,45 @@
 
 using namespace testing;
 
-TEST(ExifToolUtils, parser)
+TEST(ExifToolUtils, jsonParser)
 {
-    const QStringList output =
+    const QByteArray output = R"([{
+        "SourceFile": "/tmp/video1.mp4",
+        "ImageWidth": 1920,
+        "Duration": 12.56
+    },
     {
-        "   qwe    :abc     ",
-        "xxc:abc            ",
-        "   sdf:        dddd",
-        ":d                 ",
-        "e:                 "
-    };
+        "SourceFile": "/tmp/video2.mp4",
+        "CreateDate": "2021:08:21 09:46:18"
+    }])";
 
-    const auto entries = ExiftoolUtils::parseOutput(output);
+    const auto files = ExiftoolUtils::parseJsonOutput(output);
 
-    EXPECT_THAT(entries, UnorderedElementsAre
+    EXPECT_THAT(files, UnorderedElementsAre
     (
-        std::pair<QString, QString>("qwe", "abc"),
-        std::pair<QString, QString>("xxc", "abc"),
-        std::pair<QString, QString>("sdf", "dddd"),
-        std::pair<QString, QString>("",    "d"),
-        std::pair<QString, QString>("e",   "")
+        Pair("/tmp/video1.mp4", UnorderedElementsAre(
+            std::pair<QString, QString>("SourceFile", "/tmp/video1.mp4"),
+            std::pair<QString, QString>("ImageWidth", "1920"),
+            std::pair<QString, QString>("Duration",   "12.56"))),
+        Pair("/tmp/video2.mp4", UnorderedElementsAre(
+            std::pair<QString, QString>("SourceFile", "/tmp/video2.mp4"),
+            std::pair<QString, QString>("CreateDate", "2021:08:21 09:46:18")))
     ));
 }
 
 
+TEST(ExifToolUtils, emptyJsonOutput)
+{
+    EXPECT_TRUE(ExiftoolUtils::parseJsonOutput("").empty());
+}
+
+
 TEST(ExiftoolVideoDetailsReaderTest, resolution)
 {
     std::map<QString, QString> entries =
     {
-        {"Image Width", "100"},
-        {"Image Height", "200"},
+        {"ImageWidth", "100"},
+        {"ImageHeight", "200"},
         {"Rotation", "90"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
@@ -56,10 +65,10 @@ TEST(ExiftoolVideoDetailsReaderTest, duration1)
         {"Duration", "12.56 s"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
-    const std::optional<int> dur = reader.durationOf();
+    const std::optional<std::chrono::milliseconds> dur = reader.durationOf();
 
     ASSERT_TRUE(dur);
-    EXPECT_EQ(*dur, 12);
+    EXPECT_EQ(*dur, std::chrono::milliseconds(12560));
 }
 
 
@@ -70,10 +79,24 @@ TEST(ExiftoolVideoDetailsReaderTest, duration2)
         {"Duration", "0:01:28"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
-    const std::optional<int> dur = reader.durationOf();
+    const std::optional<std::chrono::milliseconds> dur = reader.durationOf();
+
+    ASSERT_TRUE(dur);
+    EXPECT_EQ(*dur, std::chrono::seconds(88));
+}
+
+
+TEST(ExiftoolVideoDetailsReaderTest, numericalDuration)
+{
+    std::map<QString, QString> entries =
+    {
+        {"Duration", "88.0456"}
+    };
+    const ExiftoolVideoDetailsReader reader(entries);
+    const std::optional<std::chrono::milliseconds> dur = reader.durationOf();
 
     ASSERT_TRUE(dur);
-    EXPECT_EQ(*dur, 88);
+    EXPECT_EQ(*dur, std::chrono::milliseconds(88046));
 }
 
 
@@ -81,7 +104,7 @@ TEST(ExiftoolVideoDetailsReaderTest, creationTime1)
 {
     std::map<QString, QString> entries =
     {
-        {"Date/Time Original", "2021:10:06 13:07:17+02:00 DST"}
+        {"DateTimeOriginal", "2021:10:06 13:07:17+02:00 DST"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
     const std::optional<QDateTime> creation = reader.creationTime();
@@ -95,7 +118,7 @@ TEST(ExiftoolVideoDetailsReaderTest, creationTime2)
 {
     std::map<QString, QString> entries =
     {
-        {"Create Date", "2021:08:21 09:46:18"}
+        {"CreateDate", "2021:08:21 09:46:18"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
     const std::optional<QDateTime> creation = reader.creationTime();
@@ -112,7 +135,7 @@ TEST(ExiftoolVideoDetailsReaderTest, creationTime3)
 {
     std::map<QString, QString> entries =
     {
-        {"Date/Time Original", "2021:10:06 13:07:17"}
+        {"DateTimeOriginal", "2021:10:06 13:07:17"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
     const std::optional<QDateTime> creation = reader.creationTime();
@@ -126,8 +149,8 @@ TEST(ExiftoolVideoDetailsReaderTest, invalidCreationTime)
 {
     std::map<QString, QString> entries =
     {
-        {"Date/Time Original", "0000:00:00 00:00:00"},
-        {"Create Date",        "0000:00:00 00:00:00"}
+        {"DateTimeOriginal", "0000:00:00 00:00:00"},
+        {"CreateDate",        "0000:00:00 00:00:00"}
     };
     const ExiftoolVideoDetailsReader reader(entries);
     const std::optional<QDateTime> creation = reader.creationTime();
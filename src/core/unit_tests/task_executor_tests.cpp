@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <unit_tests_utils/empty_logger.hpp>
+
+#include "task_executor.hpp"
+#include "task_executor_utils.hpp"
+
+
+TEST(TaskExecutorTest, executesAllTasks)
+{
+    EmptyLogger logger;
+    std::atomic<int> executed = 0;
+
+    {
+        TaskExecutor executor(logger, 4);
+
+        for(int i = 0; i < 1000; i++)
+            executor.add(inlineTask("counter", [&executed]{ executed++; }));
+
+        executor.stop();
+    }
+
+    EXPECT_EQ(executed, 1000);
+}
+
+
+TEST(TaskExecutorTest, executesTasksAddedByTasks)
+{
+    EmptyLogger logger;
+    std::atomic<int> executed = 0;
+
+    {
+        TaskExecutor executor(logger, 4);
+
+        for(int i = 0; i < 100; i++)
+            executor.add(inlineTask("spawner", [&executor, &executed]
+            {
+                for(int j = 0; j < 10; j++)
+                    executor.add(inlineTask("counter", [&executed]{ executed++; }));
+            }));
+
+        // give spawners a chance to run before shutdown begins
+        while(executed < 1000)
+            std::this_thread::yield();
+
+        executor.stop();
+    }
+
+    EXPECT_EQ(executed, 1000);
+}
+
+
+TEST(TaskExecutorTest, executesLightTasks)
+{
+    EmptyLogger logger;
+    std::atomic<int> executed = 0;
+
+    {
+        TaskExecutor executor(logger, 2, 4);
+
+        for(int i = 0; i < 100; i++)
+            executor.addLight(inlineTask("counter", [&executed]{ executed++; }));
+
+        EXPECT_LE(executor.counters()["lightThreads"].toInt(), 4);
+
+        executor.stop();
+    }
+
+    EXPECT_EQ(executed, 100);
+}
+
+
+TEST(TaskExecutorTest, countersAreEmptyAfterStop)
+{
+    EmptyLogger logger;
+    TaskExecutor executor(logger, 3);
+
+    for(int i = 0; i < 100; i++)
+        executor.add(inlineTask("nop", []{}));
+
+    executor.stop();
+
+    const QVariantMap counters = executor.counters();
+    EXPECT_EQ(counters["queuedTasks"].toInt(), 0);
+    EXPECT_EQ(counters["injectionQueue"].toInt(), 0);
+    EXPECT_EQ(counters["workersQueues"].toInt(), 0);
+    EXPECT_EQ(counters["lightTasksQueued"].toInt(), 0);
+}
+
+
+TEST(TaskExecutorTest, dropsCancelledTasks)
+{
+    EmptyLogger logger;
+    std::atomic<int> executed = 0;
+    CancellationToken token;
+
+    {
+        TaskExecutor executor(logger, 1);
+
+        // block worker so tasks wait in queue
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        executor.add(inlineTask("blocker", [released]{ released.wait(); }));
+
+        for(int i = 0; i < 10; i++)
+            executor.add(inlineTask("cancellable", [&executed]{ executed++; }, ITaskExecutor::Priority::Normal, token));
+
+        executor.add(inlineTask("regular", [&executed]{ executed += 100; }));
+
+        token.cancel();
+        release.set_value();
+        executor.stop();
+
+        EXPECT_EQ(executor.counters()["cancelledTasks"].toInt(), 10);
+    }
+
+    EXPECT_EQ(executed, 100);
+}
+
+
+TEST(TaskExecutorTest, executesTasksWithHigherPriorityFirst)
+{
+    EmptyLogger logger;
+    std::vector<ITaskExecutor::Priority> order;
+    std::mutex orderMutex;
+
+    TaskExecutor executor(logger, 1);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    executor.add(inlineTask("blocker", [released]{ released.wait(); }));
+
+    for(const auto priority: {ITaskExecutor::Priority::Background, ITaskExecutor::Priority::Normal, ITaskExecutor::Priority::Interactive})
+        executor.add(inlineTask("task", [&order, &orderMutex, priority]
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(priority);
+        }, priority));
+
+    release.set_value();
+    executor.stop();
+
+    const std::vector expected = {ITaskExecutor::Priority::Interactive, ITaskExecutor::Priority::Normal, ITaskExecutor::Priority::Background};
+    EXPECT_EQ(order, expected);
+}
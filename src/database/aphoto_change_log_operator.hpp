@@ -2,6 +2,8 @@
 #ifndef APHOTOCHANGELOGOPERATOR_HPP
 #define APHOTOCHANGELOGOPERATOR_HPP
 
+#include <set>
+
 #include "iphoto_change_log_operator.hpp"
 #include "database_export.h"
 
@@ -14,6 +16,9 @@ namespace Database
             void groupCreated(const Group::Id &, const Group::Type &, const Photo::Id& representative) override;
             void groupDeleted(const Group::Id &, const Photo::Id& representative, const std::vector<Photo::Id>& members) override;
 
+            /// fields of photo compared by storeDifference(). Other fields of current photo's content are not needed there.
+            static const std::set<Photo::Field>& trackedFields();
+
         protected:
             enum Operation
             {
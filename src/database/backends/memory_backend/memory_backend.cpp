@@ -78,6 +78,24 @@ namespace
                     return !photo.phash.valid();
                 }), result.end());
             }
+            else if constexpr (std::is_same_v<T, Database::FilterPhotosInDirectories>)
+            {
+                result.erase(std::remove_if(result.begin(), result.end(), [&filter](const Photo::Data& photo) {
+                    const QString directory = photo.path.left(photo.path.lastIndexOf('/'));
+
+                    return std::none_of(filter.directories.begin(), filter.directories.end(), [&directory, &filter](const QString& dir) {
+                        const QString path = dir.endsWith('/')? dir.chopped(1): dir;
+
+                        return directory == path || (filter.recursive && directory.startsWith(path + '/'));
+                    });
+                }), result.end());
+            }
+            else if constexpr (std::is_same_v<T, Database::FilterPhotosWithPath>)
+            {
+                result.erase(std::remove_if(result.begin(), result.end(), [&filter](const Photo::Data& photo) {
+                    return photo.path != filter.path;
+                }), result.end());
+            }
             else if constexpr (std::is_same_v<T, Database::FilterPhotosWithGeneralFlag>)
             {
                 result.erase(std::remove_if(result.begin(), result.end(), [&filter, &db](const Photo::Data& photo) {
@@ -99,6 +117,33 @@ namespace
 
                 }), result.end());
             }
+            else if constexpr (std::is_same_v<T, Database::FilterPhotosWithTag>)
+            {
+                result.erase(std::remove_if(result.begin(), result.end(), [&filter](const Photo::Data& photo) {
+                    auto it = photo.tags.find(filter.tagType);
+                    const bool hasTag = it != photo.tags.end();
+
+                    if (filter.tagValue.type() == Tag::ValueType::Empty)
+                        return hasTag == false;
+
+                    if (hasTag == false && filter.includeEmpty == false)
+                        return true;
+
+                    // missing tag is treated as an empty value (same as sql backend does)
+                    const TagValue value = hasTag? it->second: TagValue();
+
+                    switch (filter.valueMode)
+                    {
+                        case Database::ComparisonOp::Equal:          return (value == filter.tagValue) == false;
+                        case Database::ComparisonOp::Less:           return (value < filter.tagValue) == false;
+                        case Database::ComparisonOp::LessOrEqual:    return filter.tagValue < value;
+                        case Database::ComparisonOp::Greater:        return (filter.tagValue < value) == false;
+                        case Database::ComparisonOp::GreaterOrEqual: return value < filter.tagValue;
+                    }
+
+                    return true;
+                }), result.end());
+            }
 
         }, dbFilter);
 
@@ -242,6 +287,22 @@ namespace Database
     }
 
 
+    std::map<QDate, int> MemoryBackend::getDatesHistogram()
+    {
+        std::map<QDate, int> histogram;
+
+        for(const auto& photo: m_db->m_photos)
+        {
+            auto it = photo.tags.find(Tag::Types::Date);
+            const QDate date = it != photo.tags.end()? it->second.getDate(): QDate();
+
+            histogram[date]++;
+        }
+
+        return histogram;
+    }
+
+
     Photo::Data MemoryBackend::getPhoto(const Photo::Id& id)
     {
         auto it = m_db->m_photos.find(id);
@@ -289,6 +350,28 @@ namespace Database
     }
 
 
+    std::vector<Photo::DataDelta> MemoryBackend::getPhotoDeltas(const std::vector<Photo::Id>& ids, const std::set<Photo::Field>& fields)
+    {
+        std::vector<Photo::DataDelta> deltas;
+        deltas.reserve(ids.size());
+
+        for (const Photo::Id& id: ids)
+            if (m_db->m_photos.contains(id))
+                deltas.push_back(getPhotoDelta(id, fields));
+
+        return deltas;
+    }
+
+
+    std::vector<Photo::DataDelta> MemoryBackend::getPhotoDeltas(const Filter& filter, const std::set<Photo::Field>& fields)
+    {
+        std::vector<Photo::Id> ids = getPhotos(filter);
+        std::sort(ids.begin(), ids.end());
+
+        return getPhotoDeltas(ids, fields);
+    }
+
+
     int MemoryBackend::getPhotosCount(const Filter &)
     {
         return 0;
@@ -319,6 +402,22 @@ namespace Database
     }
 
 
+    std::map<Photo::Id, int> MemoryBackend::getFlagValues(const QString& name)
+    {
+        std::map<Photo::Id, int> result;
+
+        for (const auto& [id, flags]: m_db->m_flags)
+        {
+            auto f_it = flags.find(name);
+
+            if (f_it != flags.end())
+                result.emplace(id, f_it->second);
+        }
+
+        return result;
+    }
+
+
     void MemoryBackend::setBits(const Photo::Id& id, const QString& name, int bits)
     {
         auto valueOpt = get(id, name);
@@ -351,6 +450,23 @@ namespace Database
     }
 
 
+    std::vector<std::pair<Photo::Id, QByteArray>> MemoryBackend::takeThumbnails(int count)
+    {
+        std::vector<std::pair<Photo::Id, QByteArray>> thumbnails;
+
+        while(m_db->m_thumbnails.empty() == false && static_cast<int>(thumbnails.size()) < count)
+        {
+            auto node = m_db->m_thumbnails.extract(m_db->m_thumbnails.begin());
+
+            // getThumbnail() may leave empty entries
+            if (node.mapped().isEmpty() == false)
+                thumbnails.emplace_back(node.key(), std::move(node.mapped()));
+        }
+
+        return thumbnails;
+    }
+
+
     std::vector<Photo::Id> MemoryBackend::markStagedAsReviewed()
     {
         std::vector<Photo::Id> ids;
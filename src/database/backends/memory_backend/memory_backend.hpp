@@ -33,15 +33,20 @@ namespace Database
             bool addPhotos(std::vector<Photo::DataDelta>& photos) override;
             bool update(const std::vector<Photo::DataDelta> &) override;
             std::vector<TagValue> listTagValues(const Tag::Types &, const Filter &) override;
+            std::map<QDate, int> getDatesHistogram() override;
             Photo::Data getPhoto(const Photo::Id &) override;
             Photo::DataDelta getPhotoDelta(const Photo::Id &, const std::set<Photo::Field> &) override;
+            std::vector<Photo::DataDelta> getPhotoDeltas(const std::vector<Photo::Id> &, const std::set<Photo::Field> &) override;
+            std::vector<Photo::DataDelta> getPhotoDeltas(const Filter &, const std::set<Photo::Field> &) override;
             int getPhotosCount(const Filter &) override;
             void set(const Photo::Id& id, const QString& name, int value) override;
             std::optional<int> get(const Photo::Id& id, const QString& name) override;
+            std::map<Photo::Id, int> getFlagValues(const QString& name) override;
             void setBits(const Photo::Id& id, const QString& name, int bits) override final;
             void clearBits(const Photo::Id& id, const QString& name, int bits) override final;
             void setThumbnail(const Photo::Id &, const QByteArray &) override;
             QByteArray getThumbnail(const Photo::Id &) override;
+            std::vector<std::pair<Photo::Id, QByteArray>> takeThumbnails(int) override;
             std::vector<Photo::Id> markStagedAsReviewed() override;
             BackendStatus init(const ProjectInfo &) override;
             void closeConnections() override;
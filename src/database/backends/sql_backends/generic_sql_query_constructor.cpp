@@ -147,19 +147,37 @@ namespace Database
     }
 
 
+    QStringList GenericSqlQueryConstructor::prepareFullTextIndexCreation(const QString &, const QString &) const
+    {
+        return {};
+    }
+
+
+    QStringList GenericSqlQueryConstructor::prepareFullTextIndexRemoval(const QString &, const QString &) const
+    {
+        return {};
+    }
+
+
+    QString GenericSqlQueryConstructor::prepareFindFullTextIndexQuery(const QString &, const QString &) const
+    {
+        return {};
+    }
+
+
+    QString GenericSqlQueryConstructor::prepareFullTextSearchQuery(const QString &, const QString &, const QString &) const
+    {
+        return {};
+    }
+
+
     QSqlQuery GenericSqlQueryConstructor::insert(const QSqlDatabase& db, const InsertQueryData& data) const
     {
         const QString insertQuery = prepareInsertQuery(data);
-        const std::vector<QString>& columns = data.getColumns();
-        const std::vector<QVariant>& values = data.getValues();
-        const std::size_t count = std::min(columns.size(), values.size());
 
         QSqlQuery query(db);
         query.prepare(insertQuery);
-
-        for(std::size_t i = 0; i < count; i++)
-            if (values[i].userType() != qMetaTypeId<InsertQueryData::Value>())
-                query.bindValue(":" + columns[i], values[i]);
+        bindValues(query, data);
 
         return query;
     }
@@ -168,22 +186,34 @@ namespace Database
     QSqlQuery GenericSqlQueryConstructor::update(const QSqlDatabase& db, const UpdateQueryData& data) const
     {
         const QString updateQuery = prepareUpdateQuery(data);
-        const std::vector<QString>& columns = data.getColumns();
-        const std::vector<QVariant>& values = data.getValues();
-        const std::size_t count = std::min(columns.size(), values.size());
 
         QSqlQuery query(db);
         query.prepare(updateQuery);
+        bindValues(query, data);
+
+        return query;
+    }
+
+
+    void GenericSqlQueryConstructor::bindValues(QSqlQuery& query, const InsertQueryData& data) const
+    {
+        const std::vector<QString>& columns = data.getColumns();
+        const std::vector<QVariant>& values = data.getValues();
+        const std::size_t count = std::min(columns.size(), values.size());
 
         for(std::size_t i = 0; i < count; i++)
             if (values[i].userType() != qMetaTypeId<InsertQueryData::Value>())
                 query.bindValue(":" + columns[i], values[i]);
+    }
+
+
+    void GenericSqlQueryConstructor::bindValues(QSqlQuery& query, const UpdateQueryData& data) const
+    {
+        bindValues(query, static_cast<const InsertQueryData &>(data));
 
         const auto& keys = data.getCondition();
         for(const auto& key: keys)
             query.bindValue(":" + key.first, key.second);
-
-        return query;
     }
 
 
@@ -36,12 +36,19 @@ namespace Database
 
             GenericSqlQueryConstructor& operator=(const GenericSqlQueryConstructor &) = delete;
 
-            QString prepareInsertQuery(const InsertQueryData &) const;
-            QString prepareUpdateQuery(const UpdateQueryData &) const;
+            QString prepareInsertQuery(const InsertQueryData &) const override;
+            QString prepareUpdateQuery(const UpdateQueryData &) const override;
+
+            void bindValues(QSqlQuery &, const InsertQueryData &) const override;
+            void bindValues(QSqlQuery &, const UpdateQueryData &) const override;
 
         protected:
             virtual QString prepareCreationQuery(const QString& name, const QString& columns) const override;
             virtual QString prepareFindTableQuery(const QString& name) const override;
+            virtual QStringList prepareFullTextIndexCreation(const QString& table, const QString& column) const override;
+            virtual QStringList prepareFullTextIndexRemoval(const QString& table, const QString& column) const override;
+            virtual QString prepareFindFullTextIndexQuery(const QString& table, const QString& column) const override;
+            virtual QString prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const override;
 
             virtual QSqlQuery insert(const QSqlDatabase &, const InsertQueryData &) const override;
             virtual QSqlQuery update(const QSqlDatabase &, const UpdateQueryData &) const override;
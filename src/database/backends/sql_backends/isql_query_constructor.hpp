@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <QString>
+#include <QStringList>
 #include <QSqlQuery>
 
 #include "sql_backend_base_export.h"
@@ -38,8 +39,30 @@ namespace Database
         // get type for column's purpose
         virtual QString getTypeFor(ColDefinition::Purpose) const = 0;
 
+        // prepare queries creating (and populating) full text search index for table's column.
+        // Empty list when full text search is not supported by backend.
+        virtual QStringList prepareFullTextIndexCreation(const QString& table, const QString& column) const = 0;
+
+        // prepare queries removing (possibly partially created) full text search index for table's column
+        virtual QStringList prepareFullTextIndexRemoval(const QString& table, const QString& column) const = 0;
+
+        // prepare query for finding full text search index for table's column
+        virtual QString prepareFindFullTextIndexQuery(const QString& table, const QString& column) const = 0;
+
+        // prepare query selecting ids of table's rows with column containing words starting with words of phrase.
+        // Empty string when full text search is not supported by backend or phrase cannot be used for it.
+        virtual QString prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const = 0;
+
         virtual QSqlQuery insert(const QSqlDatabase &, const InsertQueryData &) const = 0;             // construct an insert sql query.
         virtual QSqlQuery update(const QSqlDatabase &, const UpdateQueryData &) const = 0;             // construct an update sql query.
+
+        // statement templates used by insert() and update(). They depend on columns only, not on values,
+        // so can be prepared once and reused with values bound by bindValues()
+        virtual QString prepareInsertQuery(const InsertQueryData &) const = 0;
+        virtual QString prepareUpdateQuery(const UpdateQueryData &) const = 0;
+
+        virtual void bindValues(QSqlQuery &, const InsertQueryData &) const = 0;
+        virtual void bindValues(QSqlQuery &, const UpdateQueryData &) const = 0;
     };
 }
 
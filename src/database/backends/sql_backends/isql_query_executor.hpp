@@ -8,6 +8,7 @@
 
 
 class QString;
+class QSqlDatabase;
 class QSqlQuery;
 
 
@@ -22,6 +23,18 @@ namespace Database
         virtual BackendStatus exec(const QString& query, QSqlQuery* result) const = 0;
         virtual BackendStatus exec(const std::vector<QString>& query, QSqlQuery* result) const = 0;
         virtual BackendStatus exec(QSqlQuery& query) const = 0;
+        virtual BackendStatus execBatch(QSqlQuery& query) const = 0;                         // execute query with lists of values bound
+
+        /**
+         * \brief get prepared statement from cache
+         * \param db connection statement is to be prepared for
+         * \param statement statement template. Values are expected to be bound, not embedded.
+         * \return prepared query ready for values binding and execution with exec(QSqlQuery &)
+         *
+         * Statement is prepared on first use for given connection and reused later on.
+         * Results of previous execution of returned query are released.
+         */
+        virtual QSqlQuery& cachedQuery(const QSqlDatabase& db, const QString& statement) const = 0;
     };
 
 }
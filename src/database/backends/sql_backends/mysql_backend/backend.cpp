@@ -1,11 +1,14 @@
 
 #include "backend.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <QProcess>
 #include <QSqlDatabase>
+#include <QSqlQuery>
 #include <QDir>
+#include <QRegularExpression>
 
 #include <core/iconfiguration.hpp>
 #include <database/database_builder.hpp>
@@ -21,7 +24,7 @@ namespace Database
 
     struct MySqlBackend::Data
     {
-        Data(IConfiguration* c, ILogger* l): m_server(), m_dbLocation(), m_initialized(false)
+        Data(IConfiguration* c, ILogger* l): m_server(), m_dbLocation(), m_initialized(false), m_fullTextSearch(true), m_minTokenSize(3)
         {
             m_server.set(c);
             m_server.set(l);
@@ -35,6 +38,8 @@ namespace Database
         MySqlServer m_server;
         QString m_dbLocation;
         bool m_initialized;
+        bool m_fullTextSearch;
+        int m_minTokenSize;             // words shorter than that are not indexed by InnoDB
     };
 
 
@@ -79,6 +84,24 @@ namespace Database
     }
 
 
+    bool MySqlBackend::dbOpened()
+    {
+        QSqlDatabase db = QSqlDatabase::database(getConnectionName());
+        QSqlQuery query(db);
+
+        if (query.exec("SELECT @@innodb_ft_min_token_size;") && query.next())
+            m_data->m_minTokenSize = query.value(0).toInt();
+
+        return Database::ASqlBackend::dbOpened();
+    }
+
+
+    void MySqlBackend::disableFullTextSearch()
+    {
+        m_data->m_fullTextSearch = false;
+    }
+
+
     QString MySqlBackend::prepareCreationQuery(const QString& name, const QString& columns) const
     {
         //Here we force InnoDB engine which may be default
@@ -114,6 +137,53 @@ namespace Database
     }
 
 
+    QStringList MySqlBackend::prepareFullTextIndexCreation(const QString& table, const QString& column) const
+    {
+        // InnoDB maintains FULLTEXT indexes on its own
+        return { QString("CREATE FULLTEXT INDEX %1_%2_fts ON %1(%2);").arg(table, column) };
+    }
+
+
+    QStringList MySqlBackend::prepareFullTextIndexRemoval(const QString &, const QString &) const
+    {
+        // index is created with single statement, so it cannot be left partially created
+        return {};
+    }
+
+
+    QString MySqlBackend::prepareFindFullTextIndexQuery(const QString& table, const QString& column) const
+    {
+        return QString("SHOW INDEX FROM %1 WHERE Key_name = '%1_%2_fts';").arg(table, column);
+    }
+
+
+    QString MySqlBackend::prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const
+    {
+        // each word of phrase becomes required prefix so no other boolean mode operators are interpreted
+        static const QRegularExpression nonWord("[^\\w]+", QRegularExpression::UseUnicodePropertiesOption);    // \w should match letters of any language
+        const QStringList words = phrase.split(nonWord, Qt::SkipEmptyParts);
+
+        if (words.isEmpty())
+            return {};
+
+        // no index or words which would not be found in it, regular search will be used
+        const bool tooShort = std::ranges::any_of(words, [minSize = m_data->m_minTokenSize](const QString& word)
+        {
+            return word.size() < minSize;
+        });
+
+        if (m_data->m_fullTextSearch == false || tooShort)
+            return {};
+
+        QStringList prefixes;
+        for (const QString& word: words)
+            prefixes.append(QString("+%1*").arg(word));
+
+        return QString("SELECT id FROM %1 WHERE MATCH(%2) AGAINST('%3' IN BOOLEAN MODE)")
+                .arg(table, column, prefixes.join(" "));
+    }
+
+
     MySqlPlugin::MySqlPlugin(): IPlugin()
     {
 
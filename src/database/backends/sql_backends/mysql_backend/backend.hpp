@@ -23,11 +23,17 @@ namespace Database
         private:
             // ASqlBackend:
             virtual BackendStatus prepareDB(const ProjectInfo &) override;
+            virtual bool dbOpened() override;
+            virtual void disableFullTextSearch() override;
             virtual const IGenericSqlQueryGenerator* getGenericQueryGenerator() const override;
 
             // GenericSqlQueryConstructor:
             virtual QString prepareCreationQuery(const QString& name, const QString& columns) const override;
             virtual QString getTypeFor(ColDefinition::Purpose) const override;
+            virtual QStringList prepareFullTextIndexCreation(const QString& table, const QString& column) const override;
+            virtual QStringList prepareFullTextIndexRemoval(const QString& table, const QString& column) const override;
+            virtual QString prepareFindFullTextIndexQuery(const QString& table, const QString& column) const override;
+            virtual QString prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const override;
 
             struct Data;
             std::unique_ptr<Data> m_data;
@@ -44,6 +44,7 @@ namespace Database
             { TAB_PEOPLE,         "photo_id" },
             { TAB_TAGS,           "photo_id" },
             { TAB_THUMBS,         "photo_id" },
+            { TAB_TIMESTAMPS,     "photo_id" },
             { TAB_PHOTOS,         "id"       }
         };
 
@@ -86,7 +87,7 @@ namespace Database
 
     bool PhotoOperator::removePhotos(const Filter& filter)
     {
-        const QString filterQuery = SqlFilterQueryGenerator().generate(filter);
+        const QString filterQuery = SqlFilterQueryGenerator(m_queryGenerator).generate(filter);
 
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
         QSqlQuery query(db);
@@ -122,7 +123,7 @@ namespace Database
         SortingContext context;
         processAction(context, action);
 
-        const QString filtersQuery = SqlFilterQueryGenerator().generate(filters);
+        const QString filtersQuery = SqlFilterQueryGenerator(m_queryGenerator).generate(filters);
         const QString actionQuery =
             QString("SELECT photos.id FROM (%2) "
                     "%3 "
@@ -144,7 +145,7 @@ namespace Database
 
     std::vector<Photo::Id> PhotoOperator::getPhotos(const Filter& filter)
     {
-        const QString queryStr = SqlFilterQueryGenerator().generate(filter);
+        const QString queryStr = SqlFilterQueryGenerator(m_queryGenerator).generate(filter);
 
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
         QSqlQuery query(db);
@@ -164,31 +165,31 @@ namespace Database
         insertQueryData.setColumns("photo_id", "hash");
         insertQueryData.setValues(id.value(), phash.variant());
 
-        QSqlQuery query;
         if (hasPHash(id))
         {
             UpdateQueryData updateQueryData(insertQueryData);
             updateQueryData.addCondition("photo_id", QString::number(id.value()));
 
-            query = m_queryGenerator.update(db, updateQueryData);
+            QSqlQuery& query = m_executor->cachedQuery(db, m_queryGenerator.prepareUpdateQuery(updateQueryData));
+            m_queryGenerator.bindValues(query, updateQueryData);
+            m_executor->exec(query);
         }
         else
-            query = m_queryGenerator.insert(db, insertQueryData);
-
-        m_executor->exec(query);
+        {
+            QSqlQuery& query = m_executor->cachedQuery(db, m_queryGenerator.prepareInsertQuery(insertQueryData));
+            m_queryGenerator.bindValues(query, insertQueryData);
+            m_executor->exec(query);
+        }
     }
 
 
     std::optional<Photo::PHash> PhotoOperator::getPHash(const Photo::Id& id)
     {
-        const QString queryStr = QString("SELECT hash FROM %1 WHERE photo_id=%2")
-            .arg(TAB_PHASHES)
-            .arg(id.value());
-
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
+        QSqlQuery& query = m_executor->cachedQuery(db, "SELECT hash FROM " TAB_PHASHES " WHERE photo_id=:photo_id");
+        query.bindValue(":photo_id", id.value());
 
-        m_executor->exec(queryStr, &query);
+        m_executor->exec(query);
 
         std::optional<Photo::PHash> result;
         if (query.next())
@@ -198,23 +199,24 @@ namespace Database
             result = phash;
         }
 
+        query.finish();
+
         return result;
     }
 
 
     bool PhotoOperator::hasPHash(const Photo::Id& id)
     {
-        const QString queryStr = QString("SELECT COUNT(photo_id) FROM %1 WHERE photo_id=%2")
-            .arg(TAB_PHASHES)
-            .arg(id.value());
-
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
+        QSqlQuery& query = m_executor->cachedQuery(db, "SELECT COUNT(photo_id) FROM " TAB_PHASHES " WHERE photo_id=:photo_id");
+        query.bindValue(":photo_id", id.value());
 
-        m_executor->exec(queryStr, &query);
+        m_executor->exec(query);
 
         const int count = query.next()? query.value(0).toInt() : 0;
 
+        query.finish();
+
         return count > 0;
     }
 
@@ -298,10 +300,15 @@ void Database::PhotoOperator::processAction(ActionContext& context, const Databa
 
             case Actions::Sort::By::Timestamp:
             {
-                const Actions::SortByTag byDate(Tag::Types::Date, sort->order);
-                const Actions::SortByTag byTime(Tag::Types::Time, sort->order);
-                processAction(context, byDate);
-                processAction(context, byTime);
+                // use denormalized date and time (indexed) instead of joining tags table twice
+                context.joins.append(QString("LEFT JOIN %1 ON (%2.id = %1.photo_id)")
+                    .arg(TAB_TIMESTAMPS)
+                    .arg(TAB_PHOTOS));
+
+                context.sortOrder.append(QString("%2.value %1")
+                    .arg(sort->order == Qt::AscendingOrder? "ASC": "DESC")
+                    .arg(TAB_TIMESTAMPS));
+
                 break;
             }
 
@@ -22,6 +22,8 @@
 
 #include "sql_backend.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <optional>
@@ -42,6 +44,7 @@
 #include <core/task_executor.hpp>
 #include <core/ilogger.hpp>
 #include <core/ilogger_factory.hpp>
+#include <core/slicer.hpp>
 #include <database/filter.hpp>
 #include <database/general_flags.hpp>
 #include <database/project_info.hpp>
@@ -57,14 +60,33 @@
 // about insert + update/ignore: http://stackoverflow.com/questions/15277373/sqlite-upsert-update-or-insert
 
 
+namespace
+{
+    // value for TAB_TIMESTAMPS. Empty when photo has no date
+    std::optional<qint64> timestampOf(const Tag::TagsList& tags)
+    {
+        const auto dateIt = tags.find(Tag::Types::Date);
+
+        if (dateIt == tags.end())
+            return {};
+
+        const auto timeIt = tags.find(Tag::Types::Time);
+        const QTime time = timeIt != tags.end()? timeIt->second.getTime(): QTime();
+
+        return Database::timestampValue(dateIt->second.getDate(), time);
+    }
+}
+
+
 namespace Database
 {
 
-    ASqlBackend::ASqlBackend(ILogger* l):
+    ASqlBackend::ASqlBackend(ILogger* l, AccessMode accessMode):
         m_peopleInfoAccessor([this](){ return new PeopleInformationAccessor(this->m_connectionName, this->m_executor, this->getGenericQueryGenerator()); }),
         m_connectionName(""),
         m_logger(nullptr),
         m_executor(),
+        m_accessMode(accessMode),
         m_dbHasSizeFeature(false),
         m_dbOpen(false)
     {
@@ -75,6 +97,17 @@ namespace Database
         // Backend should not emit any notifications until all transactions are finished.
         // Only when top root transaction is accepted then notifications should be fired.
         // Otherwise no notifications shall be emitted.
+        // Dates histogram is updated first, so it is up to date when observers are notified.
+        connect(&m_notificationsAccumulator, &NotificationsAccumulator::photosAddedSignal,
+                this, &ASqlBackend::updateDatesHistogram, Qt::DirectConnection);
+        connect(&m_notificationsAccumulator, &NotificationsAccumulator::photosModifiedSignal,
+                this, [this](const std::set<Photo::Id>& ids)
+        {
+            updateDatesHistogram(std::vector<Photo::Id>(ids.begin(), ids.end()));
+        }, Qt::DirectConnection);
+        connect(&m_notificationsAccumulator, &NotificationsAccumulator::photosRemovedSignal,
+                this, &ASqlBackend::removeFromDatesHistogram, Qt::DirectConnection);
+
         connect(&m_notificationsAccumulator, &NotificationsAccumulator::photosAddedSignal,
                 this, &ASqlBackend::photosAdded, Qt::DirectConnection);
         connect(&m_notificationsAccumulator, &NotificationsAccumulator::photosModifiedSignal,
@@ -95,7 +128,12 @@ namespace Database
      */
     void ASqlBackend::closeConnections()
     {
-        prune();
+        if (isReadOnly() == false)
+            prune();
+
+        // cached statements need to be released before their connection is closed
+        m_executor.clearCache();
+        m_datesHistogram.reset();
 
         // use scope here so all Qt objects are destroyed before removeDatabase call
         {
@@ -185,6 +223,12 @@ namespace Database
     }
 
 
+    bool ASqlBackend::isReadOnly() const
+    {
+        return m_accessMode == AccessMode::ReadOnly;
+    }
+
+
     BackendStatus ASqlBackend::ensureTableExists(const TableDefinition& definition) const
     {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
@@ -233,6 +277,37 @@ namespace Database
     }
 
 
+    BackendStatus ASqlBackend::ensureFullTextIndexExists(const QString& table, const QString& column) const
+    {
+        const QStringList creationQueries = getGenericQueryGenerator().prepareFullTextIndexCreation(table, column);
+
+        if (creationQueries.isEmpty() || hasFullTextIndex(table, column))
+            return StatusCodes::Ok;
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+
+        BackendStatus status = StatusCodes::Ok;
+
+        for(auto it = creationQueries.cbegin(); status && it != creationQueries.cend(); ++it)
+            status = m_executor.exec(*it, &query);
+
+        // Do not leave partially created index behind.
+        // It would be considered as existing one on next start and would never be updated.
+        if (status == false)
+            for(const QString& removalQuery: getGenericQueryGenerator().prepareFullTextIndexRemoval(table, column))
+                m_executor.exec(removalQuery, &query);
+
+        return status;
+    }
+
+
+    void ASqlBackend::disableFullTextSearch()
+    {
+
+    }
+
+
     bool ASqlBackend::exec(const QString& query, QSqlQuery* status) const
     {
         return m_executor.exec(query, status);
@@ -248,7 +323,9 @@ namespace Database
     {
         //store thread id for further validation
         m_executor.set( std::this_thread::get_id() );
-        m_connectionName = prjInfo.databaseLocation;
+        // there may be many backends (connections) working on one database
+        static std::atomic<int> connectionsCount = 0;
+        m_connectionName = QString("%1#%2").arg(prjInfo.databaseLocation).arg(connectionsCount++);
 
         BackendStatus status = StatusCodes::Ok;
         QSqlDatabase db;
@@ -266,7 +343,11 @@ namespace Database
             DbErrorOnFalse(dbOpened(), StatusCodes::OpenFailed);
             DbErrorOnFalse(db.driver()->hasFeature(QSqlDriver::BLOB), StatusCodes::OpenFailed, "DB driver does not support BLOB");
             DbErrorOnFalse(db.driver()->hasFeature(QSqlDriver::LastInsertId), StatusCodes::OpenFailed, "DB driver does not support LastInsertId");
-            DbErrorOnFalse(checkStructure());
+
+            if (isReadOnly())
+                setupFullTextSearch();
+            else
+                DbErrorOnFalse(checkStructure());
         }
         catch(const db_error& err)
         {
@@ -311,11 +392,17 @@ namespace Database
         try
         {
             std::set<Photo::Id> touchedIds;
+            std::map<Photo::Id, Photo::Data> currentState = fetchTrackedState(dataVector);
 
             for (const Photo::DataDelta& data: dataVector)
             {
-                DbErrorOnFalse(storeData(data));
+                auto it = currentState.try_emplace(data.getId(), data.getId()).first;
+
+                DbErrorOnFalse(storeData(data, it->second));
                 touchedIds.insert(data.getId());
+
+                // keep state up to date in case the same photo is updated again
+                it->second.apply(data);
             }
 
             m_notificationsAccumulator.photosModified(touchedIds);
@@ -336,7 +423,7 @@ namespace Database
     {
         std::vector<TagValue> result;
 
-        const QString filterQuery = SqlFilterQueryGenerator().generate(filter);
+        const QString filterQuery = SqlFilterQueryGenerator(getGenericQueryGenerator()).generate(filter);
 
         // from filtered photos, get info about tags used there
         // NOTE: filterQuery must go as a last item as it may contain '%X' which would ruin queryStr
@@ -372,6 +459,28 @@ namespace Database
     }
 
 
+    std::map<QDate, int> ASqlBackend::getDatesHistogram()
+    {
+        // Read only backends never commit, so they get no notifications about changes
+        // made by other connections and would keep outdated histogram forever.
+        if (isReadOnly())
+        {
+            DatesHistogram histogram;
+            loadDates(histogram);
+
+            return histogram.counts();
+        }
+
+        if (m_datesHistogram.has_value() == false)
+        {
+            m_datesHistogram.emplace();
+            loadDates(*m_datesHistogram);
+        }
+
+        return m_datesHistogram->counts();
+    }
+
+
     Photo::Data ASqlBackend::getPhoto(const Photo::Id& id)
     {
         const Photo::DataDelta photoDelta = getPhotoDelta(id);
@@ -433,9 +542,54 @@ namespace Database
     }
 
 
+    std::vector<Photo::DataDelta> ASqlBackend::getPhotoDeltas(const std::vector<Photo::Id>& ids, const std::set<Photo::Field>& fields)
+    {
+        std::vector<Photo::DataDelta> result;
+        result.reserve(ids.size());
+
+        // split ids into chunks to keep queries at reasonable length
+        slice(ids.begin(), ids.end(), 1000, [this, &fields, &result](auto first, auto last)
+        {
+            QStringList idsList;
+            std::transform(first, last, std::back_inserter(idsList), [](const Photo::Id& id) { return QString::number(id.value()); });
+
+            const auto deltas = fetchPhotoDeltas(idsList.join(", "), fields);
+
+            // restore order of ids
+            for (auto it = first; it != last; ++it)
+            {
+                const auto d_it = deltas.find(*it);
+
+                // photo does not exist (anymore)
+                if (d_it == deltas.end())
+                    continue;
+
+                result.push_back(d_it->second);
+            }
+        });
+
+        return result;
+    }
+
+
+    std::vector<Photo::DataDelta> ASqlBackend::getPhotoDeltas(const Filter& filter, const std::set<Photo::Field>& fields)
+    {
+        const QString filterQuery = SqlFilterQueryGenerator(getGenericQueryGenerator()).generate(filter);
+        const auto deltas = fetchPhotoDeltas(filterQuery, fields);
+
+        std::vector<Photo::DataDelta> result;
+        result.reserve(deltas.size());
+
+        for (const auto& [id, delta]: deltas)
+            result.push_back(delta);
+
+        return result;
+    }
+
+
     int ASqlBackend::getPhotosCount(const Filter& filter)
     {
-        const QString queryStr = SqlFilterQueryGenerator().generate(filter);
+        const QString queryStr = SqlFilterQueryGenerator(getGenericQueryGenerator()).generate(filter);
 
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
         QSqlQuery query(db);
@@ -471,19 +625,39 @@ namespace Database
     {
         std::optional<int> result;
 
-        const QString findQuery = QString("SELECT value FROM %1 WHERE photo_id = %2 AND name = '%3'")
-                                    .arg(TAB_GENERAL_FLAGS)
-                                    .arg(id.value())
-                                    .arg(name);
-
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT value FROM " TAB_GENERAL_FLAGS " WHERE photo_id = :photo_id AND name = :name");
+        query.bindValue(":photo_id", id.value());
+        query.bindValue(":name", name);
 
-        const bool status = m_executor.exec(findQuery, &query);
+        const bool status = m_executor.exec(query);
 
         if (status && query.next())
             result = query.value(0).toInt();
 
+        query.finish();
+
+        return result;
+    }
+
+
+    std::map<Photo::Id, int> ASqlBackend::getFlagValues(const QString& name)
+    {
+        std::map<Photo::Id, int> result;
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+        query.prepare("SELECT photo_id, value FROM " TAB_GENERAL_FLAGS " WHERE name = :name");
+        query.bindValue(":name", name);
+
+        const bool status = m_executor.exec(query);
+
+        while (status && query.next())
+        {
+            const Photo::Id id(query.value(0));
+            result.emplace(id, query.value(1).toInt());
+        }
+
         return result;
     }
 
@@ -538,6 +712,49 @@ namespace Database
     }
 
 
+    std::vector<std::pair<Photo::Id, QByteArray>> ASqlBackend::takeThumbnails(int count)
+    {
+        const QString thbQuery = QString("SELECT photo_id, data FROM %1 LIMIT %2")
+            .arg(TAB_THUMBS)
+            .arg(count);
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+
+        auto tr = openTransaction();
+
+        bool status = m_executor.exec(thbQuery, &query);
+
+        std::vector<std::pair<Photo::Id, QByteArray>> thumbnails;
+        QStringList ids;
+
+        while(status && query.next())
+        {
+            const Photo::Id id(query.value(0));
+
+            thumbnails.emplace_back(id, query.value(1).toByteArray());
+            ids.append(QString::number(id.value()));
+        }
+
+        if (status && thumbnails.empty() == false)
+        {
+            const QString deleteQuery = QString("DELETE FROM %1 WHERE photo_id IN (%2)")
+                .arg(TAB_THUMBS)
+                .arg(ids.join(", "));
+
+            status = m_executor.exec(deleteQuery, &query);
+        }
+
+        if (status == false)
+        {
+            tr->abort();
+            thumbnails.clear();
+        }
+
+        return thumbnails;
+    }
+
+
     std::vector<Photo::Id> ASqlBackend::markStagedAsReviewed()
     {
         FilterPhotosWithFlags filter;
@@ -577,6 +794,8 @@ namespace Database
             for (const auto& table: tables)
                 DbErrorOnFalse(ensureTableExists(table.second));
 
+            setupFullTextSearch();
+
             const bool hasVersionTable = hasCurrentVersionTable();
 
             //insert first entry
@@ -730,9 +949,46 @@ namespace Database
                     status = m_executor.exec(drop_table, &query);
                     if (status == false)
                         break;
-                }
+                } [[fallthrough]];
+
+                case 6:             // fill TAB_TIMESTAMPS (table was created by ensureTableExists()) with photos' date and time
+                {
+                    const QString date_time_tags = QString("SELECT photo_id, name, value FROM %1 WHERE name IN (%2, %3)")
+                                                    .arg(TAB_TAGS)
+                                                    .arg(static_cast<int>(Tag::Types::Date))
+                                                    .arg(static_cast<int>(Tag::Types::Time));
+
+                    status = m_executor.exec(date_time_tags, &query);
+                    if (status == false)
+                        break;
+
+                    std::map<Photo::Id, std::pair<QDate, QTime>> date_times;
+
+                    while (query.next())
+                    {
+                        const Photo::Id id(query.value(0));
+                        const Tag::Types name = static_cast<Tag::Types>(query.value(1).toInt());
+                        const QString value = query.value(2).toString();
+
+                        if (name == Tag::Types::Date)
+                            date_times[id].first = TagValue::fromRaw(value, Tag::ValueType::Date).getDate();
+                        else
+                            date_times[id].second = TagValue::fromRaw(value, Tag::ValueType::Time).getTime();
+                    }
+
+                    QVariantList photo_ids, timestamps;
 
-                case 6:             // current version, break updgrades chain
+                    for (const auto& [id, date_time]: date_times)
+                        if (date_time.first.isValid())
+                        {
+                            photo_ids.append(id.value());
+                            timestamps.append(timestampValue(date_time.first, date_time.second));
+                        }
+
+                    execBatch("INSERT INTO " TAB_TIMESTAMPS "(photo_id, value) VALUES(?, ?)", { photo_ids, timestamps });
+                } [[fallthrough]];
+
+                case 7:             // current version, break updgrades chain
                     break;
 
                 default:
@@ -816,7 +1072,7 @@ namespace Database
             case Tag::ValueType::Color:
             {
                 QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-                QSqlQuery query(db);
+                const IGenericSqlQueryGenerator& generator = getGenericQueryGenerator();
 
                 const QString value = tagValue.rawValue();
 
@@ -828,16 +1084,23 @@ namespace Database
                     queryData.setColumns("value", "photo_id", "name");
                     queryData.setValues(value, photo_id, name_id);
 
+                    QSqlQuery* query = nullptr;
+
                     if (tag_id == -1)
-                        query = getGenericQueryGenerator().insert(db, queryData);
+                    {
+                        query = &m_executor.cachedQuery(db, generator.prepareInsertQuery(queryData));
+                        generator.bindValues(*query, queryData);
+                    }
                     else
                     {
                         UpdateQueryData updateQueryData(queryData);
                         updateQueryData.addCondition("id", QString::number(tag_id));
-                        query = getGenericQueryGenerator().update(db, updateQueryData);
+
+                        query = &m_executor.cachedQuery(db, generator.prepareUpdateQuery(updateQueryData));
+                        generator.bindValues(*query, updateQueryData);
                     }
 
-                    const QVariantList bound = query.boundValues();
+                    const QVariantList bound = query->boundValues();
 
                     QStringList binded_values;
                     for(auto it = bound.begin(); it != bound.end(); ++it)
@@ -846,7 +1109,7 @@ namespace Database
                     const QString binded_values_msg = "Binded values: " + binded_values.join(", ");
                     m_logger->debug(binded_values_msg);
 
-                    status = m_executor.exec(query);
+                    status = m_executor.exec(*query);
                 }
 
                 break;
@@ -858,54 +1121,198 @@ namespace Database
 
 
     /**
-     * \brief create new entry for photo in database
+     * \brief create new entries for photos in database
      * \throws db_error when any error during communication with database occurs
+     *
+     * Ids are allocated up front (see allocateIds()), so photos and all their details
+     * can be stored with batched inserts, one per table.
+     * Photos are expected to be new ones - no existing data is updated.
      */
-    void ASqlBackend::introduce(Photo::DataDelta& data)
+    void ASqlBackend::introduce(std::span<Photo::DataDelta> photos)
     {
-        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        Photo::Id::type nextId = allocateIds(TAB_PHOTOS, static_cast<int>(photos.size()));
+
+        QVariantList photoIds, paths;
+        QVariantList tagValues, tagPhotoIds, tagNames;
+        QVariantList geometryPhotoIds, widths, heights;
+        QVariantList flagsPhotoIds, stagingAreas, exifLoaded, geometryLoaded;
+        QVariantList membersGroupIds, membersPhotoIds;
+        QVariantList phashesPhotoIds, phashes;
+        QVariantList timestampsPhotoIds, timestamps;
+
+        for (Photo::DataDelta& data: photos)
+        {
+            assert(data.getId().valid() == false);
+
+            const Photo::Id id(nextId++);
+            data.setId(id);
+
+            photoIds.append(id.value());
+            paths.append(data.get<Photo::Field::Path>());
+
+            if (data.has(Photo::Field::Tags))
+            {
+                const Tag::TagsList& tags = data.get<Photo::Field::Tags>();
+
+                for (const auto& [name, tagValue]: tags)
+                {
+                    const QString value = tagValue.rawValue();
+
+                    // storing routine doesn't store empty tags (see store())
+                    assert(value.isEmpty() == false);
+
+                    if (value.isEmpty() == false)
+                    {
+                        tagValues.append(value);
+                        tagPhotoIds.append(id.value());
+                        tagNames.append(static_cast<int>(name));
+                    }
+                }
+
+                if (const auto timestamp = timestampOf(tags))
+                {
+                    timestampsPhotoIds.append(id.value());
+                    timestamps.append(*timestamp);
+                }
+            }
+
+            if (data.has(Photo::Field::Geometry))
+            {
+                const QSize& geometry = data.get<Photo::Field::Geometry>();
+
+                geometryPhotoIds.append(id.value());
+                widths.append(geometry.width());
+                heights.append(geometry.height());
+            }
+
+            if (data.has(Photo::Field::Flags))
+            {
+                const Photo::FlagValues& flags = data.get<Photo::Field::Flags>();
+
+                auto get_flag = [&flags](Photo::FlagsE flag)
+                {
+                    auto it = flags.find(flag);
+
+                    return it != flags.end()? it->second : 0;
+                };
+
+                flagsPhotoIds.append(id.value());
+                stagingAreas.append(get_flag(Photo::FlagsE::StagingArea));
+                exifLoaded.append(get_flag(Photo::FlagsE::ExifLoaded));
+                geometryLoaded.append(get_flag(Photo::FlagsE::GeometryLoaded));
+            }
+
+            if (data.has(Photo::Field::GroupInfo))
+            {
+                const GroupInfo& groupInfo = data.get<Photo::Field::GroupInfo>();
+
+                // Information about representative is stored during group creation (see storeGroup())
+                if (groupInfo.group_id.valid() && groupInfo.role == GroupInfo::Member)
+                {
+                    membersGroupIds.append(groupInfo.group_id.value());
+                    membersPhotoIds.append(id.value());
+                }
+            }
 
-        //store path and date
-        Photo::Id id = data.getId();
-        assert(id.valid() == false);
+            if (data.has(Photo::Field::PHash))
+            {
+                phashesPhotoIds.append(id.value());
+                phashes.append(data.get<Photo::Field::PHash>().variant());
+            }
+        }
 
-        InsertQueryData insertData(TAB_PHOTOS);
+        execBatch("INSERT INTO " TAB_PHOTOS "(id, path, store_date) VALUES(?, ?, CURRENT_TIMESTAMP)",
+                  { photoIds, paths });
 
-        insertData.setColumns("path", "store_date");
-        insertData.setValues(data.get<Photo::Field::Path>(), InsertQueryData::Value::CurrentTime);
-        insertData.setColumns("id");
-        insertData.setValues(InsertQueryData::Value::Null);
+        execBatch("INSERT INTO " TAB_TAGS "(value, photo_id, name) VALUES(?, ?, ?)",
+                  { tagValues, tagPhotoIds, tagNames });
 
-        QSqlQuery query = getGenericQueryGenerator().insert(db, insertData);
+        execBatch("INSERT INTO " TAB_GEOMETRY "(photo_id, width, height) VALUES(?, ?, ?)",
+                  { geometryPhotoIds, widths, heights });
 
-        DbErrorOnFalse(m_executor.exec(query));
+        execBatch("INSERT INTO " TAB_FLAGS "(photo_id, staging_area, tags_loaded, " FLAG_GEOM_LOADED ") VALUES(?, ?, ?, ?)",
+                  { flagsPhotoIds, stagingAreas, exifLoaded, geometryLoaded });
 
-        // update id
-        // Get Id from database after insert
+        execBatch("INSERT INTO " TAB_GROUPS_MEMBERS "(group_id, photo_id) VALUES(?, ?)",
+                  { membersGroupIds, membersPhotoIds });
 
-        QVariant photo_id  = query.lastInsertId();
-        DbErrorOnFalse(photo_id.isValid());
+        execBatch("INSERT INTO " TAB_PHASHES "(photo_id, hash) VALUES(?, ?)",
+                  { phashesPhotoIds, phashes });
 
-        id = Photo::Id(photo_id.toInt());
+        execBatch("INSERT INTO " TAB_TIMESTAMPS "(photo_id, value) VALUES(?, ?)",
+                  { timestampsPhotoIds, timestamps });
 
-        //make sure id is set
-        DbErrorOnFalse(id.valid());
+        for (const Photo::DataDelta& data: photos)
+            photoChangeLogOperator().storeDifference(Photo::Data(data.getId()), data);
+    }
 
-        assert(data.getId().valid() == false || data.getId() == id);
-        data.setId(id);
 
-        DbErrorOnFalse(storeData(data, Photo::Data(id)));
+    /**
+     * \brief reserve range of ids for new rows of table
+     * \param table table new rows will be inserted to
+     * \param count number of ids to reserve
+     * \return first id of reserved range
+     * \throws db_error when any error during communication with database occurs
+     *
+     * Last allocated id is stored in TAB_ID_SEQUENCES, so ids of removed rows
+     * are never given to new ones (which MAX(id) + 1 or sqlite's rowid would do).
+     * Rows may be also inserted with ids generated by database engine,
+     * so range always starts above the biggest id in table.
+     */
+    int ASqlBackend::allocateIds(const QString& table, int count) const
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+
+        QSqlQuery& sequenceQuery = m_executor.cachedQuery(db, "SELECT value FROM " TAB_ID_SEQUENCES " WHERE name = ?");
+        sequenceQuery.bindValue(0, table);
+        DbErrorOnFalse(m_executor.exec(sequenceQuery));
+
+        const bool hasSequence = sequenceQuery.next();
+        const int lastAllocated = hasSequence? sequenceQuery.value(0).toInt(): 0;
+        sequenceQuery.finish();
+
+        QSqlQuery maxIdQuery(db);
+        DbErrorOnFalse(m_executor.exec(QString("SELECT MAX(id) FROM %1").arg(table), &maxIdQuery));
+
+        // MAX() on empty table returns NULL which is converted to 0
+        const int maxId = maxIdQuery.next()? maxIdQuery.value(0).toInt(): 0;
+        const int firstId = std::max(lastAllocated, maxId) + 1;
+
+        QSqlQuery& updateQuery = m_executor.cachedQuery(db, hasSequence?
+            "UPDATE " TAB_ID_SEQUENCES " SET value = ? WHERE name = ?":
+            "INSERT INTO " TAB_ID_SEQUENCES "(value, name) VALUES(?, ?)");
+
+        updateQuery.bindValue(0, firstId + count - 1);
+        updateQuery.bindValue(1, table);
+        DbErrorOnFalse(m_executor.exec(updateQuery));
+
+        return firstId;
     }
 
 
     /**
-     * \brief store photo data
+     * \brief execute insert statement for many rows at once
+     * \param statement statement with positional placeholders
+     * \param values list of values for each placeholder. All lists need to be of the same size
+     * \throws db_error when any error during communication with database occurs
      */
-    bool ASqlBackend::storeData(const Photo::DataDelta& data)
+    void ASqlBackend::execBatch(const QString& statement, const std::vector<QVariantList>& values) const
     {
-        const Photo::Data currentStateOfPhoto = getPhoto(data.getId());
+        assert(values.empty() == false);
+
+        if (values.front().isEmpty())
+            return;
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery& query = m_executor.cachedQuery(db, statement);
+
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            assert(values[i].size() == values.front().size());
+            query.bindValue(static_cast<int>(i), values[i]);
+        }
 
-        return storeData(data, currentStateOfPhoto);
+        DbErrorOnFalse(m_executor.execBatch(query));
     }
 
 
@@ -923,6 +1330,12 @@ namespace Database
             status = storeTags(data.getId(), tags);
         }
 
+        if (status && data.has(Photo::Field::Path))
+        {
+            const QString& path = data.get<Photo::Field::Path>();
+            status = storePath(data.getId(), path);
+        }
+
         if (status && data.has(Photo::Field::Geometry))
         {
             const QSize& geometry = data.get<Photo::Field::Geometry>();
@@ -966,6 +1379,20 @@ namespace Database
         return status;
     }
 
+    /**
+     * \brief store photo's path (photo was moved)
+     * \return false on error
+     */
+    bool ASqlBackend::storePath(const Photo::Id& photo_id, const QString& path) const
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery& query = m_executor.cachedQuery(db, "UPDATE " TAB_PHOTOS " SET path = :path WHERE id = :id");
+        query.bindValue(":path", path);
+        query.bindValue(":id", photo_id.value());
+
+        return m_executor.exec(query);
+    }
+
     /**
      * \brief store photo's tags in database
      * \return false on error
@@ -1033,6 +1460,40 @@ namespace Database
 
         }
 
+        if (status)
+            status = storeTimestamp(photo_id, tagsList);
+
+        return status;
+    }
+
+
+    /**
+     * \brief keep TAB_TIMESTAMPS in sync with photo's date and time tags
+     * \return false on error
+     */
+    bool ASqlBackend::storeTimestamp(const Photo::Id& photo_id, const Tag::TagsList& tagsList) const
+    {
+        const std::optional<qint64> timestamp = timestampOf(tagsList);
+        bool status = true;
+
+        if (timestamp)
+        {
+            UpdateQueryData data(TAB_TIMESTAMPS);
+            data.addCondition("photo_id", QString::number(photo_id.value()));
+            data.setColumns("photo_id", "value");
+            data.setValues(photo_id.value(), QString::number(*timestamp));
+
+            status = updateOrInsert(data);
+        }
+        else
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+            QSqlQuery& query = m_executor.cachedQuery(db, "DELETE FROM " TAB_TIMESTAMPS " WHERE photo_id = :photo_id");
+            query.bindValue(":photo_id", photo_id.value());
+
+            status = m_executor.exec(query);
+        }
+
         return status;
     }
 
@@ -1119,8 +1580,10 @@ namespace Database
 
         try
         {
-            for(Photo::DataDelta& data: data_set)
-                introduce(data);
+            slice(data_set.begin(), data_set.end(), 1000, [this](auto first, auto last)
+            {
+                introduce(std::span(first, last));
+            });
         }
         catch(const db_error& error)
         {
@@ -1142,17 +1605,14 @@ namespace Database
     Tag::TagsList ASqlBackend::getTagsFor(const Photo::Id& photoId) const
     {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
-
-        const QString queryStr = QString("SELECT "
-                                         "%1.id, %1.name, %1.value "
-                                         "FROM "
-                                         "%1 "
-                                         "WHERE %1.photo_id = '%2'")
-                                 .arg(TAB_TAGS)
-                                 .arg(photoId.value());
-
-        const bool status = m_executor.exec(queryStr, &query);
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT "
+                                                      TAB_TAGS ".id, " TAB_TAGS ".name, " TAB_TAGS ".value "
+                                                      "FROM "
+                                                      TAB_TAGS " "
+                                                      "WHERE " TAB_TAGS ".photo_id = :photo_id");
+        query.bindValue(":photo_id", photoId.value());
+
+        const bool status = m_executor.exec(query);
         Tag::TagsList tagData;
 
         while(status && query.next())
@@ -1185,13 +1645,10 @@ namespace Database
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
 
         QSize geoemtry;
-        QSqlQuery query(db);
-
-        const QString queryStr = QString("SELECT width,height FROM %1 WHERE %1.photo_id = '%2'")
-                                 .arg(TAB_GEOMETRY)
-                                 .arg(id.value());
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT width,height FROM " TAB_GEOMETRY " WHERE " TAB_GEOMETRY ".photo_id = :photo_id");
+        query.bindValue(":photo_id", id.value());
 
-        const bool status = m_executor.exec(queryStr, &query);
+        const bool status = m_executor.exec(query);
 
         if (status && query.next())
         {
@@ -1204,6 +1661,8 @@ namespace Database
             geoemtry = QSize(width, height);
         }
 
+        query.finish();
+
         return geoemtry;
     }
 
@@ -1267,13 +1726,10 @@ namespace Database
         Photo::FlagValues flags;
 
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
-        QString queryStr = QString("SELECT staging_area, tags_loaded, geometry_loaded FROM %1 WHERE %1.photo_id = '%2'");
-
-        queryStr = queryStr.arg(TAB_FLAGS);
-        queryStr = queryStr.arg(id.value());
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT staging_area, tags_loaded, geometry_loaded FROM " TAB_FLAGS " WHERE " TAB_FLAGS ".photo_id = :photo_id");
+        query.bindValue(":photo_id", id.value());
 
-        const bool status = m_executor.exec(queryStr, &query);
+        const bool status = m_executor.exec(query);
 
         if (status && query.next())
         {
@@ -1287,6 +1743,8 @@ namespace Database
             flags[Photo::FlagsE::GeometryLoaded] = variant.toInt();
         }
 
+        query.finish();
+
         return flags;
     }
 
@@ -1298,14 +1756,10 @@ namespace Database
     QString ASqlBackend::getPathFor(const Photo::Id& id) const
     {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT path FROM " TAB_PHOTOS " WHERE " TAB_PHOTOS ".id = :id");
+        query.bindValue(":id", id.value());
 
-        QString queryStr = QString("SELECT path FROM %1 WHERE %1.id = '%2'");
-
-        queryStr = queryStr.arg(TAB_PHOTOS);
-        queryStr = queryStr.arg(id.value());
-
-        const bool status = m_executor.exec(queryStr, &query);
+        const bool status = m_executor.exec(query);
 
         QString result;
         if(status && query.next())
@@ -1315,6 +1769,8 @@ namespace Database
             result = path.toString();
         }
 
+        query.finish();
+
         return result;
     }
 
@@ -1325,14 +1781,10 @@ namespace Database
     bool ASqlBackend::doesPhotoExist(const Photo::Id& id) const
     {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-        QSqlQuery query(db);
+        QSqlQuery& query = m_executor.cachedQuery(db, "SELECT id FROM " TAB_PHOTOS " WHERE " TAB_PHOTOS ".id = :id");
+        query.bindValue(":id", id.value());
 
-        QString queryStr = QString("SELECT id FROM %1 WHERE %1.id = '%2'");
-
-        queryStr = queryStr.arg(TAB_PHOTOS);
-        queryStr = queryStr.arg(id.value());
-
-        const bool status = m_executor.exec(queryStr, &query);
+        const bool status = m_executor.exec(query);
 
         Photo::Id result;
         if(status && query.next())
@@ -1343,16 +1795,222 @@ namespace Database
             result = Photo::Id(p_id.toInt());
         }
 
+        query.finish();
+
         return result == id;
     }
 
 
+    /**
+     * \brief read current state of photos about to be updated
+     * \param deltas updates of photos
+     * \return current state of photos
+     *
+     * Only fields present in deltas and compared by change log are read, in batches.
+     * When no such fields are being updated, nothing is read.
+     */
+    std::map<Photo::Id, Photo::Data> ASqlBackend::fetchTrackedState(const std::vector<Photo::DataDelta>& deltas)
+    {
+        const std::set<Photo::Field>& trackedFields = PhotoChangeLogOperator::trackedFields();
+
+        std::set<Photo::Field> fields;
+        std::vector<Photo::Id> ids;
+
+        for (const Photo::DataDelta& delta: deltas)
+        {
+            bool tracked = false;
+
+            for (const Photo::Field field: trackedFields)
+                if (delta.has(field))
+                {
+                    fields.insert(field);
+                    tracked = true;
+                }
+
+            if (tracked)
+                ids.push_back(delta.getId());
+        }
+
+        std::map<Photo::Id, Photo::Data> state;
+
+        if (ids.empty() == false)
+            for (const Photo::DataDelta& delta: getPhotoDeltas(ids, fields))
+                state.emplace(delta.getId(), Photo::Data(delta.getId()).apply(delta));
+
+        return state;
+    }
+
+
+    /**
+     * \brief read details of many photos with one query per field
+     * \param photosSubset list of photo ids or SQL query returning them
+     * \param _fields fields to be read. All fields are read when empty
+     * \return photos details. Only existing photos are returned.
+     */
+    std::map<Photo::Id, Photo::DataDelta> ASqlBackend::fetchPhotoDeltas(const QString& photosSubset, const std::set<Photo::Field>& _fields) const
+    {
+        std::set<Photo::Field> fields = _fields;
+
+        if (fields.empty())
+        {
+            const auto allEntries = magic_enum::enum_values<Photo::Field>();
+            fields.insert(allEntries.begin(), allEntries.end());
+        }
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+
+        std::map<Photo::Id, Photo::DataDelta> deltas;
+
+        // visit each row of query results which refers to one of collected photos
+        auto forEachRow = [this, &query, &deltas](const QString& queryStr, auto op)
+        {
+            const bool status = m_executor.exec(queryStr, &query);
+
+            while(status && query.next())
+            {
+                const Photo::Id id(query.value(0));
+                auto it = deltas.find(id);
+
+                if (it != deltas.end())
+                    op(it->second);
+            }
+        };
+
+        // NOTE: photosSubset must go as a last argument as it may contain '%X' which would ruin query strings
+        // collect existing photos and fields which have default values
+        const QString photosQuery = QString("SELECT id, path FROM %1 WHERE id IN (%2)")
+                                        .arg(TAB_PHOTOS)
+                                        .arg(photosSubset);
+
+        const bool status = m_executor.exec(photosQuery, &query);
+
+        while(status && query.next())
+        {
+            const Photo::Id id(query.value(0));
+            Photo::DataDelta delta(id);
+
+            if (fields.contains(Photo::Field::Path))
+                delta.insert<Photo::Field::Path>(query.value(1).toString());
+
+            if (fields.contains(Photo::Field::Tags))
+                delta.insert<Photo::Field::Tags>(Tag::TagsList());
+
+            if (fields.contains(Photo::Field::GroupInfo))
+                delta.insert<Photo::Field::GroupInfo>(GroupInfo());
+
+            if (fields.contains(Photo::Field::Flags))
+                delta.insert<Photo::Field::Flags>(Photo::FlagValues());
+
+            deltas.emplace(id, delta);
+        }
+
+        if (deltas.empty())
+            return deltas;
+
+        if (fields.contains(Photo::Field::Tags))
+        {
+            const QString tagsQuery = QString("SELECT photo_id, name, value FROM %1 WHERE photo_id IN (%2)")
+                                        .arg(TAB_TAGS)
+                                        .arg(photosSubset);
+
+            forEachRow(tagsQuery, [&query](Photo::DataDelta& delta)
+            {
+                const Tag::Types tagNameType = static_cast<Tag::Types>( query.value(1).toInt() );
+                const QVariant value = query.value(2);
+
+                // storing routine doesn't store empty tags (see store() for tags)
+                assert(value.isValid() && value.isNull() == false);
+                if (value.isValid() == false || value.isNull())
+                    return;
+
+                const TagValue tagValue = TagValue::fromRaw(value.toString(), BaseTags::getType(tagNameType));
+
+                delta.get<Photo::Field::Tags>()[tagNameType] = tagValue;
+            });
+        }
+
+        if (fields.contains(Photo::Field::Geometry))
+        {
+            const QString geometryQuery = QString("SELECT photo_id, width, height FROM %1 WHERE photo_id IN (%2)")
+                                            .arg(TAB_GEOMETRY)
+                                            .arg(photosSubset);
+
+            forEachRow(geometryQuery, [&query](Photo::DataDelta& delta)
+            {
+                const QSize geometry(query.value(1).toInt(), query.value(2).toInt());
+
+                if (geometry.isValid())
+                    delta.insert<Photo::Field::Geometry>(geometry);
+            });
+        }
+
+        if (fields.contains(Photo::Field::GroupInfo))
+        {
+            const QString membersQuery = QString("SELECT photo_id, group_id FROM %1 WHERE photo_id IN (%2)")
+                                            .arg(TAB_GROUPS_MEMBERS)
+                                            .arg(photosSubset);
+
+            forEachRow(membersQuery, [&query](Photo::DataDelta& delta)
+            {
+                const Group::Id groupId(query.value(1));
+                delta.insert<Photo::Field::GroupInfo>(GroupInfo(groupId, GroupInfo::Member));
+            });
+
+            // representatives are recognized only when group has members (same as in getGroupFor())
+            const QString representativesQuery = QString("SELECT DISTINCT %1.representative_id, %1.id FROM %1 "
+                                                         "JOIN %2 ON (%1.id = %2.group_id) "
+                                                         "WHERE %1.representative_id IN (%3)")
+                                                    .arg(TAB_GROUPS)
+                                                    .arg(TAB_GROUPS_MEMBERS)
+                                                    .arg(photosSubset);
+
+            forEachRow(representativesQuery, [&query](Photo::DataDelta& delta)
+            {
+                const Group::Id groupId(query.value(1));
+                delta.insert<Photo::Field::GroupInfo>(GroupInfo(groupId, GroupInfo::Representative));
+            });
+        }
+
+        if (fields.contains(Photo::Field::Flags))
+        {
+            const QString flagsQuery = QString("SELECT photo_id, staging_area, tags_loaded, geometry_loaded FROM %1 WHERE photo_id IN (%2)")
+                                        .arg(TAB_FLAGS)
+                                        .arg(photosSubset);
+
+            forEachRow(flagsQuery, [&query](Photo::DataDelta& delta)
+            {
+                Photo::FlagValues& flags = delta.get<Photo::Field::Flags>();
+
+                flags[Photo::FlagsE::StagingArea] = query.value(1).toInt();
+                flags[Photo::FlagsE::ExifLoaded] = query.value(2).toInt();
+                flags[Photo::FlagsE::GeometryLoaded] = query.value(3).toInt();
+            });
+        }
+
+        if (fields.contains(Photo::Field::PHash))
+        {
+            const QString phashQuery = QString("SELECT photo_id, hash FROM %1 WHERE photo_id IN (%2)")
+                                        .arg(TAB_PHASHES)
+                                        .arg(photosSubset);
+
+            forEachRow(phashQuery, [&query](Photo::DataDelta& delta)
+            {
+                const Photo::PHash phash(query.value(1).toLongLong());
+                delta.insert<Photo::Field::PHash>(phash);
+            });
+        }
+
+        return deltas;
+    }
+
+
     void ASqlBackend::prune()
     {
         const auto deletedFilter = FilterPhotosWithGeneralFlag(CommonGeneralFlags::State,
                                                                static_cast<int>(CommonGeneralFlags::StateType::Delete),
                                                                FilterPhotosWithGeneralFlag::Mode::Bit);
-        const QString filterQuery = SqlFilterQueryGenerator().generate(deletedFilter);
+        const QString filterQuery = SqlFilterQueryGenerator(getGenericQueryGenerator()).generate(deletedFilter);
 
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
         QSqlQuery query(db);
@@ -1384,6 +2042,7 @@ namespace Database
             QString("DELETE FROM " TAB_TAGS              " WHERE photo_id IN (SELECT * FROM drop_indices)"),
             QString("DELETE FROM " TAB_THUMBS            " WHERE photo_id IN (SELECT * FROM drop_indices)"),
             QString("DELETE FROM " TAB_PHASHES           " WHERE photo_id IN (SELECT * FROM drop_indices)"),
+            QString("DELETE FROM " TAB_TIMESTAMPS        " WHERE photo_id IN (SELECT * FROM drop_indices)"),
 
             QString("DELETE FROM " TAB_PHOTOS            " WHERE id IN (SELECT * FROM drop_indices)"),
             QString("DROP TABLE drop_indices")
@@ -1400,6 +2059,43 @@ namespace Database
 
 
 
+    /**
+     * \brief make sure full text search can be used
+     *
+     * Read-write backend creates missing indexes, read-only one only checks for them.
+     * Lack of indexes (for example sqlite built without FTS5) is not an error,
+     * backend falls back to LIKE based search then.
+     */
+    void ASqlBackend::setupFullTextSearch()
+    {
+        const bool available = isReadOnly()?
+            hasFullTextIndex(TAB_TAGS, "value") && hasFullTextIndex(TAB_PEOPLE_NAMES, "name"):
+            ensureFullTextIndexExists(TAB_TAGS, "value") && ensureFullTextIndexExists(TAB_PEOPLE_NAMES, "name");
+
+        if (available == false)
+        {
+            m_logger->warning("Full text search indexes are not available. Falling back to regular search.");
+            disableFullTextSearch();
+        }
+    }
+
+
+    bool ASqlBackend::hasFullTextIndex(const QString& table, const QString& column) const
+    {
+        // backend does not use full text indexes at all
+        if (getGenericQueryGenerator().prepareFullTextIndexCreation(table, column).isEmpty())
+            return true;
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+
+        const QString findQuery = getGenericQueryGenerator().prepareFindFullTextIndexQuery(table, column);
+        const bool status = m_executor.exec(findQuery, &query);
+
+        return status && query.next();
+    }
+
+
     /**
      * \brief insert data to database or upgrade existing entries.
      * \param queryInfo data to be inserted with rules when to update.
@@ -1408,23 +2104,88 @@ namespace Database
     bool ASqlBackend::updateOrInsert(const UpdateQueryData& queryInfo) const
     {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        const IGenericSqlQueryGenerator& generator = getGenericQueryGenerator();
 
-        QSqlQuery query = getGenericQueryGenerator().update(db, queryInfo);
+        QSqlQuery& update = m_executor.cachedQuery(db, generator.prepareUpdateQuery(queryInfo));
+        generator.bindValues(update, queryInfo);
 
-        bool status = m_executor.exec(query);
+        bool status = m_executor.exec(update);
 
         if (status)
         {
-            const int affected_rows = query.numRowsAffected();
+            const int affected_rows = update.numRowsAffected();
 
             if (affected_rows == 0)
             {
-                query = getGenericQueryGenerator().insert(db, queryInfo);
-                status = m_executor.exec(query);
+                const InsertQueryData& insertInfo = queryInfo;
+
+                QSqlQuery& insert = m_executor.cachedQuery(db, generator.prepareInsertQuery(insertInfo));
+                generator.bindValues(insert, insertInfo);
+
+                status = m_executor.exec(insert);
             }
         }
 
         return status;
     }
 
+
+    /**
+     * \brief read dates of photos into histogram
+     * \arg histogram histogram to be filled
+     * \arg photosSubset comma separated list of photo ids. All photos are read when empty
+     */
+    void ASqlBackend::loadDates(DatesHistogram& histogram, const QString& photosSubset) const
+    {
+        QString queryStr = QString("SELECT %1.id, %2.value FROM %1 LEFT JOIN %2 ON (%2.photo_id = %1.id)")
+                            .arg(TAB_PHOTOS)
+                            .arg(TAB_TIMESTAMPS);
+
+        // NOTE: photosSubset must go as a last argument as it may contain '%X' which would ruin query string
+        if (photosSubset.isEmpty() == false)
+            queryStr += QString(" WHERE %1.id IN (%2)")
+                            .arg(TAB_PHOTOS)
+                            .arg(photosSubset);
+
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+        QSqlQuery query(db);
+
+        const bool status = m_executor.exec(queryStr, &query);
+
+        while(status && query.next())
+        {
+            const Photo::Id id(query.value(0));
+            const QVariant value = query.value(1);
+            const QDate date = value.isNull()? QDate(): timestampDate(value.toLongLong());
+
+            histogram.set(id, date);
+        }
+    }
+
+
+    void ASqlBackend::updateDatesHistogram(const std::vector<Photo::Id>& ids)
+    {
+        // nothing to update until histogram is requested for the first time
+        if (m_datesHistogram.has_value() == false)
+            return;
+
+        slice(ids.begin(), ids.end(), 1000, [this](auto first, auto last)
+        {
+            QStringList idsList;
+            std::transform(first, last, std::back_inserter(idsList), [](const Photo::Id& id) { return QString::number(id.value()); });
+
+            // photos which no longer exist won't be reloaded
+            std::for_each(first, last, [this](const Photo::Id& id) { m_datesHistogram->remove(id); });
+
+            loadDates(*m_datesHistogram, idsList.join(", "));
+        });
+    }
+
+
+    void ASqlBackend::removeFromDatesHistogram(const std::vector<Photo::Id>& ids)
+    {
+        if (m_datesHistogram.has_value())
+            for (const Photo::Id& id: ids)
+                m_datesHistogram->remove(id);
+    }
 }
@@ -22,11 +22,16 @@
 #ifndef ASQLBACKEND_HPP
 #define ASQLBACKEND_HPP
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
-#include <vector>
+
+#include <QVariant>
 
 #include "core/lazy_ptr.hpp"
+#include "database/dates_histogram.hpp"
 #include "database/ibackend.hpp"
 #include "database/notifications_accumulator.hpp"
 #include "database/transaction_wrapper.hpp"
@@ -56,7 +61,13 @@ namespace Database
     class SQL_BACKEND_BASE_EXPORT ASqlBackend: public Database::IBackend
     {
         public:
-            ASqlBackend(ILogger *);
+            enum class AccessMode
+            {
+                ReadWrite,
+                ReadOnly,           ///< backend only reads data, structure is not checked nor modified.
+            };
+
+            ASqlBackend(ILogger *, AccessMode = AccessMode::ReadWrite);
             ASqlBackend(const ASqlBackend& other) = delete;
             virtual ~ASqlBackend();
 
@@ -103,6 +114,12 @@ namespace Database
              */
             virtual bool dbOpened();
 
+            /**
+             * \brief check access mode
+             * \return true if backend was constructed as read only one
+             */
+            bool isReadOnly() const;
+
 
             /**
             * \brief Make sure given table exists in database
@@ -112,6 +129,24 @@ namespace Database
             */
             BackendStatus ensureTableExists(const TableDefinition &) const;
 
+            /**
+            * \brief Make sure full text search index for table's column exists
+            * \return true on success
+            *
+            * If index does not exist, will be created.
+            * Does nothing when backend does not support full text search.
+            * Partially created index is removed on failure.
+            */
+            BackendStatus ensureFullTextIndexExists(const QString& table, const QString& column) const;
+
+            /**
+             * \brief called when full text search indexes are not available
+             *
+             * Backend should stop generating full text search queries,
+             * so LIKE based search is used instead.
+             */
+            virtual void disableFullTextSearch();
+
             /**
              * \brief Execute query
              * \param query query to be executed
@@ -132,10 +167,12 @@ namespace Database
             std::unique_ptr<PhotoChangeLogOperator> m_photoChangeLogOperator;
             lazy_ptr<IPeopleInformationAccessor, std::function<IPeopleInformationAccessor*()>> m_peopleInfoAccessor;
             NotificationsAccumulator m_notificationsAccumulator;
+            std::optional<DatesHistogram> m_datesHistogram;        ///< loaded on first use, then updated with notifications. Not used by read only backends
             mutable TransactionManager<SqlTransaction> m_tr_db;
             QString m_connectionName;
             std::unique_ptr<ILogger> m_logger;
             SqlQueryExecutor m_executor;
+            const AccessMode m_accessMode;
             bool m_dbHasSizeFeature;
             bool m_dbOpen;
 
@@ -145,17 +182,22 @@ namespace Database
             bool update(const std::vector<Photo::DataDelta> &) override final;
 
             std::vector<TagValue>    listTagValues(const Tag::Types &, const Filter &) override final;
+            std::map<QDate, int>     getDatesHistogram() override final;
 
             Photo::Data              getPhoto(const Photo::Id &) override final;
             Photo::DataDelta         getPhotoDelta(const Photo::Id &, const std::set<Photo::Field> & = {}) override final;
+            std::vector<Photo::DataDelta> getPhotoDeltas(const std::vector<Photo::Id> &, const std::set<Photo::Field> & = {}) override final;
+            std::vector<Photo::DataDelta> getPhotoDeltas(const Filter &, const std::set<Photo::Field> & = {}) override final;
             int                      getPhotosCount(const Filter &) override final;
             void                     set(const Photo::Id &, const QString &, int) override final;
             std::optional<int>       get(const Photo::Id &, const QString &) override final;
+            std::map<Photo::Id, int> getFlagValues(const QString &) override final;
             void                     setBits(const Photo::Id& id, const QString& name, int bits) override final;
             void                     clearBits(const Photo::Id& id, const QString& name, int bits) override final;
 
             void setThumbnail(const Photo::Id &, const QByteArray &) override;
             QByteArray getThumbnail(const Photo::Id &) override;
+            std::vector<std::pair<Photo::Id, QByteArray>> takeThumbnails(int) override;
 
             std::vector<Photo::Id> markStagedAsReviewed() override final;
             //
@@ -163,6 +205,8 @@ namespace Database
             // general helpers
             BackendStatus checkStructure();
             int hasCurrentVersionTable();
+            void setupFullTextSearch();
+            bool hasFullTextIndex(const QString& table, const QString& column) const;
             Database::BackendStatus checkDBVersion();
             bool updateOrInsert(const UpdateQueryData &) const;
 
@@ -175,11 +219,14 @@ namespace Database
 
             bool insert(std::vector<Photo::DataDelta> &);
 
-            void introduce(Photo::DataDelta &);
-            bool storeData(const Photo::DataDelta &);
+            void introduce(std::span<Photo::DataDelta>);
+            int allocateIds(const QString& table, int count) const;
+            void execBatch(const QString& statement, const std::vector<QVariantList>& values) const;
             bool storeData(const Photo::DataDelta& newData, const Photo::Data& oldData);
             bool storeGeometryFor(const Photo::Id &, const QSize &) const;
+            bool storePath(const Photo::Id &, const QString &) const;
             bool storeTags(const Photo::Id& photo_id, const Tag::TagsList &) const;
+            bool storeTimestamp(const Photo::Id &, const Tag::TagsList &) const;
             bool storeFlags(const Photo::Id &, const Photo::FlagValues &) const;
             bool storeGroup(const Photo::Id &, const GroupInfo &) const;
 
@@ -189,7 +236,15 @@ namespace Database
             Photo::FlagValues    getFlagsFor(const Photo::Id &) const;
             QString getPathFor(const Photo::Id &) const;
             bool doesPhotoExist(const Photo::Id &) const;
+
+            std::map<Photo::Id, Photo::Data> fetchTrackedState(const std::vector<Photo::DataDelta> &);
+            std::map<Photo::Id, Photo::DataDelta> fetchPhotoDeltas(const QString& photosSubset, const std::set<Photo::Field> &) const;
             void prune();
+
+            // dates histogram maintenance
+            void loadDates(DatesHistogram &, const QString& photosSubset = {}) const;
+            void updateDatesHistogram(const std::vector<Photo::Id> &);
+            void removeFromDatesHistogram(const std::vector<Photo::Id> &);
     };
 }
 
@@ -21,6 +21,7 @@
 
 #include <QStringList>
 
+#include "isql_query_constructor.hpp"
 #include "tables.hpp"
 
 
@@ -53,6 +54,63 @@ namespace Database
             return comparisonType;
         }
 
+        // Filter photos by date using TAB_TIMESTAMPS instead of string comparison of date tags.
+        // Behaves the same way as generic tag filter: missing date is treated as a value lower than any date.
+        QString dateFilter(const FilterPhotosWithTag& desciption)
+        {
+            const QDate date = desciption.tagValue.getDate();
+            const qint64 dayBegin = timestampValue(date, QTime(0, 0));
+            const qint64 nextDayBegin = timestampValue(date.addDays(1), QTime(0, 0));
+
+            QString condition;
+            bool emptyMatches = false;
+
+            switch (desciption.valueMode)
+            {
+                case ComparisonOp::Equal:
+                    condition = QString("%1.value >= %2 AND %1.value < %3").arg(TAB_TIMESTAMPS).arg(dayBegin).arg(nextDayBegin);
+                    break;
+
+                case ComparisonOp::Less:
+                    condition = QString("%1.value < %2").arg(TAB_TIMESTAMPS).arg(dayBegin);
+                    emptyMatches = true;
+                    break;
+
+                case ComparisonOp::LessOrEqual:
+                    condition = QString("%1.value < %2").arg(TAB_TIMESTAMPS).arg(nextDayBegin);
+                    emptyMatches = true;
+                    break;
+
+                case ComparisonOp::Greater:
+                    condition = QString("%1.value >= %2").arg(TAB_TIMESTAMPS).arg(nextDayBegin);
+                    break;
+
+                case ComparisonOp::GreaterOrEqual:
+                    condition = QString("%1.value >= %2").arg(TAB_TIMESTAMPS).arg(dayBegin);
+                    break;
+            }
+
+            QString result;
+
+            if (desciption.includeEmpty)
+            {
+                if (emptyMatches)
+                    condition = QString("(%1 OR %2.value IS NULL)").arg(condition).arg(TAB_TIMESTAMPS);
+
+                result = QString("SELECT %1.id FROM %1 LEFT JOIN %2 ON (%2.photo_id = %1.id) WHERE %3")
+                                .arg(TAB_PHOTOS)
+                                .arg(TAB_TIMESTAMPS)
+                                .arg(condition);
+            }
+            else
+                result = QString("SELECT %1.id FROM %1 JOIN %2 ON (%2.photo_id = %1.id) WHERE %3")
+                                .arg(TAB_PHOTOS)
+                                .arg(TAB_TIMESTAMPS)
+                                .arg(condition);
+
+            return result;
+        }
+
         QString logicalString(LogicalOp mode)
         {
             QString logicalType;
@@ -68,6 +126,14 @@ namespace Database
     }
 
     SqlFilterQueryGenerator::SqlFilterQueryGenerator()
+        : m_genericGenerator(nullptr)
+    {
+
+    }
+
+
+    SqlFilterQueryGenerator::SqlFilterQueryGenerator(const IGenericSqlQueryGenerator& genericGenerator)
+        : m_genericGenerator(&genericGenerator)
     {
 
     }
@@ -149,6 +215,9 @@ namespace Database
 
     QString SqlFilterQueryGenerator::visit(const FilterPhotosWithTag& desciption) const
     {
+        if (desciption.tagType == Tag::Types::Date && desciption.tagValue.type() == Tag::ValueType::Date)
+            return dateFilter(desciption);
+
         QString result;
         QString condition;
         const QString comparisonType = comparisonString(desciption.valueMode);
@@ -275,13 +344,31 @@ namespace Database
             }
             else
             {
-                tags_conditions += QString("%1.value LIKE '%%2%'")
-                                        .arg(TAB_TAGS)
-                                        .arg(condition);
+                const QString tags_search = m_genericGenerator == nullptr?
+                    QString():
+                    m_genericGenerator->prepareFullTextSearchQuery(TAB_TAGS, "value", condition);
 
-                people_conditions += QString("%1.name LIKE '%%2%'")
-                                            .arg(TAB_PEOPLE_NAMES)
+                const QString people_search = m_genericGenerator == nullptr?
+                    QString():
+                    m_genericGenerator->prepareFullTextSearchQuery(TAB_PEOPLE_NAMES, "name", condition);
+
+                if (tags_search.isEmpty())
+                    tags_conditions += QString("%1.value LIKE '%%2%'")
+                                            .arg(TAB_TAGS)
                                             .arg(condition);
+                else
+                    tags_conditions += QString("%1.id IN (%2)")
+                                            .arg(TAB_TAGS)
+                                            .arg(tags_search);
+
+                if (people_search.isEmpty())
+                    people_conditions += QString("%1.name LIKE '%%2%'")
+                                                .arg(TAB_PEOPLE_NAMES)
+                                                .arg(condition);
+                else
+                    people_conditions += QString("%1.id IN (%2)")
+                                                .arg(TAB_PEOPLE_NAMES)
+                                                .arg(people_search);
             }
 
             if (i + 1 < s)
@@ -312,7 +399,43 @@ namespace Database
     {
         return QString("SELECT %1.id FROM %1 WHERE %1.path = '%2'")
                 .arg(TAB_PHOTOS)
-                .arg(filter.path);
+                .arg(QString(filter.path).replace('\'', "''"));
+    }
+
+    QString SqlFilterQueryGenerator::visit(const FilterPhotosInDirectories& filter) const
+    {
+        QStringList conditions;
+
+        for (const QString& directory: filter.directories)
+        {
+            const QString prefix = directory.endsWith('/')? directory: directory + '/';
+
+            // '0' is next character after '/', so all paths starting with prefix are in range (prefix, upper)
+            // which can be found with path index. Paths from subdirectories are dropped by INSTR.
+            QString upper = prefix;
+            upper.back() = '0';
+
+            const QString range = QString(TAB_PHOTOS ".path > '%1' AND " TAB_PHOTOS ".path < '%2'")
+                .arg(QString(prefix).replace('\'', "''"),
+                     QString(upper).replace('\'', "''"));
+
+            if (filter.recursive)
+                conditions.append("(" + range + ")");
+            else
+            {
+                const qsizetype prefixLength = prefix.toUcs4().size();
+
+                conditions.append(QString("(%1 AND INSTR(SUBSTR(" TAB_PHOTOS ".path, %2), '/') = 0)")
+                    .arg(range, QString::number(prefixLength + 1)));
+            }
+        }
+
+        if (conditions.isEmpty())
+            conditions.append("1 = 0");
+
+        return QString("SELECT %1.id FROM %1 WHERE %2")
+                .arg(TAB_PHOTOS)
+                .arg(conditions.join(" OR "));
     }
 
     QString SqlFilterQueryGenerator::visit(const FilterPhotosWithRole& filter) const
@@ -28,11 +28,19 @@
 
 namespace Database
 {
+    struct IGenericSqlQueryGenerator;
 
     class SqlFilterQueryGenerator
     {
         public:
             SqlFilterQueryGenerator();
+
+            /**
+             * \brief construct generator using backend's full text search for matching expressions
+             *
+             * When backend does not support full text search, LIKE comparisons are used.
+             */
+            explicit SqlFilterQueryGenerator(const IGenericSqlQueryGenerator &);
             SqlFilterQueryGenerator(const SqlFilterQueryGenerator &) = delete;
             ~SqlFilterQueryGenerator();
 
@@ -41,6 +49,8 @@ namespace Database
             QString generate(const Filter &) const;
 
         private:
+            const IGenericSqlQueryGenerator* m_genericGenerator;
+
             QString getFlagName(Photo::FlagsE flag) const;
             QString visit(const EmptyFilter &) const;
             QString visit(const GroupFilter& groupFilter) const;
@@ -50,6 +60,7 @@ namespace Database
             QString visit(const FilterPhotosWithId& filter) const;
             QString visit(const FilterPhotosMatchingExpression& filter) const;
             QString visit(const FilterPhotosWithPath& filter) const;
+            QString visit(const FilterPhotosInDirectories& filter) const;
             QString visit(const FilterPhotosWithRole& filter) const;
             QString visit(const FilterPhotosWithPerson& personFilter) const;
             QString visit(const FilterPhotosWithGeneralFlag& genericFlagsFilter) const;
@@ -25,6 +25,7 @@
 
 #include <QMap>
 #include <QString>
+#include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
@@ -36,7 +37,11 @@
 namespace Database
 {
 
-    SqlQueryExecutor::SqlQueryExecutor(): m_database_thread_id(), m_logger(nullptr)
+    SqlQueryExecutor::SqlQueryExecutor()
+        : m_cacheHits(0)
+        , m_cacheMisses(0)
+        , m_database_thread_id()
+        , m_logger(nullptr)
     {
 
     }
@@ -69,6 +74,18 @@ namespace Database
 
 
     BackendStatus SqlQueryExecutor::exec(QSqlQuery& query) const
+    {
+        return execute(query, [](QSqlQuery& q) { return q.exec(); });
+    }
+
+
+    BackendStatus SqlQueryExecutor::execBatch(QSqlQuery& query) const
+    {
+        return execute(query, [](QSqlQuery& q) { return q.execBatch(); });
+    }
+
+
+    BackendStatus SqlQueryExecutor::execute(QSqlQuery& query, const std::function<bool(QSqlQuery &)>& executor) const
     {
         // threads cannot be used with sql connections:
         // http://qt-project.org/doc/qt-5/threads-modules.html#threads-and-the-sql-module
@@ -76,7 +93,7 @@ namespace Database
         assert(std::this_thread::get_id() == m_database_thread_id);
 
         const auto start = std::chrono::steady_clock::now();
-        const BackendStatus status = query.exec()? StatusCodes::Ok: StatusCodes::QueryFailed;
+        const BackendStatus status = executor(query)? StatusCodes::Ok: StatusCodes::QueryFailed;
         const auto end = std::chrono::steady_clock::now();
         const auto diff = end - start;
         const auto diff_ms = std::chrono::duration_cast<std::chrono::milliseconds>(diff).count();
@@ -125,6 +142,65 @@ namespace Database
     }
 
 
+    QSqlQuery& SqlQueryExecutor::cachedQuery(const QSqlDatabase& db, const QString& statement) const
+    {
+        assert(std::this_thread::get_id() == m_database_thread_id);
+
+        const auto key = std::make_pair(db.connectionName(), statement);
+        auto it = m_cache.find(key);
+
+        if (it != m_cache.end())
+        {
+            m_cacheHits++;
+            it->second.finish();
+
+            return it->second;
+        }
+
+        m_cacheMisses++;
+
+        it = m_cache.emplace(key, QSqlQuery(db)).first;
+        const BackendStatus status = prepare(statement, &it->second);
+
+        m_logger->trace(QString("Statement cache miss (hits: %1, misses: %2): %3")
+                            .arg(m_cacheHits)
+                            .arg(m_cacheMisses)
+                            .arg(statement));
+
+        if (status)
+            return it->second;
+
+        // do not keep broken statement, next call will try to prepare it again
+        m_failedQuery = it->second;
+        m_cache.erase(it);
+
+        m_logger->error(QString("Error during query preparation. '%1' finished with: '%2'")
+                            .arg(statement)
+                            .arg(m_failedQuery.lastError().text()));
+
+        return m_failedQuery;
+    }
+
+
+    void SqlQueryExecutor::clearCache()
+    {
+        if (m_logger != nullptr && m_cache.empty() == false)
+            m_logger->trace(QString("Dropping %1 cached statements (hits: %2, misses: %3)")
+                                .arg(m_cache.size())
+                                .arg(m_cacheHits)
+                                .arg(m_cacheMisses));
+
+        m_cache.clear();
+        m_failedQuery = QSqlQuery();
+    }
+
+
+    std::size_t SqlQueryExecutor::cachedStatements() const
+    {
+        return m_cache.size();
+    }
+
+
     BackendStatus SqlQueryExecutor::exec(const std::vector<QString>& queries, QSqlQuery* result) const
     {
         BackendStatus status(StatusCodes::Ok);
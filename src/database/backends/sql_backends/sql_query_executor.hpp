@@ -20,8 +20,13 @@
 #ifndef SQLQUERYEXECUTOR_HPP
 #define SQLQUERYEXECUTOR_HPP
 
+#include <functional>
+#include <map>
 #include <thread>
 
+#include <QSqlQuery>
+#include <QString>
+
 #include "isql_query_executor.hpp"
 
 struct ILogger;
@@ -45,10 +50,29 @@ namespace Database
             BackendStatus exec(const std::vector<QString>& query, QSqlQuery* result) const override;
             BackendStatus exec(const QString& query, QSqlQuery* result) const override;
             BackendStatus exec(QSqlQuery& query) const override;
+            BackendStatus execBatch(QSqlQuery& query) const override;
+            QSqlQuery& cachedQuery(const QSqlDatabase& db, const QString& statement) const override;
+
+            /**
+             * \brief drop all cached statements
+             *
+             * Needs to be called before connections used by cached statements are closed.
+             */
+            void clearCache();
+
+            /// number of statements in cache
+            std::size_t cachedStatements() const;
 
         private:
+            // connection name and statement template -> prepared query
+            mutable std::map<std::pair<QString, QString>, QSqlQuery> m_cache;
+            mutable QSqlQuery m_failedQuery;            // statement which could not be prepared, returned instead of a cached one
+            mutable std::size_t m_cacheHits;
+            mutable std::size_t m_cacheMisses;
             std::thread::id m_database_thread_id;
             ILogger* m_logger;
+
+            BackendStatus execute(QSqlQuery &, const std::function<bool(QSqlQuery &)> &) const;
     };
 
 }
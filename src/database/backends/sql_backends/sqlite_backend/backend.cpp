@@ -7,6 +7,7 @@
 #include <QSqlQuery>
 #include <QStringList>
 #include <QDir>
+#include <QRegularExpression>
 
 #include <database/project_info.hpp>
 #include <backends/sql_backends/table_definition.hpp>
@@ -14,10 +15,18 @@
 
 namespace Database
 {
+    namespace
+    {
+        QString fullTextIndexName(const QString& table)
+        {
+            return table + "_fts";
+        }
+    }
+
 
     struct SQLiteBackend::Data
     {
-        Data(): m_initialized(false) {}
+        Data(): m_initialized(false), m_fullTextSearch(true) {}
 
         ~Data()
         {
@@ -42,10 +51,11 @@ namespace Database
         }
 
         bool m_initialized;
+        bool m_fullTextSearch;
     };
 
 
-    SQLiteBackend::SQLiteBackend(IConfiguration *, ILogger* l): ASqlBackend(l), m_data(new Data)
+    SQLiteBackend::SQLiteBackend(IConfiguration *, ILogger* l, AccessMode accessMode): ASqlBackend(l, accessMode), m_data(new Data)
     {
 
     }
@@ -68,13 +78,23 @@ namespace Database
         QSqlDatabase db = QSqlDatabase::database(getConnectionName());
         QSqlQuery query(db);
 
-        bool status = query.exec("PRAGMA journal_mode = WAL;");
+        bool status = true;
 
-        if (status)
-            status = query.exec("PRAGMA synchronous = NORMAL;"); // TODO: dangerous, use some backups?
+        if (isReadOnly())
+        {
+            // WAL mode is set by read-write connection and is persistent, readers just need to not write
+            status = query.exec("PRAGMA query_only = ON;");
+        }
+        else
+        {
+            status = query.exec("PRAGMA journal_mode = WAL;");
 
-        if (status)
-            status = query.exec("PRAGMA foreign_keys = ON;");
+            if (status)
+                status = query.exec("PRAGMA synchronous = NORMAL;"); // TODO: dangerous, use some backups?
+
+            if (status)
+                status = query.exec("PRAGMA foreign_keys = ON;");
+        }
 
         if (status)
             status = Database::ASqlBackend::dbOpened();
@@ -83,6 +103,12 @@ namespace Database
     }
 
 
+    void SQLiteBackend::disableFullTextSearch()
+    {
+        m_data->m_fullTextSearch = false;
+    }
+
+
     QString SQLiteBackend::prepareFindTableQuery(const QString& name) const
     {
         return QString("SELECT name FROM sqlite_master WHERE name='%1';").arg(name);
@@ -116,6 +142,74 @@ namespace Database
     }
 
 
+    QStringList SQLiteBackend::prepareFullTextIndexCreation(const QString& table, const QString& column) const
+    {
+        // External content FTS5 table kept in sync with source table by triggers.
+        // https://www.sqlite.org/fts5.html#external_content_tables
+        const QString index = fullTextIndexName(table);
+
+        return {
+            QString("CREATE VIRTUAL TABLE %1 USING fts5(%3, content='%2', content_rowid='id');")
+                .arg(index, table, column),
+            QString("CREATE TRIGGER %1_ai AFTER INSERT ON %2 BEGIN "
+                    "INSERT INTO %1(rowid, %3) VALUES (new.id, new.%3); "
+                    "END;")
+                .arg(index, table, column),
+            QString("CREATE TRIGGER %1_ad AFTER DELETE ON %2 BEGIN "
+                    "INSERT INTO %1(%1, rowid, %3) VALUES ('delete', old.id, old.%3); "
+                    "END;")
+                .arg(index, table, column),
+            QString("CREATE TRIGGER %1_au AFTER UPDATE ON %2 BEGIN "
+                    "INSERT INTO %1(%1, rowid, %3) VALUES ('delete', old.id, old.%3); "
+                    "INSERT INTO %1(rowid, %3) VALUES (new.id, new.%3); "
+                    "END;")
+                .arg(index, table, column),
+            QString("INSERT INTO %1(%1) VALUES ('rebuild');").arg(index)
+        };
+    }
+
+
+    QStringList SQLiteBackend::prepareFullTextIndexRemoval(const QString& table, const QString &) const
+    {
+        const QString index = fullTextIndexName(table);
+
+        return {
+            QString("DROP TRIGGER IF EXISTS %1_ai;").arg(index),
+            QString("DROP TRIGGER IF EXISTS %1_ad;").arg(index),
+            QString("DROP TRIGGER IF EXISTS %1_au;").arg(index),
+            QString("DROP TABLE IF EXISTS %1;").arg(index)
+        };
+    }
+
+
+    QString SQLiteBackend::prepareFindFullTextIndexQuery(const QString& table, const QString &) const
+    {
+        return prepareFindTableQuery(fullTextIndexName(table));
+    }
+
+
+    QString SQLiteBackend::prepareFullTextSearchQuery(const QString& table, const QString &, const QString& phrase) const
+    {
+        // no index (sqlite without FTS5), regular search will be used
+        if (m_data->m_fullTextSearch == false)
+            return {};
+
+        // each word of phrase becomes quoted prefix query so no FTS5 operators are interpreted
+        static const QRegularExpression nonWord("[^\\w]+", QRegularExpression::UseUnicodePropertiesOption);    // \w should match letters of any language
+        const QStringList words = phrase.split(nonWord, Qt::SkipEmptyParts);
+
+        if (words.isEmpty())
+            return {};
+
+        QStringList prefixes;
+        for (const QString& word: words)
+            prefixes.append(QString("\"%1\"*").arg(word));
+
+        return QString("SELECT rowid FROM %1 WHERE %1 MATCH '%2'")
+                .arg(fullTextIndexName(table), prefixes.join(" "));
+    }
+
+
     SQLitePlugin::SQLitePlugin(): IPlugin()
     {
 
@@ -134,6 +228,12 @@ namespace Database
     }
 
 
+    std::unique_ptr<IBackend> SQLitePlugin::constructReadOnlyBackend(IConfiguration* c, ILogger* l)
+    {
+        return std::make_unique<SQLiteBackend>(c, l, ASqlBackend::AccessMode::ReadOnly);
+    }
+
+
     QString SQLitePlugin::backendName() const
     {
         return "SQLite";
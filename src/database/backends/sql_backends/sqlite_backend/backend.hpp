@@ -20,18 +20,23 @@ namespace Database
     class SQLiteBackend final: public ASqlBackend, GenericSqlQueryConstructor
     {
         public:
-            SQLiteBackend(IConfiguration *, ILogger *);
+            SQLiteBackend(IConfiguration *, ILogger *, AccessMode = AccessMode::ReadWrite);
             virtual ~SQLiteBackend();
 
         private:
             // ASqlBackend:
             virtual BackendStatus prepareDB(const ProjectInfo &) override;
             virtual bool dbOpened() override;
+            virtual void disableFullTextSearch() override;
             virtual const IGenericSqlQueryGenerator& getGenericQueryGenerator() const override;
 
             //ISqlQueryConstructor:
             virtual QString prepareFindTableQuery(const QString &) const override;
             virtual QString getTypeFor(ColDefinition::Purpose) const override;
+            virtual QStringList prepareFullTextIndexCreation(const QString& table, const QString& column) const override;
+            virtual QStringList prepareFullTextIndexRemoval(const QString& table, const QString& column) const override;
+            virtual QString prepareFindFullTextIndexQuery(const QString& table, const QString& column) const override;
+            virtual QString prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const override;
 
             struct Data;
             std::unique_ptr<Data> m_data;
@@ -52,6 +57,7 @@ namespace Database
             virtual ~SQLitePlugin();
 
             virtual std::unique_ptr<IBackend> constructBackend(IConfiguration *, ILogger *) override;
+            virtual std::unique_ptr<IBackend> constructReadOnlyBackend(IConfiguration *, ILogger *) override;
             virtual QString backendName() const override;
             virtual ProjectInfo initPrjDir(const QString& dir, const QString& name) const override;
             virtual QLayout* buildDBOptions() override;
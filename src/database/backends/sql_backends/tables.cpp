@@ -1,6 +1,9 @@
 
 #include "tables.hpp"
 
+#include <QDateTime>
+#include <QTimeZone>
+
 #include <core/constants.hpp>
 
 #include "table_definition.hpp"
@@ -10,7 +13,7 @@ namespace Database
         //check for proper sizes
         static_assert(sizeof(int) >= 4, "int is smaller than MySQL's equivalent");
 
-        const int db_version = 6;
+        const int db_version = 7;
 
         TableDefinition
         table_versionHistory(TAB_VER,
@@ -187,6 +190,36 @@ namespace Database
             }
         );
 
+        // date and time of photo as a single, indexed value (see timestampValue()).
+        // Denormalization of date and time tags, used for sorting and date filtering.
+        TableDefinition
+        table_timestamps(TAB_TIMESTAMPS,
+            {
+                { "id", "", ColDefinition::Purpose::ID },
+                { "photo_id", "INTEGER NOT NULL"       },
+                { "value", "BIGINT NOT NULL"           },
+                { "FOREIGN KEY(photo_id) REFERENCES " TAB_PHOTOS "(id)", ""  },
+            },
+            {
+                { "ts_photo_id", "UNIQUE INDEX", "(photo_id)" },      // one timestamp per photo
+                { "ts_value", "INDEX", "(value)" },
+            }
+        );
+
+        // last ids allocated for tables (see ASqlBackend::allocateIds()).
+        // Unlike MAX(id) they never go back, so ids of removed rows are not reused.
+        TableDefinition
+        table_id_sequences(TAB_ID_SEQUENCES,
+            {
+                { "id", "", ColDefinition::Purpose::ID },
+                { "name", "VARCHAR(64) NOT NULL"       },
+                { "value", "INTEGER NOT NULL"          },
+            },
+            {
+                { "is_name", "UNIQUE INDEX", "(name)" },
+            }
+        );
+
         //all tables
         std::map<std::string, TableDefinition> tables =
         {
@@ -204,5 +237,21 @@ namespace Database
             { TAB_GENERAL_FLAGS,        table_general_flags },
             { TAB_PHOTOS_CHANGE_LOG,    table_photos_change_log },
             { TAB_PHASHES,              table_phashes },
+            { TAB_TIMESTAMPS,           table_timestamps },
+            { TAB_ID_SEQUENCES,         table_id_sequences },
         };
+
+
+        qint64 timestampValue(const QDate& date, const QTime& time)
+        {
+            const QDateTime dateTime(date, time.isValid()? time: QTime(0, 0), QTimeZone::utc());
+
+            return dateTime.toMSecsSinceEpoch();
+        }
+
+
+        QDate timestampDate(qint64 value)
+        {
+            return QDateTime::fromMSecsSinceEpoch(value, QTimeZone::utc()).date();
+        }
 }
@@ -5,6 +5,9 @@
 #include <map>
 #include <string>
 
+#include <QDate>
+#include <QTime>
+
 #define TAB_VER                  "version"
 #define TAB_PHOTOS               "photos"
 #define TAB_TAGS                 "tags"
@@ -19,6 +22,8 @@
 #define TAB_GENERAL_FLAGS        "general_flags"
 #define TAB_PHOTOS_CHANGE_LOG    "photos_change_log"
 #define TAB_PHASHES              "phashes"
+#define TAB_TIMESTAMPS           "timestamps"
+#define TAB_ID_SEQUENCES         "id_sequences"
 
 #define FLAG_STAGING_AREA  "staging_area"
 #define FLAG_TAGS_LOADED   "tags_loaded"
@@ -29,6 +34,13 @@ namespace Database
     struct TableDefinition;
     extern std::map<std::string, TableDefinition> tables;
     extern const int db_version;
+
+    /// value stored in TAB_TIMESTAMPS for given date and time of photo.
+    /// Time zone independent, so it sorts the same way date and time tags do.
+    qint64 timestampValue(const QDate &, const QTime &);
+
+    /// date part of value stored in TAB_TIMESTAMPS. Reverse of timestampValue()
+    QDate timestampDate(qint64);
 }
 
 #endif
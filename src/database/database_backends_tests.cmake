@@ -29,6 +29,7 @@ addTestTarget(database_backends
 
                     # sql tests:
                     unit_tests_for_backends/common.hpp
+                    unit_tests_for_backends/dates_histogram_tests.cpp
                     unit_tests_for_backends/filters_tests.cpp
                     unit_tests_for_backends/general_flags_tests.cpp
                     unit_tests_for_backends/groups_tests.cpp
@@ -37,6 +38,7 @@ addTestTarget(database_backends
                     unit_tests_for_backends/photo_operator_tests.cpp
                     unit_tests_for_backends/photos_change_log_tests.cpp
                     unit_tests_for_backends/photos_tests.cpp
+                    unit_tests_for_backends/sqlite_backend_tests.cpp
                     unit_tests_for_backends/tags_tests.cpp
                     unit_tests_for_backends/thumbnails_tests.cpp
                     unit_tests_for_backends/transaction_accumulations_tests.cpp
@@ -45,6 +47,7 @@ addTestTarget(database_backends
                     database_tools/implementation/tag_info_collector.cpp
                     implementation/apeople_information_accessor.cpp
                     implementation/aphoto_change_log_operator.cpp
+                    implementation/dates_histogram.cpp
                     implementation/notifications_accumulator.cpp
                     notifications_accumulator.hpp
 
@@ -5,6 +5,15 @@
 #include <core/task_executor_utils.hpp>
 #include <database/idatabase.hpp>
 
+namespace Database
+{
+    // Adapter for running tasks with evaluate() or execute() as read only tasks (see IDatabaseThread::execRead())
+    struct ReadOnlyDatabase
+    {
+        IDatabase& db;
+    };
+}
+
 template<typename T>
 struct ExecutorTraits<Database::IDatabase, T>
 {
@@ -14,5 +23,14 @@ struct ExecutorTraits<Database::IDatabase, T>
     }
 };
 
+template<typename T>
+struct ExecutorTraits<Database::ReadOnlyDatabase, T>
+{
+    static void exec(Database::ReadOnlyDatabase& readOnly, T&& t)
+    {
+        readOnly.db.execRead(std::forward<T>(t));
+    }
+};
+
 
 #endif // DATABASE_EXECUTOR_TRAITS_HPP_INCLUDED
@@ -9,10 +9,15 @@ addTestTarget(database
                     backends/memory_backend/memory_backend.cpp
                     backends/sql_backends/generic_sql_query_constructor.cpp
                     backends/sql_backends/sql_filter_query_generator.cpp
+                    backends/sql_backends/sql_query_executor.cpp
                     backends/sql_backends/query_structs.cpp
+                    backends/sql_backends/table_definition.cpp
+                    backends/sql_backends/tables.cpp
                     database_tools/implementation/json_to_backend.cpp
+                    database_tools/implementation/phash_calculator.cpp
                     database_tools/implementation/photo_info_updater.cpp
                     database_tools/implementation/series_detector.cpp
+                    database_tools/implementation/similar_photos_finder.cpp
                     database_tools/implementation/tag_info_collector.cpp
                     implementation/apeople_information_accessor.cpp
                     implementation/aphoto_change_log_operator.cpp
@@ -32,9 +37,12 @@ addTestTarget(database
                     unit_tests/json_to_backend_tests.cpp
                     unit_tests/memory_backend_tests.cpp
                     unit_tests/notifications_accumulator_tests.cpp
+                    unit_tests/phash_calculator_tests.cpp
                     unit_tests/photo_info_updater_tests.cpp
                     unit_tests/sql_filter_query_generator_tests.cpp
+                    unit_tests/sql_query_executor_tests.cpp
                     unit_tests/series_detector_tests.cpp
+                    unit_tests/similar_photos_finder_tests.cpp
                     unit_tests/tag_info_collector_tests.cpp
 
                     # main()
@@ -50,7 +58,9 @@ addTestTarget(database
                     Qt::Test
                     GTest::gtest
                     GTest::gmock
-                    opencv_img_hash
+                    opencv_core
+                    opencv_imgproc
+                    opencv_img_hash                 # reference implementation for phash tests
 
                 INCLUDES
                     backends/sql_backends
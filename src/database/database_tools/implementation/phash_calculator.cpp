@@ -0,0 +1,117 @@
+#include "phash_calculator.hpp"
+
+#include <array>
+#include <bitset>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <QImageReader>
+
+
+namespace
+{
+    constexpr int DctSize = 32;
+    constexpr int HashSize = 8;
+
+    // working buffers are reused by all calculations done by a thread
+    struct Buffers
+    {
+        cv::Mat resized;
+        cv::Mat gray;
+        cv::Mat grayF;
+        cv::Mat dct;
+    };
+
+    thread_local Buffers buffers;
+
+    // wrap image data without copying it
+    cv::Mat wrap(const QImage& image, int type)
+    {
+        return cv::Mat(image.height(), image.width(), type, const_cast<uchar *>(image.constBits()), static_cast<std::size_t>(image.bytesPerLine()));
+    }
+}
+
+
+namespace PHashCalculator
+{
+    QImage load(const QString& path)
+    {
+        QImageReader reader(path);
+
+        return load(reader);
+    }
+
+
+    QImage load(QImageReader& reader)
+    {
+        // Decoding at reduced scale is faster, but decoders downscale differently than cv::resize
+        // which results in different hashes than the ones already stored in database.
+        return reader.read();
+    }
+
+
+    std::optional<Photo::PHash> calculate(const QImage& image)
+    {
+        // Steps below are the same as in cv::img_hash::PHash::compute() (opencv's contrib/modules/img_hash/src/phash.cpp)
+        // so results are identical. The difference is in input preparation:
+        // image is used directly when its format allows it, instead of converting it to ARGB32.
+        // Each of used opencv operations is vectorized.
+
+        if (image.isNull())
+            return std::nullopt;
+
+        QImage converted;
+        cv::Mat input;
+
+        switch (image.format())
+        {
+            // RGB32 has the same memory layout as ARGB32 and alpha is ignored by grayscale conversion
+            case QImage::Format_RGB32:
+            case QImage::Format_ARGB32:
+                input = wrap(image, CV_8UC4);
+                break;
+
+            // converting grayscale to ARGB32 and back to grayscale gives original values
+            case QImage::Format_Grayscale8:
+                input = wrap(image, CV_8UC1);
+                break;
+
+            default:
+                converted = image.convertToFormat(QImage::Format_ARGB32);
+                input = wrap(converted, CV_8UC4);
+                break;
+        }
+
+        cv::resize(input, buffers.resized, cv::Size(DctSize, DctSize), 0, 0, cv::INTER_LINEAR_EXACT);
+
+        if (buffers.resized.channels() > 1)
+            cv::cvtColor(buffers.resized, buffers.gray, cv::COLOR_BGRA2GRAY);
+        else
+            buffers.resized.copyTo(buffers.gray);
+
+        buffers.gray.convertTo(buffers.grayF, CV_32F);
+        cv::dct(buffers.grayF, buffers.dct);
+
+        // only low frequencies are used, without DC component
+        cv::Mat topLeftDCT;
+        buffers.dct(cv::Rect(0, 0, HashSize, HashSize)).copyTo(topLeftDCT);
+        topLeftDCT.at<float>(0, 0) = 0;
+
+        const float mean = static_cast<float>(cv::mean(topLeftDCT)[0]);
+
+        std::array<std::byte, HashSize> rawPHash;
+        const float* coefficients = topLeftDCT.ptr<float>(0);
+
+        for (int i = 0; i < HashSize; i++)
+        {
+            std::bitset<HashSize> bits;
+
+            for (int k = 0; k < HashSize; k++)
+                bits[k] = coefficients[i * HashSize + k] > mean;
+
+            rawPHash[i] = static_cast<std::byte>(bits.to_ulong());
+        }
+
+        return Photo::PHash(rawPHash);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef PHASH_CALCULATOR_HPP
+#define PHASH_CALCULATOR_HPP
+
+#include <optional>
+
+#include <QImage>
+#include <QImageReader>
+
+#include "database/photo_types.hpp"
+
+
+/**
+ * \brief pHash calculation
+ *
+ * Produces the same hashes as cv::img_hash::pHash for the same image.
+ * Images are decoded in full resolution, the only savings are skipped
+ * conversion of image data to ARGB32 and working buffers reused between calls.
+ */
+namespace PHashCalculator
+{
+    /**
+     * \brief decode image for phash calculation
+     *
+     * Image is decoded in full resolution, so calculated hashes
+     * are identical to hashes of QImage loaded from the same path.
+     */
+    QImage load(const QString& path);
+
+    /// decode image with given reader (which may have been used for reading image header already)
+    QImage load(QImageReader &);
+
+    /// calculate pHash of image. std::nullopt is returned for null images
+    std::optional<Photo::PHash> calculate(const QImage &);
+}
+
+#endif
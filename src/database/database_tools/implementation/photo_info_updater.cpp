@@ -5,9 +5,9 @@
 
 #include <memory>
 #include <ranges>
-#include <opencv2/img_hash.hpp>
 #include <QImage>
 #include <QFile>
+#include <QImageReader>
 #include <QPixmap>
 
 #include <core/function_wrappers.hpp>
@@ -20,6 +20,7 @@
 #include <core/task_executor.hpp>
 
 #include "database/general_flags.hpp"
+#include "phash_calculator.hpp"
 #include "photos_analyzer_constants.hpp"
 
 // TODO: unit tests
@@ -45,9 +46,77 @@ struct UpdaterTask: ITaskExecutor::ITask
         invokeMethod(m_updater, &PhotoInfoUpdater::apply, action);
     }
 
-    FileInformation getFileInformation(const QString& path)
+    FileInformation getFileInformation(const QString& path, QImageReader* reader = nullptr)
     {
-        return m_updater->getFileInformation(path);
+        return m_updater->getFileInformation(path, reader);
+    }
+
+    // geometry, tags and phash stages are shared by single stage tasks and MetadataCollector
+
+    void setGeometry(const FileInformation& info)
+    {
+        auto photoDelta = m_photoInfo->lock();
+        if (info.common.dimension.has_value())
+        {
+            photoDelta->insert<Photo::Field::Geometry>(info.common.dimension.value());
+            photoDelta->get<Photo::Field::Flags>()[Photo::FlagsE::GeometryLoaded] = GeometryFlagVersion;
+        }
+        else
+            apply([id = photoDelta->getId()](Database::IBackend& backend)
+            {
+                backend.setBits(id, Database::CommonGeneralFlags::State, static_cast<int>(Database::CommonGeneralFlags::StateType::Broken));
+            });
+    }
+
+    /**
+     * \brief store data read from exif
+     *
+     * Date and time tags are set only when photo does not have them yet, so user's changes are not overridden.
+     * Exif data needed for series detection is stored as general flags, so files do not need to be read again.
+     */
+    void setExifData(const FileInformation& info)
+    {
+        auto photoDelta = m_photoInfo->lock();
+        Tag::TagsList& tags = photoDelta->get<Photo::Field::Tags>();
+        const bool hasDateOrTime = tags.contains(Tag::Types::Date) || tags.contains(Tag::Types::Time);
+
+        if (hasDateOrTime == false && info.common.creationTime.has_value())
+        {
+            tags[Tag::Types::Date] = info.common.creationTime->date();
+            tags[Tag::Types::Time] = info.common.creationTime->time();
+        }
+
+        photoDelta->get<Photo::Field::Flags>()[Photo::FlagsE::ExifLoaded] = ExifFlagVersion;
+
+        const ImageFile* image = std::get_if<ImageFile>(&info.details);
+
+        if (image != nullptr && (image->sequenceNumber.has_value() || image->exposure.has_value()))
+            apply([id = photoDelta->getId(), sequence = image->sequenceNumber, exposure = image->exposure](Database::IBackend& backend)
+            {
+                if (sequence.has_value())
+                    backend.set(id, Database::CommonGeneralFlags::ExifSequenceNumber, *sequence);
+
+                if (exposure.has_value())
+                    backend.set(id, Database::CommonGeneralFlags::ExifExposure, static_cast<int>(*exposure * 100));
+            });
+    }
+
+    void setPHash(const QImage& image)
+    {
+        const std::optional<Photo::PHash> phash = PHashCalculator::calculate(image);
+
+        if (phash.has_value())
+            m_photoInfo->lock()->insert<Photo::Field::PHash>(*phash);
+        else
+            apply([id = m_photoInfo->lock()->getId()](Database::IBackend& backend)
+            {
+                backend.setBits(id, Database::CommonGeneralFlags::PHashState, static_cast<int>(Database::CommonGeneralFlags::PHashStateType::Incomaptible));
+            });
+    }
+
+    Priority priority() const override
+    {
+        return Priority::Background;
     }
 
     UpdaterTask(const UpdaterTask &) = delete;
@@ -82,17 +151,7 @@ namespace
             const QString path = m_photoInfo->lock()->get<Photo::Field::Path>();
             const FileInformation info = getFileInformation(path);
 
-            auto photoDelta = m_photoInfo->lock();
-            if (info.common.dimension.has_value())
-            {
-                photoDelta->insert<Photo::Field::Geometry>(info.common.dimension.value());
-                photoDelta->get<Photo::Field::Flags>()[Photo::FlagsE::GeometryLoaded] = GeometryFlagVersion;
-            }
-            else
-                apply([id = photoDelta->getId()](Database::IBackend& backend)
-                {
-                    backend.setBits(id, Database::CommonGeneralFlags::State, static_cast<int>(Database::CommonGeneralFlags::StateType::Broken));
-                });
+            setGeometry(info);
         }
     };
 
@@ -115,43 +174,17 @@ namespace
 
         void perform() override
         {
-            // make sure we want to update
-            QString path;
-            {
-                auto lockedPhoto = m_photoInfo->lock();
-                const auto tags = lockedPhoto->get<Photo::Field::Tags>();
-                path = lockedPhoto->get<Photo::Field::Path>();
-
-                // If media already has date or time update, do not override it.
-                // Just update ExifLoaded flag. It could be set to previous version, so bump it
-                if (tags.contains(Tag::Types::Date) || tags.contains(Tag::Types::Time))
-                {
-                    lockedPhoto->get<Photo::Field::Flags>()[Photo::FlagsE::ExifLoaded] = ExifFlagVersion;
-                    return;
-                }
-            }
-
-            // collect data
+            const QString path = m_photoInfo->lock()->get<Photo::Field::Path>();
             const FileInformation info = getFileInformation(path);
 
-            // lock photo again (we do not need to keep resource unavailable during 'getFileInformation')
-            auto photoDelta = m_photoInfo->lock();
-            if (info.common.creationTime.has_value())
-            {
-                Tag::TagsList& tags = photoDelta->get<Photo::Field::Tags>();
-
-                tags[Tag::Types::Date] = info.common.creationTime->date();
-                tags[Tag::Types::Time] = info.common.creationTime->time();
-            }
-
-            photoDelta->get<Photo::Field::Flags>()[Photo::FlagsE::ExifLoaded] = ExifFlagVersion;
+            setExifData(info);
         }
     };
 
 
-    struct PHashCalculator: UpdaterTask
+    struct PHashAssigner: UpdaterTask
     {
-        PHashCalculator(PhotoInfoUpdater* updater, const Photo::SharedDataDelta& photoInfo)
+        PHashAssigner(PhotoInfoUpdater* updater, const Photo::SharedDataDelta& photoInfo)
             : UpdaterTask(updater, photoInfo)
         {
 
@@ -164,53 +197,60 @@ namespace
 
         void perform() override
         {
-            // based on:
-            // https://docs.opencv.org/3.4/d4/d93/group__img__hash.html
-
             const QString path = m_photoInfo->lock()->get<Photo::Field::Path>();
 
             // NOTE: cv::imread could be used here, however it would be better to have a unique mechanism
             // of reading images, so if an image can be displayed in gui, then we also know how to
             // read and phash it here.
-            QImage image(path);
-
-            if (image.isNull())
-                apply([id = m_photoInfo->lock()->getId()](Database::IBackend& backend)
-                {
-                    backend.setBits(id, Database::CommonGeneralFlags::PHashState, static_cast<int>(Database::CommonGeneralFlags::PHashStateType::Incomaptible));
-                });
-            else
+            setPHash(PHashCalculator::load(path));
+        }
+    };
+
+
+    /**
+     * \brief all stages of photo analysis in one task
+     *
+     * Media information (geometry, exif) is read once and image is decoded once
+     * (in full resolution, see PHashCalculator::load()) for all requested stages. Image header and image data are read with the same reader.
+     * Exif is still read separately, by exif reader.
+     */
+    struct MetadataCollector: UpdaterTask
+    {
+        MetadataCollector(PhotoInfoUpdater* updater, const Photo::SharedDataDelta& photoInfo, const PhotoInfoUpdater::Stages& stages)
+            : UpdaterTask(updater, photoInfo)
+            , m_stages(stages)
+        {
+
+        }
+
+        std::string name() const override
+        {
+            return "Photo metadata collector";
+        }
+
+        void perform() override
+        {
+            const QString path = m_photoInfo->lock()->get<Photo::Field::Path>();
+            QImageReader reader(path);
+
+            if (m_stages.geometry || m_stages.tags)
             {
-                if (image.format() != QImage::Format_ARGB32)
-                    image = image.convertToFormat(QImage::Format_ARGB32);
-
-                const cv::Mat cvImage(
-                    image.height(),
-                    image.width(),
-                    CV_8UC4,
-                    image.bits(),
-                    static_cast<std::size_t>(image.bytesPerLine())
-                );
-
-                cv::Mat phashMat;
-                cv::img_hash::pHash(cvImage, phashMat);
-
-                constexpr int DataSize = 8;
-                assert( phashMat.rows == 1);
-                assert( phashMat.cols == DataSize);
-
-                const auto count = phashMat.dataend - phashMat.datastart;
-
-                if (count == DataSize)
-                {
-                    std::array<std::byte, DataSize> rawPHash;
-                    std::memcpy(rawPHash.data(), phashMat.datastart, DataSize);
-
-                    Photo::PHash phash(rawPHash);
-                    m_photoInfo->lock()->insert<Photo::Field::PHash>(phash);
-                }
+                const FileInformation info = getFileInformation(path, &reader);
+
+                if (m_stages.geometry)
+                    setGeometry(info);
+
+                if (m_stages.tags)
+                    setExifData(info);
+            }
+
+            if (m_stages.pHash)
+            {
+                setPHash(PHashCalculator::load(reader));
             }
         }
+
+        const PhotoInfoUpdater::Stages m_stages;
     };
 }
 
@@ -250,7 +290,15 @@ void PhotoInfoUpdater::updateTags(const Photo::SharedDataDelta& photoInfo)
 
 void PhotoInfoUpdater::updatePHash(const Photo::SharedDataDelta& photoInfo)
 {
-    auto task = std::make_unique<PHashCalculator>(this, photoInfo);
+    auto task = std::make_unique<PHashAssigner>(this, photoInfo);
+
+    addTask(std::move(task));
+}
+
+
+void PhotoInfoUpdater::updateMetadata(const Photo::SharedDataDelta& photoInfo, const Stages& stages)
+{
+    auto task = std::make_unique<MetadataCollector>(this, photoInfo, stages);
 
     addTask(std::move(task));
 }
@@ -268,17 +316,23 @@ void PhotoInfoUpdater::apply(std::function<void(Database::IBackend &)> action)
 }
 
 
-FileInformation PhotoInfoUpdater::getFileInformation(const QString& path)
+FileInformation PhotoInfoUpdater::getFileInformation(const QString& path, QImageReader* reader)
 {
-    std::lock_guard _(m_fileInfosMutex);
-
-    FileInformation* info = m_fileInfos.object(path);
-    if (info == nullptr)
     {
-        auto fetchedInfo = std::make_unique<FileInformation>(m_mediaInformation.getInformation(path));
-        info = fetchedInfo.get();
-        m_fileInfos.insert(path, fetchedInfo.release());
+        std::lock_guard _(m_fileInfosMutex);
+
+        const FileInformation* info = m_fileInfos.object(path);
+        if (info != nullptr)
+            return *info;
     }
 
-    return *info;
+    // do not block other tasks while reading file
+    const FileInformation info = reader == nullptr?
+        m_mediaInformation.getInformation(path):
+        m_mediaInformation.getInformation(path, *reader);
+
+    std::lock_guard _(m_fileInfosMutex);
+    m_fileInfos.insert(path, new FileInformation(info));
+
+    return info;
 }
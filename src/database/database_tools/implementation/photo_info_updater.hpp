@@ -30,6 +30,16 @@ class PhotoInfoUpdater final: public QObject
         void updateTags(const Photo::SharedDataDelta &);
         void updatePHash(const Photo::SharedDataDelta &);
 
+        struct Stages
+        {
+            bool geometry = false;
+            bool tags = false;
+            bool pHash = false;
+        };
+
+        /// perform all requested stages in one task, reading file only once
+        void updateMetadata(const Photo::SharedDataDelta &, const Stages &);
+
     private:
         friend struct UpdaterTask;
 
@@ -43,7 +53,7 @@ class PhotoInfoUpdater final: public QObject
 
         void addTask(std::unique_ptr<UpdaterTask>);
         void apply(std::function<void(Database::IBackend &)>);
-        FileInformation getFileInformation(const QString &);
+        FileInformation getFileInformation(const QString &, QImageReader* = nullptr);
 };
 
 #endif
@@ -134,15 +134,9 @@ void PhotosAnalyzerImpl::addPhotos(const std::vector<Photo::Id>& ids)
                 const std::vector<Photo::DataDelta> photoData =
                     evaluate<std::vector<Photo::DataDelta>(Database::IBackend &)>(m_database, [first, last](Database::IBackend& backend)
                 {
-                    std::vector<Photo::DataDelta> photos;
-                    photos.reserve(static_cast<unsigned>(last - first));
+                    const std::vector<Photo::Id> chunk(first, last);
 
-                    std::transform(first, last, std::back_inserter(photos), [&backend](const Photo::Id& id) mutable
-                    {
-                        return backend.getPhotoDelta(id, {Photo::Field::Flags, Photo::Field::Path, Photo::Field::Tags});
-                    });
-
-                    return photos;
+                    return backend.getPhotoDeltas(chunk, {Photo::Field::Flags, Photo::Field::Path, Photo::Field::Tags});
                 });
 
                 invokeMethod(this, &PhotosAnalyzerImpl::updatePhotos, photoData);
@@ -160,6 +154,7 @@ void PhotosAnalyzerImpl::addPhotos(const std::vector<Photo::Id>& ids)
 
         loadTask->finished();
     },
+    ITaskExecutor::Priority::Background,
     "PhotosAnalyzerImpl: fetching photo details"
     );
 }
@@ -173,14 +168,14 @@ void PhotosAnalyzerImpl::updatePhotos(const std::vector<Photo::DataDelta>& photo
         Photo::SharedDataDelta sharedDataDelta(new Photo::SafeDataDelta(photo), storage);
         m_totalTasks++;
 
-        if (photo.get<Photo::Field::Flags>().at(Photo::FlagsE::GeometryLoaded) < GeometryFlagVersion)
-            m_updater.updateGeometry(sharedDataDelta);
-
-        if (photo.get<Photo::Field::Flags>().at(Photo::FlagsE::ExifLoaded) < ExifFlagVersion)
-            m_updater.updateTags(sharedDataDelta);
+        PhotoInfoUpdater::Stages stages;
+        stages.geometry = photo.get<Photo::Field::Flags>().at(Photo::FlagsE::GeometryLoaded) < GeometryFlagVersion;
+        stages.tags = photo.get<Photo::Field::Flags>().at(Photo::FlagsE::ExifLoaded) < ExifFlagVersion;
+        stages.pHash = photo.has(Photo::Field::PHash) == false;
 
-        if (photo.has(Photo::Field::PHash) == false)
-            m_updater.updatePHash(sharedDataDelta);
+        // run all stages in one task, so file is read only once
+        if (stages.geometry || stages.tags || stages.pHash)
+            m_updater.updateMetadata(sharedDataDelta, stages);
     }
 
     refreshView();
@@ -4,7 +4,7 @@
 
 namespace PhotosAnalyzerConsts
 {
-    const int ExifFlagVersion = 2;
+    const int ExifFlagVersion = 3;           // 3: exif data for series detection is stored as general flags
     const int GeometryFlagVersion = 1;
 }
 
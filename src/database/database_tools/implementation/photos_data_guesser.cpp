@@ -164,9 +164,10 @@ void PhotosDataGuesser::processIds(Database::IBackend& backend, const std::vecto
 
     std::vector<CollectedData> photos;
 
-    for(const Photo::Id& id: ids)
+    const auto photosData = backend.getPhotoDeltas(ids, {Photo::Field::Path});
+
+    for(const Photo::DataDelta& photoData: photosData)
     {
-        const Photo::DataDelta photoData = backend.getPhotoDelta(id, {Photo::Field::Path});
         const auto tags = extractor.extract(photoData.get<Photo::Field::Path>());
 
         if (tags.empty() == false)
@@ -17,6 +17,10 @@
  */
 
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <QDateTime>
 
@@ -26,14 +30,24 @@
 #include <core/tags_utils.hpp>
 #include <ibackend.hpp>
 #include <iphoto_operator.hpp>
+#include <general_flags.hpp>
 
 #include "database_executor_traits.hpp"
 #include "../series_detector.hpp"
 #include "photo_utils.hpp"
+#include "photos_analyzer_constants.hpp"
 
 namespace
 {
 
+    struct ExifData
+    {
+        std::optional<int> sequenceNumber;
+        std::optional<int> exposure;            // centi-exposure
+    };
+
+    using ExifDataMap = std::unordered_map<Photo::Id, ExifData, Photo::IdHash>;
+
     int readExposure(const std::any& exposure)
     {
         const float exp = std::any_cast<float>(exposure);
@@ -41,6 +55,73 @@ namespace
         return static_cast<int>(exp * 100);   // convert original exposure to centi-exposure
     }
 
+    const ExifData& exifDataFor(const ExifDataMap& exifData, const Photo::DataDelta& d)
+    {
+        static const ExifData empty;
+        auto it = exifData.find(d.getId());
+
+        return it == exifData.end()? empty: it->second;
+    }
+
+    // Collect exif data of photos.
+    // Photos analyzed with current version of PhotosAnalyzer have it stored in database.
+    // For others exif is read from files.
+    ExifDataMap loadExifData(Database::IDatabase& db, IExifReader& exifReader, const std::deque<Photo::DataDelta>& photos)
+    {
+        ExifDataMap exifData;
+        std::vector<const Photo::DataDelta *> notAnalyzed;
+
+        Database::ReadOnlyDatabase roDb{db};
+        const auto [sequenceNumbers, exposures] =
+            evaluate<std::pair<std::map<Photo::Id, int>, std::map<Photo::Id, int>>(Database::IBackend &)>(roDb, [](Database::IBackend& backend)
+        {
+            return std::pair(backend.getFlagValues(Database::CommonGeneralFlags::ExifSequenceNumber),
+                             backend.getFlagValues(Database::CommonGeneralFlags::ExifExposure));
+        });
+
+        for (const auto& photo: photos)
+        {
+            const bool analyzed = photo.has(Photo::Field::Flags) && [&photo]()
+            {
+                const auto& flags = photo.get<Photo::Field::Flags>();
+                const auto exifLoaded = flags.find(Photo::FlagsE::ExifLoaded);
+
+                return exifLoaded != flags.end() && exifLoaded->second >= PhotosAnalyzerConsts::ExifFlagVersion;
+            }();
+
+            if (analyzed)
+            {
+                ExifData& data = exifData[photo.getId()];
+
+                auto sIt = sequenceNumbers.find(photo.getId());
+                if (sIt != sequenceNumbers.end())
+                    data.sequenceNumber = sIt->second;
+
+                auto eIt = exposures.find(photo.getId());
+                if (eIt != exposures.end())
+                    data.exposure = eIt->second;
+            }
+            else
+                notAnalyzed.push_back(&photo);
+        }
+
+        for (const Photo::DataDelta* photo: notAnalyzed)
+        {
+            const QString& path = photo->get<Photo::Field::Path>();
+            ExifData& data = exifData[photo->getId()];
+
+            const auto sequence = exifReader.get(path, IExifReader::TagType::SequenceNumber);
+            if (sequence)
+                data.sequenceNumber = std::any_cast<int>(*sequence);
+
+            const auto exposure = exifReader.get(path, IExifReader::TagType::Exposure);
+            if (exposure)
+                data.exposure = readExposure(*exposure);
+        }
+
+        return exifData;
+    }
+
     class IGroupValidator
     {
     public:
@@ -55,15 +136,15 @@ namespace
     class GroupValidator_ExifBasedSeries: public IGroupValidator
     {
     public:
-        GroupValidator_ExifBasedSeries(IExifReader& exif, const SeriesDetector::Rules &)
-            : m_exifReader(exif)
+        GroupValidator_ExifBasedSeries(const ExifDataMap& exifData, const SeriesDetector::Rules &)
+            : m_exifData(exifData)
         {
 
         }
 
         void setCurrentPhoto(const Photo::DataDelta& d) override
         {
-            m_sequence = m_exifReader.get(d.get<Photo::Field::Path>(), IExifReader::TagType::SequenceNumber);
+            m_sequence = exifDataFor(m_exifData, d).sequenceNumber;
         }
 
         bool canBePartOfGroup() const override
@@ -72,7 +153,7 @@ namespace
 
             if (has_exif_data)
             {
-                const int s = std::any_cast<int>(m_sequence.value());
+                const int s = m_sequence.value();
                 auto s_it = m_sequence_numbers.find(s);
 
                 return s_it == m_sequence_numbers.end();
@@ -85,7 +166,7 @@ namespace
         {
             assert(m_sequence);
 
-            const int s = std::any_cast<int>(m_sequence.value());
+            const int s = m_sequence.value();
 
             m_sequence_numbers.insert(s);
         }
@@ -101,9 +182,9 @@ namespace
             return GroupCandidate::Type::Series;
         }
 
-        std::optional<std::any> m_sequence;
+        std::optional<int> m_sequence;
         std::unordered_set<int> m_sequence_numbers;
-        IExifReader& m_exifReader;
+        const ExifDataMap& m_exifData;
     };
 
 
@@ -173,8 +254,8 @@ namespace
         typedef GroupValidator_ExifBasedSeries Base;
 
     public:
-        GroupValidator_HDR(IExifReader& exif, const SeriesDetector::Rules& r)
-            : Base(exif, r)
+        GroupValidator_HDR(const ExifDataMap& exifData, const SeriesDetector::Rules& r)
+            : Base(exifData, r)
         {
 
         }
@@ -182,7 +263,7 @@ namespace
         void setCurrentPhoto(const Photo::DataDelta& d) override
         {
             Base::setCurrentPhoto(d);
-            m_exposure = m_exifReader.get(d.get<Photo::Field::Path>(), IExifReader::TagType::Exposure);
+            m_exposure = exifDataFor(m_exifData, d).exposure;
         }
 
         bool canBePartOfGroup() const override
@@ -191,7 +272,7 @@ namespace
 
             if (has_exif_data)
             {
-                const int e = readExposure(m_exposure.value());
+                const int e = m_exposure.value();
 
                 auto e_it = m_exposures.find(e);
 
@@ -207,7 +288,7 @@ namespace
 
             Base::accept();
 
-            const int e = readExposure(m_exposure.value());
+            const int e = m_exposure.value();
             m_exposures.insert(e);
         }
 
@@ -223,7 +304,7 @@ namespace
             return GroupCandidate::Type::HDR;
         }
 
-        std::optional<std::any> m_exposure;
+        std::optional<int> m_exposure;
         std::unordered_set<int> m_exposures;
     };
 
@@ -267,24 +348,29 @@ namespace
         const SeriesDetector::Rules& m_rules;
     };
 
+    // photos detected as group. Members' data is fetched later, in one batch for many groups
+    struct DetectedGroup
+    {
+        GroupCandidate::Type type;
+        std::vector<Photo::Id> members;
+    };
+
     class SeriesExtractor
     {
     public:
-        SeriesExtractor(Database::IDatabase& db,
-                        const std::deque<Photo::DataDelta>& photos,
-                        std::unique_ptr<ILogger> logger,
+        SeriesExtractor(const std::deque<Photo::DataDelta>& photos,
+                        ILogger& logger,
                         const QPromise<std::vector<GroupCandidate>>* p)
-            : m_db(db)
-            , m_photos(photos)
-            , m_logger(std::move(logger))
+            : m_photos(photos)
+            , m_logger(logger)
             , m_promise(p)
         {
 
         }
 
-        std::vector<GroupCandidate> extract( IGroupValidator& validator)
+        std::vector<DetectedGroup> extract(IGroupValidator& validator)
         {
-            std::vector<GroupCandidate> results;
+            std::vector<DetectedGroup> results;
 
             for (auto it = m_photos.begin(); it != m_photos.end();)
             {
@@ -314,23 +400,11 @@ namespace
 
                 if (membersCount > 1)
                 {
-                    GroupCandidate group;
-                    group.type = validator.type();
-
                     QStringList ids;
                     std::transform(members.begin(), members.end(), std::back_inserter(ids), [](const auto& id){ return QString::number(id.value()); });
-                    m_logger->trace(QString("Detected series of %1 photos: %2").arg(membersCount).arg(ids.join(", ")));
+                    m_logger.trace(QString("Detected series of %1 photos: %2").arg(membersCount).arg(ids.join(", ")));
 
-                    // Id to Data  TODO: this can be done in background
-                    std::transform(members.begin(), members.end(), std::back_inserter(group.members), [this](const Photo::Id& id)
-                    {
-                        return evaluate<Photo::DataDelta(Database::IBackend &)>(m_db, [id](Database::IBackend& backend)
-                        {
-                            return backend.getPhotoDelta(id, {Photo::Field::Path, Photo::Field::Flags, Photo::Field::GroupInfo});
-                        });
-                    });
-
-                    results.push_back(group);
+                    results.push_back({validator.type(), std::move(members)});
 
                     auto first = it;
                     auto last = first + membersCount;
@@ -345,11 +419,142 @@ namespace
         }
 
     private:
-        Database::IDatabase& m_db;
         std::deque<Photo::DataDelta> m_photos;
-        std::unique_ptr<ILogger> m_logger;
+        ILogger& m_logger;
         const QPromise<std::vector<GroupCandidate>>* m_promise;
     };
+
+
+    // Split photos (sorted by timestamp) into windows separated by gaps longer than manualSeriesMaxGap.
+    // Groups never cross such a gap, so windows can be analyzed independently.
+    // Windows are then packed into chunks of reasonable size to limit number of tasks and database queries.
+    std::vector<std::vector<std::deque<Photo::DataDelta>>> splitIntoChunks(const std::deque<Photo::DataDelta>& photos, const SeriesDetector::Rules& rules)
+    {
+        const std::size_t chunkSize = 200;
+
+        std::vector<std::vector<std::deque<Photo::DataDelta>>> chunks;
+        std::vector<std::deque<Photo::DataDelta>> chunk;
+        std::deque<Photo::DataDelta> window;
+        std::size_t photosInChunk = 0;
+        std::chrono::milliseconds previousTimestamp(0);
+
+        auto closeWindow = [&]()
+        {
+            if (window.size() > 1)
+            {
+                photosInChunk += window.size();
+                chunk.push_back(std::move(window));
+
+                if (photosInChunk >= chunkSize)
+                {
+                    chunks.push_back(std::move(chunk));
+                    chunk.clear();
+                    photosInChunk = 0;
+                }
+            }
+
+            window.clear();
+        };
+
+        for (const auto& photo: photos)
+        {
+            const auto timestamp = Tag::timestamp(photo.get<Photo::Field::Tags>());
+
+            if (window.empty() == false && timestamp - previousTimestamp > rules.manualSeriesMaxGap)
+                closeWindow();
+
+            window.push_back(photo);
+            previousTimestamp = timestamp;
+        }
+
+        closeWindow();
+
+        if (chunk.empty() == false)
+            chunks.push_back(std::move(chunk));
+
+        return chunks;
+    }
+
+
+    std::vector<GroupCandidate> materialize(Database::IDatabase& db, const std::vector<DetectedGroup>& groups)
+    {
+        std::vector<Photo::Id> ids;
+        for (const auto& group: groups)
+            std::ranges::copy(group.members, std::back_inserter(ids));
+
+        Database::ReadOnlyDatabase roDb{db};
+        const auto deltas = evaluate<std::vector<Photo::DataDelta>(Database::IBackend &)>(roDb, [&ids](Database::IBackend& backend)
+        {
+            return backend.getPhotoDeltas(ids, {Photo::Field::Path, Photo::Field::Flags, Photo::Field::GroupInfo});
+        });
+
+        std::unordered_map<Photo::Id, const Photo::DataDelta *, Photo::IdHash> deltaForId;
+        for (const auto& delta: deltas)
+            deltaForId.emplace(delta.getId(), &delta);
+
+        std::vector<GroupCandidate> candidates;
+        candidates.reserve(groups.size());
+
+        for (const auto& group: groups)
+        {
+            GroupCandidate candidate;
+            candidate.type = group.type;
+
+            for (const Photo::Id& id: group.members)
+            {
+                // photo could have been removed in the meantime
+                const auto it = deltaForId.find(id);
+                if (it != deltaForId.end())
+                    candidate.members.push_back(*it->second);
+            }
+
+            if (candidate.members.size() > 1)
+                candidates.push_back(std::move(candidate));
+        }
+
+        return candidates;
+    }
+
+
+    std::vector<DetectedGroup> analyzeWindow(const std::deque<Photo::DataDelta>& window,
+                                             const ExifDataMap& exifData,
+                                             const SeriesDetector::Rules& rules,
+                                             ILogger& logger,
+                                             const QPromise<std::vector<GroupCandidate>>* promise)
+    {
+        SeriesExtractor extractor(window, logger, promise);
+        std::vector<DetectedGroup> groups;
+
+        GroupValidator_HDR hdrValidator(exifData, rules);
+        std::ranges::move(extractor.extract(hdrValidator), std::back_inserter(groups));
+
+        GroupValidator_ExifBasedSeries animationsValidator(exifData, rules);
+        std::ranges::move(extractor.extract(animationsValidator), std::back_inserter(groups));
+
+        GroupValidator_FileNameBasedSeries fileNameValidator;
+        std::ranges::move(extractor.extract(fileNameValidator), std::back_inserter(groups));
+
+        if (rules.detectTimeNeighbors)
+        {
+            GroupValidator_Generic genericValidator(rules);
+            std::ranges::move(extractor.extract(genericValidator), std::back_inserter(groups));
+        }
+
+        return groups;
+    }
+
+
+    // state shared between threads working on chunks.
+    // Kept alive by helper tasks, which may start after all chunks were processed.
+    struct ChunksProcessing
+    {
+        std::vector<std::vector<std::deque<Photo::DataDelta>>> chunks;
+        std::vector<std::vector<GroupCandidate>> results;
+        std::atomic<std::size_t> nextChunk = 0;
+        std::size_t processedChunks = 0;
+        std::mutex mutex;
+        std::condition_variable chunkProcessed;
+    };
 }
 
 
@@ -361,11 +566,12 @@ SeriesDetector::Rules::Rules(std::chrono::milliseconds gap, bool neighbours)
 }
 
 
-SeriesDetector::SeriesDetector(ILogger& logger, Database::IDatabase& db, IExifReader& exif, const QPromise<std::vector<GroupCandidate>>* p)
+SeriesDetector::SeriesDetector(ILogger& logger, Database::IDatabase& db, IExifReader& exif, ITaskExecutor* executor, QPromise<std::vector<GroupCandidate>>* p)
     : m_logger(logger)
     , m_db(db)
     , m_promise(p)
     , m_exifReader(exif)
+    , m_executor(executor)
 {
 
 }
@@ -376,8 +582,10 @@ std::vector<GroupCandidate> SeriesDetector::listCandidates(const Rules& rules) c
     QElapsedTimer timer;
     timer.start();
 
+    Database::ReadOnlyDatabase db{m_db};
+
     const std::deque<Photo::DataDelta> candidates =
-        evaluate<std::deque<Photo::DataDelta>(Database::IBackend &)>(m_db, [](Database::IBackend& backend)
+        evaluate<std::deque<Photo::DataDelta>(Database::IBackend &)>(db, [](Database::IBackend& backend)
     {
         std::vector<GroupCandidate> result;
 
@@ -390,13 +598,9 @@ std::vector<GroupCandidate> SeriesDetector::listCandidates(const Rules& rules) c
         // photos - candidates for series/groups
         const auto photos = backend.photoOperator().onPhotos( Database::GroupFilter{group_filter, valid_photos_filter}, Database::Actions::Sort(Database::Actions::Sort::By::Timestamp) );
 
-        std::deque<Photo::DataDelta> deltas;
-        std::ranges::transform(photos, std::back_inserter(deltas), [&backend](const Photo::Id& id)
-        {
-            return backend.getPhotoDelta(id, {Photo::Field::Tags, Photo::Field::Path});
-        });
+        const auto photosData = backend.getPhotoDeltas(photos, {Photo::Field::Tags, Photo::Field::Path, Photo::Field::Flags});
 
-        return deltas;
+        return std::deque<Photo::DataDelta>(photosData.begin(), photosData.end());
     });
 
     const QString log = QString("Collecting photos for grouping took %1s").arg(timer.elapsed() / 1000);
@@ -428,44 +632,84 @@ std::vector<GroupCandidate> SeriesDetector::analyzePhotos(const std::deque<Photo
         .arg(timer.elapsed() / 1000)
         .arg(prefiltered.size()));
 
-    try
-    {
-        SeriesExtractor extractor(m_db, prefiltered, m_logger.subLogger("SeriesExtractor"), m_promise);
-        std::vector<GroupCandidate> sequences;
-
-        timer.restart();
-        GroupValidator_HDR hdrValidator(m_exifReader, rules);
-        const auto hdrs = extractor.extract(hdrValidator);
-        std::ranges::copy(hdrs, std::back_inserter(sequences));
-        m_logger.debug(QString("HDRs extraction took: %1s").arg(timer.elapsed() / 1000));
-
-        timer.restart();
-        GroupValidator_ExifBasedSeries animationsValidator(m_exifReader, rules);
-        const auto exifSeries = extractor.extract(animationsValidator);
-        std::ranges::copy(exifSeries, std::back_inserter(sequences));
-        m_logger.debug(QString("Exif based series extraction took: %1s").arg(timer.elapsed() / 1000));
-
-        timer.restart();
-        GroupValidator_FileNameBasedSeries fileNameValidator;
-        const auto fileNameSeries = extractor.extract(fileNameValidator);
-        std::ranges::copy(fileNameSeries, std::back_inserter(sequences));
-        m_logger.debug(QString("Filename based series extraction took: %1s").arg(timer.elapsed() / 1000));
+    timer.restart();
+    const ExifDataMap exifData = loadExifData(m_db, m_exifReader, prefiltered);
 
-        if (rules.detectTimeNeighbors)
+    m_logger.debug(QString("Collecting exif data took %1s").arg(timer.elapsed() / 1000));
+
+    timer.restart();
+    auto processing = std::make_shared<ChunksProcessing>();
+    processing->chunks = splitIntoChunks(prefiltered, rules);
+    processing->results.resize(processing->chunks.size());
+
+    const std::size_t chunksCount = processing->chunks.size();
+    const std::shared_ptr<ILogger> extractorLogger = m_logger.subLogger("SeriesExtractor");
+
+    // Analyze chunks until there are none left.
+    // Captured references are valid as long as there are chunks to process.
+    auto worker = [this, processing, &exifData, &rules, extractorLogger]()
+    {
+        for (std::size_t i = processing->nextChunk++; i < processing->chunks.size(); i = processing->nextChunk++)
         {
-            timer.restart();
-            GroupValidator_Generic genericValidator(rules);
-            const auto generics = extractor.extract(genericValidator);
-            std::ranges::copy(generics, std::back_inserter(sequences));
-            m_logger.debug(QString("Generic groups extraction took: %1s").arg(timer.elapsed() / 1000));
+            std::vector<GroupCandidate> candidates;
+
+            try
+            {
+                std::vector<DetectedGroup> groups;
+
+                for (const auto& window: processing->chunks[i])
+                    std::ranges::move(analyzeWindow(window, exifData, rules, *extractorLogger, m_promise), std::back_inserter(groups));
+
+                if (groups.empty() == false)
+                    candidates = materialize(m_db, groups);
+            }
+            catch (const abort_exception &)
+            {
+
+            }
+
+            {
+                std::lock_guard lock(processing->mutex);
+
+                if (m_promise && candidates.empty() == false)
+                    m_promise->addResult(candidates);
+
+                processing->results[i] = std::move(candidates);
+                processing->processedChunks++;
+            }
+
+            processing->chunkProcessed.notify_all();
         }
+    };
+
+    // Helpers may not start immediately when executor is busy.
+    // Current thread works on chunks too, so progress is guaranteed.
+    if (m_executor)
+    {
+        const std::size_t helpers = std::min<std::size_t>(std::max(m_executor->heavyWorkers() - 1, 0), chunksCount > 0? chunksCount - 1: 0);
 
-        return sequences;
+        for (std::size_t i = 0; i < helpers; i++)
+            runOn(*m_executor, worker, "SeriesDetector: chunk analysis");
     }
-    catch (const abort_exception &)
+
+    worker();
+
+    std::unique_lock lock(processing->mutex);
+    processing->chunkProcessed.wait(lock, [&processing, chunksCount]()
     {
+        return processing->processedChunks == chunksCount;
+    });
+
+    m_logger.debug(QString("Groups extraction from %1 chunks took: %2s").arg(chunksCount).arg(timer.elapsed() / 1000));
+
+    if (m_promise && m_promise->isCanceled())
         return {};
-    }
+
+    std::vector<GroupCandidate> sequences;
+    for (auto& result: processing->results)
+        std::ranges::move(result, std::back_inserter(sequences));
+
+    return sequences;
 }
 
 
@@ -0,0 +1,193 @@
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include "../similar_photos_finder.hpp"
+
+
+namespace
+{
+    class DisjointSets
+    {
+        public:
+            explicit DisjointSets(std::size_t size)
+                : m_parent(size)
+            {
+                std::iota(m_parent.begin(), m_parent.end(), 0);
+            }
+
+            std::size_t find(std::size_t element)
+            {
+                while (m_parent[element] != element)
+                {
+                    m_parent[element] = m_parent[m_parent[element]];
+                    element = m_parent[element];
+                }
+
+                return element;
+            }
+
+            void unite(std::size_t lhs, std::size_t rhs)
+            {
+                const std::size_t lhsRoot = find(lhs);
+                const std::size_t rhsRoot = find(rhs);
+
+                // keep smaller index as a root, so roots point to lowest hashes
+                if (lhsRoot < rhsRoot)
+                    m_parent[rhsRoot] = lhsRoot;
+                else if (rhsRoot < lhsRoot)
+                    m_parent[lhsRoot] = rhsRoot;
+            }
+
+        private:
+            std::vector<std::size_t> m_parent;
+    };
+
+    constexpr int HashBits = 64;
+
+    std::uint64_t toBits(const Photo::PHash& hash)
+    {
+        return static_cast<std::uint64_t>(hash.value());
+    }
+
+    void uniteSimilar(const std::vector<std::uint64_t>& hashes, int maxDistance, DisjointSets& sets)
+    {
+        // pigeonhole principle: when hashes are split into maxDistance/2 + 1 blocks,
+        // two hashes within maxDistance need to have at least one block differing on at most one bit
+        const int blocks = maxDistance / 2 + 1;
+
+        typedef std::vector<std::pair<std::uint64_t, std::size_t>> Keys;
+        Keys keys(hashes.size());
+
+        auto compare = [&hashes, &sets, maxDistance](Keys::const_iterator lhs, Keys::const_iterator rhs)
+        {
+            if (std::popcount(hashes[lhs->second] ^ hashes[rhs->second]) <= maxDistance)
+                sets.unite(lhs->second, rhs->second);
+        };
+
+        for (int block = 0; block < blocks; block++)
+        {
+            const int offset = block * HashBits / blocks;
+            const int length = (block + 1) * HashBits / blocks - offset;
+            const std::uint64_t mask = length == HashBits? ~std::uint64_t(0): (std::uint64_t(1) << length) - 1;
+
+            for (std::size_t i = 0; i < hashes.size(); i++)
+                keys[i] = std::pair((hashes[i] >> offset) & mask, i);
+
+            std::sort(keys.begin(), keys.end());
+
+            // ranges of hashes sharing block value
+            std::unordered_map<std::uint64_t, std::pair<Keys::const_iterator, Keys::const_iterator>> ranges;
+            ranges.reserve(keys.size());
+
+            for (auto first = keys.cbegin(); first != keys.cend();)
+            {
+                const auto last = std::find_if(first, keys.cend(), [key = first->first](const auto& entry)
+                {
+                    return entry.first != key;
+                });
+
+                ranges.emplace(first->first, std::pair(first, last));
+                first = last;
+            }
+
+            for (const auto& [key, range]: ranges)
+            {
+                // hashes with equal block
+                for (auto lhs = range.first; lhs != range.second; ++lhs)
+                    for (auto rhs = std::next(lhs); rhs != range.second; ++rhs)
+                        compare(lhs, rhs);
+
+                // hashes with block differing on one bit. Visit each pair of ranges once.
+                for (int bit = 0; bit < length; bit++)
+                {
+                    const std::uint64_t neighbour = key ^ (std::uint64_t(1) << bit);
+
+                    if (neighbour < key)
+                        continue;
+
+                    const auto neighbourIt = ranges.find(neighbour);
+
+                    if (neighbourIt != ranges.end())
+                        for (auto lhs = range.first; lhs != range.second; ++lhs)
+                            for (auto rhs = neighbourIt->second.first; rhs != neighbourIt->second.second; ++rhs)
+                                compare(lhs, rhs);
+                }
+            }
+        }
+    }
+}
+
+
+SimilarPhotosFinder::SimilarPhotosFinder(int maxDistance)
+    : m_maxDistance(std::clamp(maxDistance, 0, HashBits - 1))
+{
+
+}
+
+
+std::vector<std::vector<Photo::DataDelta>> SimilarPhotosFinder::findGroups(const std::vector<Photo::DataDelta>& photos) const
+{
+    // sort photos by phash
+    std::vector<std::pair<std::uint64_t, std::size_t>> sortedPhotos;
+    sortedPhotos.reserve(photos.size());
+
+    for (std::size_t i = 0; i < photos.size(); i++)
+        if (photos[i].has(Photo::Field::PHash) && photos[i].get<Photo::Field::PHash>().valid())
+            sortedPhotos.emplace_back(toBits(photos[i].get<Photo::Field::PHash>()), i);
+
+    std::sort(sortedPhotos.begin(), sortedPhotos.end());
+
+    // compare unique hashes only
+    std::vector<std::uint64_t> hashes;
+    std::vector<std::size_t> hashOfPhoto;
+    hashOfPhoto.reserve(sortedPhotos.size());
+
+    for (const auto& [hash, index]: sortedPhotos)
+    {
+        if (hashes.empty() || hashes.back() != hash)
+            hashes.push_back(hash);
+
+        hashOfPhoto.push_back(hashes.size() - 1);
+    }
+
+    DisjointSets sets(hashes.size());
+
+    if (m_maxDistance > 0)
+        uniteSimilar(hashes, m_maxDistance, sets);
+
+    // collect groups. As photos are sorted by hash, groups will be sorted too
+    std::vector<std::vector<Photo::DataDelta>> groups;
+    std::vector<std::size_t> groupOfRoot(hashes.size(), std::numeric_limits<std::size_t>::max());
+
+    for (std::size_t i = 0; i < sortedPhotos.size(); i++)
+    {
+        const std::size_t root = sets.find(hashOfPhoto[i]);
+        std::size_t& group = groupOfRoot[root];
+
+        if (group == std::numeric_limits<std::size_t>::max())
+        {
+            group = groups.size();
+            groups.emplace_back();
+        }
+
+        groups[group].push_back(photos[sortedPhotos[i].second]);
+    }
+
+    std::erase_if(groups, [](const auto& group)
+    {
+        return group.size() < 2;
+    });
+
+    return groups;
+}
+
+
+int SimilarPhotosFinder::distance(const Photo::PHash& lhs, const Photo::PHash& rhs)
+{
+    return std::popcount(toBits(lhs) ^ toBits(rhs));
+}
@@ -33,6 +33,7 @@
 
 
 struct IExifReader;
+struct ITaskExecutor;
 
 
 class DATABASE_EXPORT SeriesDetector
@@ -46,15 +47,22 @@ class DATABASE_EXPORT SeriesDetector
             Rules(std::chrono::milliseconds manualSeriesMaxGap = std::chrono::seconds(10), bool neighbors = false);
         };
 
-        SeriesDetector(ILogger &, Database::IDatabase &, IExifReader &, const QPromise<std::vector<GroupCandidate>> * = nullptr);
+        /**
+         * \brief Constructor
+         * \param executor when provided, photos are analyzed in parallel using executor's workers
+         * \param promise when provided, it is used for cancellation checks and
+         *                groups are reported through it in portions, as soon as they are detected
+         */
+        SeriesDetector(ILogger &, Database::IDatabase &, IExifReader &, ITaskExecutor* executor = nullptr, QPromise<std::vector<GroupCandidate>>* promise = nullptr);
 
         std::vector<GroupCandidate> listCandidates(const Rules& = Rules()) const;
 
     private:
         ILogger& m_logger;
         Database::IDatabase& m_db;
-        const QPromise<std::vector<GroupCandidate>>* m_promise;
+        QPromise<std::vector<GroupCandidate>>* m_promise;
         IExifReader& m_exifReader;
+        ITaskExecutor* m_executor;
 
         std::vector<GroupCandidate> analyzePhotos(const std::deque<Photo::DataDelta> &, const Rules &) const;
         std::deque<Photo::DataDelta> removeSingles(const std::deque<Photo::DataDelta> &, const Rules &) const;
@@ -0,0 +1,43 @@
+
+#ifndef SIMILAR_PHOTOS_FINDER_HPP_INCLUDED
+#define SIMILAR_PHOTOS_FINDER_HPP_INCLUDED
+
+#include <vector>
+
+#include <database/photo_data.hpp>
+#include <database_export.h>
+
+
+/**
+ * \brief Find groups of photos with similar phashes
+ *
+ * Photos are similar when their phashes differ on at most \a maxDistance bits (Hamming distance).
+ * Similarity is transitive: if A is similar to B and B is similar to C, all of them land in one group.
+ *
+ * Multi-index hashing is used to avoid comparing each pair of photos:
+ * phash is split into maxDistance/2 + 1 blocks. Two phashes within maxDistance
+ * need to have at least one block differing on at most one bit,
+ * so only phashes with such blocks are compared.
+ */
+class DATABASE_EXPORT SimilarPhotosFinder
+{
+    public:
+        explicit SimilarPhotosFinder(int maxDistance = 0);
+
+        /**
+         * \brief group similar photos
+         * \arg photos photos to be grouped. Photos without Photo::Field::PHash are ignored.
+         * \return groups of similar photos. Groups with one photo are skipped.
+         *
+         * Photos in groups and groups are ordered by phash.
+         */
+        std::vector<std::vector<Photo::DataDelta>> findGroups(const std::vector<Photo::DataDelta>& photos) const;
+
+        /// number of bits which differ between phashes
+        static int distance(const Photo::PHash &, const Photo::PHash &);
+
+    private:
+        const int m_maxDistance;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef DATES_HISTOGRAM_HPP
+#define DATES_HISTOGRAM_HPP
+
+#include <map>
+#include <unordered_map>
+
+#include <QDate>
+
+#include "photo_types.hpp"
+#include "database_export.h"
+
+
+namespace Database
+{
+    /**
+     * \brief Number of photos for each day
+     *
+     * Keeps date of each photo, so histogram can be updated
+     * with changes of individual photos without recalculating it.
+     * Photos without date are counted under invalid QDate().
+     */
+    class DATABASE_EXPORT DatesHistogram
+    {
+        public:
+            /// set (or change) date of photo
+            void set(const Photo::Id &, const QDate &);
+
+            /// forget photo
+            void remove(const Photo::Id &);
+
+            void clear();
+
+            const std::map<QDate, int>& counts() const;
+
+        private:
+            std::unordered_map<Photo::Id, QDate, Photo::IdHash> m_dates;
+            std::map<QDate, int> m_counts;
+
+            void decrement(const QDate &);
+    };
+}
+
+#endif
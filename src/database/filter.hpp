@@ -25,6 +25,7 @@
 #include <variant>
 
 #include <QString>
+#include <QStringList>
 
 #include <core/data_ptr.hpp>
 #include <core/tag.hpp>
@@ -45,6 +46,7 @@ namespace Database
     struct FilterPhotosWithId;
     struct FilterPhotosMatchingExpression;
     struct FilterPhotosWithPath;
+    struct FilterPhotosInDirectories;
     struct FilterPhotosWithRole;
     struct FilterPhotosWithPerson;
     struct FilterPhotosWithGeneralFlag;
@@ -60,6 +62,7 @@ namespace Database
                          FilterPhotosWithId,
                          FilterPhotosMatchingExpression,
                          FilterPhotosWithPath,
+                         FilterPhotosInDirectories,
                          FilterPhotosWithRole,
                          FilterPhotosWithPerson,
                          FilterPhotosWithGeneralFlag,
@@ -139,6 +142,15 @@ namespace Database
         QString path;
     };
 
+    /// filter photos lying in any of given directories (and theirs subdirectories when \a recursive is set)
+    struct DATABASE_EXPORT FilterPhotosInDirectories
+    {
+        explicit FilterPhotosInDirectories(const QStringList &, bool recursive = false);
+
+        QStringList directories;
+        bool recursive;
+    };
+
     struct DATABASE_EXPORT FilterPhotosWithRole
     {
         enum class Role
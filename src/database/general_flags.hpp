@@ -23,6 +23,10 @@ namespace Database::CommonGeneralFlags
         Normal        = 0,                      // 0 (or nonexistent entry) - photo is in fine state
         Incomaptible  = 1,                      // 1 - could not generate phash. Not an image file.
     };
+
+    // exif data used for series detection. Stored during exif collection (see Photo::FlagsE::ExifLoaded)
+    const QString ExifSequenceNumber("exif_sequence_number");     // number of shot in series
+    const QString ExifExposure("exif_exposure");                    // exposure bias in 1/100 EV
 }
 
 #endif // GENERAL_FLAGS_HPP_INCLUDED
@@ -20,12 +20,14 @@
 #ifndef IBACKEND_HPP
 #define IBACKEND_HPP
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
 #include <optional>
 #include <source_location>
 #include <magic_enum.hpp>
+#include <QDate>
 
 #include <core/tag.hpp>
 
@@ -118,10 +120,40 @@ namespace Database
         virtual std::vector<TagValue>    listTagValues(const Tag::Types &,
                                                        const Filter &) = 0;
 
+        /**
+         * \brief number of photos for each day
+         * \return photos count for each date. Photos without date are counted under invalid QDate()
+         *
+         * Histogram covers all photos in database - filters are not taken into account.
+         * It is maintained incrementally by backend which modifies database (see IDatabase::exec()),
+         * so it is cheap to call it there after each change.
+         * Read only backends (IDatabase::execRead()) do not know about changes made by others,
+         * so they calculate histogram from scratch on each call.
+         */
+        virtual std::map<QDate, int>     getDatesHistogram() = 0;
+
         /// get particular photo
         virtual Photo::Data              getPhoto(const Photo::Id &) = 0;
         virtual Photo::DataDelta         getPhotoDelta(const Photo::Id &, const std::set<Photo::Field> & = {}) = 0;
 
+        /**
+         * \brief get details of many photos at once
+         * \arg ids ids of photos to be read
+         * \arg fields fields to be fetched. All fields are fetched when empty.
+         * \return photos details in order of \a ids
+         *
+         * Batched version of getPhotoDelta(). Photos which do not exist are skipped.
+         */
+        virtual std::vector<Photo::DataDelta> getPhotoDeltas(const std::vector<Photo::Id> &, const std::set<Photo::Field> & = {}) = 0;
+
+        /**
+         * \brief get details of all photos matching filter
+         * \arg filter photos filter
+         * \arg fields fields to be fetched. All fields are fetched when empty.
+         * \return photos details ordered by photo id
+         */
+        virtual std::vector<Photo::DataDelta> getPhotoDeltas(const Filter &, const std::set<Photo::Field> & = {}) = 0;
+
         /// Count photos matching filter
         virtual int                      getPhotosCount(const Filter &) = 0;
 
@@ -145,6 +177,15 @@ namespace Database
          */
         virtual std::optional<int>       get(const Photo::Id& id, const QString& name) = 0;
 
+        /**
+         * \brief get flag values of all photos
+         * \arg name flag name
+         * \return flag value for each photo which has it set
+         *
+         * Bulk version of @ref get
+         */
+        virtual std::map<Photo::Id, int> getFlagValues(const QString& name) = 0;
+
         /**
          * @brief set bits for provided flag
          * @arg id id of photo
@@ -170,6 +211,16 @@ namespace Database
         // reading extra data
         virtual QByteArray getThumbnail(const Photo::Id &) = 0;
 
+        /**
+         * \brief move thumbnails out of database
+         * \arg count max number of thumbnails to be taken
+         * \return taken thumbnails
+         *
+         * Returned thumbnails are removed from database.
+         * Used for migration of thumbnails to external storage.
+         */
+        virtual std::vector<std::pair<Photo::Id, QByteArray>> takeThumbnails(int count) = 0;
+
         // modify data
 
         /**
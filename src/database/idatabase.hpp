@@ -66,6 +66,20 @@ namespace Database
             execute(std::move(task));
         }
 
+        /**
+         * \brief execute task which only reads data
+         *
+         * Such tasks may be executed on a separate, read-only connection,
+         * in parallel with other tasks. There is no ordering guarantee with tasks
+         * scheduled with exec() - only data already committed is guaranteed to be visible.
+         */
+        template<typename Callable> requires std::is_invocable_v<Callable, IBackend &>
+        void execRead(Callable&& f, const std::string& name = std::source_location::current().function_name())
+        {
+            auto task = std::make_unique<Task<Callable>>(std::forward<Callable>(f), name);
+            executeRead(std::move(task));
+        }
+
         struct ITask
         {
             virtual ~ITask() = default;
@@ -100,6 +114,12 @@ namespace Database
             };
 
             virtual void execute(std::unique_ptr<ITask> &&) = 0;
+
+            // default implementation executes read tasks as regular ones
+            virtual void executeRead(std::unique_ptr<ITask>&& task)
+            {
+                execute(std::move(task));
+            }
     };
 
     //Database interface.
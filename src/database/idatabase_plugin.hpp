@@ -40,6 +40,14 @@ namespace Database
         virtual ~IPlugin() {}
 
         virtual std::unique_ptr<IBackend> constructBackend(IConfiguration *, ILogger *) = 0;      //return backend object
+
+        // return backend object for read only access, working in parallel with the one returned by constructBackend().
+        // Return nullptr when backend does not support concurrent access.
+        virtual std::unique_ptr<IBackend> constructReadOnlyBackend(IConfiguration *, ILogger *)
+        {
+            return {};
+        }
+
         virtual QString backendName() const = 0;                                                  //return backend name
         virtual ProjectInfo initPrjDir(const QString& dir, const QString& name) const = 0;        //prepares database in provided directory
         virtual QLayout* buildDBOptions() = 0;                                                    //return QLayout for ProjectCreator dialog with options for specific backend
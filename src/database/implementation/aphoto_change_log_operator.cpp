@@ -100,6 +100,14 @@ namespace Database
     }
 
 
+    const std::set<Photo::Field>& APhotoChangeLogOperator::trackedFields()
+    {
+        static const std::set<Photo::Field> fields = { Photo::Field::Tags, Photo::Field::GroupInfo };
+
+        return fields;
+    }
+
+
     void APhotoChangeLogOperator::groupCreated(const Group::Id& id, const Group::Type &, const Photo::Id& representative_id)
     {
         process(representative_id, GroupInfo(), GroupInfo(id, GroupInfo::Role::Representative));
@@ -19,6 +19,8 @@
 
 #include "async_database.hpp"
 
+#include <atomic>
+#include <future>
 #include <thread>
 #include <memory>
 #include <QElapsedTimer>
@@ -37,6 +39,31 @@
 
 namespace Database
 {
+    namespace
+    {
+        // backend of read only connection owned by current thread (if any)
+        thread_local IBackend* t_readerBackend = nullptr;
+
+        void runTask(IDatabaseThread::ITask& task, IBackend& backend, ILogger& logger)
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            task.run(backend);
+
+            const qint64 elapsed = timer.elapsed();
+            const QString message = QString("task '%2' took %1ms")
+                .arg(elapsed)
+                .arg(QString::fromStdString(task.name()));
+
+            if (elapsed > 100)
+                logger.warning(message);
+            else
+                logger.trace(message);
+        }
+    }
+
+
     struct Executor
     {
         Executor(Database::IBackend& backend, ILogger* logger):
@@ -62,24 +89,7 @@ namespace Database
                 std::optional< std::unique_ptr<IDatabaseThread::ITask> > taskOpt = m_tasks.pop();
 
                 if (taskOpt)
-                {
-                    QElapsedTimer timer;
-                    timer.start();
-
-                    const auto& task = *taskOpt;
-
-                    task->run(m_backend);
-
-                    const qint64 elapsed = timer.elapsed();
-                    const QString message = QString("task '%2' took %1ms")
-                        .arg(elapsed)
-                        .arg(QString::fromStdString(task->name()));
-
-                    if (elapsed > 100)
-                        m_logger->warning(message);
-                    else
-                        m_logger->trace(message);
-                }
+                    runTask(**taskOpt, m_backend, *m_logger);
                 else
                     break;
             }
@@ -102,6 +112,118 @@ namespace Database
             std::unique_ptr<ILogger> m_logger;
     };
 
+    // Read only backends, each working on its own thread, sharing one queue of tasks
+    class ReadersPool
+    {
+        public:
+            ReadersPool(std::vector<std::unique_ptr<IBackend>>&& backends, ILogger* logger)
+                : m_tasks(1024)
+                , m_backends(std::move(backends))
+                , m_logger(logger->subLogger("ReadersPool"))
+                , m_ready(false)
+            {
+
+            }
+
+            ReadersPool(const ReadersPool &) = delete;
+            ReadersPool& operator=(const ReadersPool &) = delete;
+
+            ~ReadersPool()
+            {
+                stop();
+            }
+
+            // start threads and open connections. Pool is ready only when all connections were opened.
+            void start(const ProjectInfo& prjInfo)
+            {
+                std::vector<std::future<BackendStatus>> statuses;
+
+                for (auto& backend: m_backends)
+                {
+                    std::promise<BackendStatus> status;
+                    statuses.push_back(status.get_future());
+
+                    m_threads.emplace_back(&ReadersPool::work, this, std::ref(*backend), prjInfo, std::move(status));
+                }
+
+                bool ready = true;
+                for (auto& status: statuses)
+                    ready &= static_cast<bool>(status.get());
+
+                if (ready)
+                {
+                    m_logger->info(QString("%1 read only connections opened").arg(m_backends.size()));
+                    m_ready = true;
+                }
+                else
+                {
+                    m_logger->warning("Could not open read only connections. All tasks will be executed on main connection");
+                    stop();
+                }
+            }
+
+            void stop()
+            {
+                m_ready = false;
+
+                if (m_threads.empty() == false)
+                {
+                    // pending tasks are still executed
+                    m_tasks.stop();
+
+                    for (auto& thread: m_threads)
+                        thread.join();
+
+                    m_threads.clear();
+                }
+            }
+
+            bool isReady() const
+            {
+                return m_ready;
+            }
+
+            void addTask(std::unique_ptr<IDatabaseThread::ITask>&& task)
+            {
+                m_tasks.push(std::move(task));
+            }
+
+        private:
+            ol::TS_Queue<std::unique_ptr<IDatabaseThread::ITask>> m_tasks;
+            std::vector<std::unique_ptr<IBackend>> m_backends;
+            std::vector<std::thread> m_threads;
+            std::unique_ptr<ILogger> m_logger;
+            std::atomic<bool> m_ready;
+
+            void work(IBackend& backend, const ProjectInfo& prjInfo, std::promise<BackendStatus>&& initStatus)
+            {
+                set_thread_name("ADatabaseRead");
+
+                const BackendStatus status = backend.init(prjInfo);
+                initStatus.set_value(status);
+
+                if (status)
+                {
+                    t_readerBackend = &backend;
+
+                    for(;;)
+                    {
+                        std::optional< std::unique_ptr<IDatabaseThread::ITask> > taskOpt = m_tasks.pop();
+
+                        if (taskOpt)
+                            runTask(**taskOpt, backend, *m_logger);
+                        else
+                            break;
+                    }
+
+                    t_readerBackend = nullptr;
+                }
+
+                backend.closeConnections();
+            }
+    };
+
+
     struct DbCloseTask final: IDatabaseThread::ITask
     {
         DbCloseTask() = default;
@@ -122,10 +244,12 @@ namespace Database
 
 
     AsyncDatabase::AsyncDatabase(std::unique_ptr<IBackend>&& backend,
-                                 ILogger* logger):
+                                 ILogger* logger,
+                                 std::vector<std::unique_ptr<IBackend>>&& readers):
         m_logger(logger->subLogger("AsyncDatabase")),
         m_backend(std::move(backend)),
         m_executor(std::make_unique<Executor>(*m_backend.get(), m_logger.get())),
+        m_readers(readers.empty()? nullptr: std::make_unique<ReadersPool>(std::move(readers), m_logger.get())),
         m_working(true)
     {
         m_thread = std::thread(&Executor::begin, m_executor.get());
@@ -147,10 +271,14 @@ namespace Database
 
     void AsyncDatabase::init(const ProjectInfo& prjInfo, const Callback<const BackendStatus &>& callback)
     {
-        exec([prjInfo, callback](IBackend& backend)
+        exec([this, prjInfo, callback](IBackend& backend)
         {
              const Database::BackendStatus status = backend.init(prjInfo);
 
+             // open read only connections when database structure is known to be valid
+             if (status && m_readers)
+                 m_readers->start(prjInfo);
+
              callback(status);
         });
     }
@@ -162,6 +290,18 @@ namespace Database
     }
 
 
+    void AsyncDatabase::executeRead(std::unique_ptr<IDatabaseThread::ITask>&& task)
+    {
+        // Tasks coming from read only connection's thread are executed immediately (as addTask() does for db's thread)
+        if (t_readerBackend != nullptr)
+            task->run(*t_readerBackend);
+        else if (m_readers && m_readers->isReady() && std::this_thread::get_id() != m_thread.get_id())
+            m_readers->addTask(std::move(task));
+        else
+            addTask(std::move(task));
+    }
+
+
     IBackend& AsyncDatabase::backend()
     {
         return *m_backend.get();
@@ -189,6 +329,9 @@ namespace Database
             // do not accept any more tasks
             m_working = false;
 
+            if (m_readers)
+                m_readers->stop();
+
             // add final task
             m_executor->addTask(std::make_unique<DbCloseTask>());
             m_executor->stop();
@@ -34,18 +34,26 @@ namespace Database
 {
     struct Executor;
     struct IThreadTask;
+    class ReadersPool;
 
 
     class AsyncDatabase: public IDatabase
     {
         public:
-            AsyncDatabase(std::unique_ptr<IBackend> &&, ILogger *);
+            /**
+             * \param backend backend used for all writes (and reads when there are no \a readers)
+             * \param logger logger
+             * \param readers additional backends, each run on its own thread, used for read only tasks.
+             *                They are initialized with the same project as \a backend once it is initialized.
+             */
+            AsyncDatabase(std::unique_ptr<IBackend> && backend, ILogger * logger, std::vector<std::unique_ptr<IBackend>> && readers = {});
             AsyncDatabase(const AsyncDatabase &) = delete;
             virtual ~AsyncDatabase();
 
             AsyncDatabase& operator=(const AsyncDatabase &) = delete;
 
             virtual void execute(std::unique_ptr<ITask> &&) override;
+            virtual void executeRead(std::unique_ptr<ITask> &&) override;
 
             IBackend& backend() override;
 
@@ -56,6 +64,7 @@ namespace Database
             std::unique_ptr<ILogger> m_logger;
             std::unique_ptr<IBackend> m_backend;
             std::unique_ptr<Executor> m_executor;
+            std::unique_ptr<ReadersPool> m_readers;
             std::thread m_thread;
             bool m_working;
 
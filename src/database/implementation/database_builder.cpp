@@ -20,10 +20,12 @@
 
 #include "database_builder.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <thread>
 
 #include <core/ilogger.hpp>
 #include <core/ilogger_factory.hpp>
@@ -44,6 +46,15 @@ namespace Database
 
     const char* databaseLocation = "Database::Backend::DataLocation";
 
+    namespace
+    {
+        // number of read only connections opened next to the main one (when backend supports them)
+        unsigned readConnections()
+        {
+            return std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+        }
+    }
+
     struct Builder::Impl
     {
         Impl(const Impl &) = delete;
@@ -99,7 +110,18 @@ namespace Database
 
         std::unique_ptr<IBackend> backend = plugin->constructBackend(m_impl->m_configuration, logger.get());
 
-        auto database = std::make_unique<ObservableDatabase<AsyncDatabase>>(std::move(backend), logger.get());
+        std::vector<std::unique_ptr<IBackend>> readers;
+        for (unsigned i = 0; i < readConnections(); i++)
+        {
+            auto reader = plugin->constructReadOnlyBackend(m_impl->m_configuration, logger.get());
+
+            if (reader)
+                readers.push_back(std::move(reader));
+            else
+                break;
+        }
+
+        auto database = std::make_unique<ObservableDatabase<AsyncDatabase>>(std::move(backend), logger.get(), std::move(readers));
 
         return database;
     }
@@ -0,0 +1,58 @@
+#include "dates_histogram.hpp"
+
+#include <cassert>
+
+
+namespace Database
+{
+    void DatesHistogram::set(const Photo::Id& id, const QDate& date)
+    {
+        const auto [it, inserted] = m_dates.try_emplace(id, date);
+
+        if (inserted == false)
+        {
+            if (it->second == date)
+                return;
+
+            decrement(it->second);
+            it->second = date;
+        }
+
+        m_counts[date]++;
+    }
+
+
+    void DatesHistogram::remove(const Photo::Id& id)
+    {
+        auto it = m_dates.find(id);
+
+        if (it != m_dates.end())
+        {
+            decrement(it->second);
+            m_dates.erase(it);
+        }
+    }
+
+
+    void DatesHistogram::clear()
+    {
+        m_dates.clear();
+        m_counts.clear();
+    }
+
+
+    const std::map<QDate, int>& DatesHistogram::counts() const
+    {
+        return m_counts;
+    }
+
+
+    void DatesHistogram::decrement(const QDate& date)
+    {
+        auto it = m_counts.find(date);
+        assert(it != m_counts.end());
+
+        if (--it->second == 0)
+            m_counts.erase(it);
+    }
+}
@@ -84,6 +84,14 @@ namespace Database
     }
 
 
+    FilterPhotosInDirectories::FilterPhotosInDirectories(const QStringList& dirs, bool r)
+        : directories(dirs)
+        , recursive(r)
+    {
+
+    }
+
+
     FilterPhotosWithRole::FilterPhotosWithRole(Database::FilterPhotosWithRole::Role role): m_role(role)
     {
 
@@ -54,6 +54,13 @@ class ObservableDatabase: public ObservableExecutor, public T
 
             T::execute(std::move(observedTask));
         }
+
+        void executeRead(std::unique_ptr<Database::IDatabaseThread::ITask>&& task) override
+        {
+            auto observedTask = std::make_unique<Task>(*this, std::move(task));
+
+            T::executeRead(std::move(observedTask));
+        }
 };
 
 #endif
@@ -0,0 +1,113 @@
+#include <array>
+#include <cstring>
+
+#include <gtest/gtest.h>
+#include <opencv2/img_hash.hpp>
+#include <QImage>
+#include <QImageReader>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+#include "database_tools/implementation/phash_calculator.hpp"
+
+
+namespace
+{
+    // gradient with some noise
+    QImage testImage(int width, int height)
+    {
+        QImage image(width, height, QImage::Format_RGB32);
+        QRandomGenerator generator(width * height);
+
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+            {
+                const int r = x * 255 / width;
+                const int g = y * 255 / height;
+                const int b = static_cast<int>(generator.bounded(256));
+
+                image.setPixel(x, y, qRgb(r, g, b));
+            }
+
+        return image;
+    }
+
+    // phash calculated the way it was done before PHashCalculator was introduced
+    Photo::PHash referencePHash(const QImage& source)
+    {
+        const QImage image = source.convertToFormat(QImage::Format_ARGB32);
+
+        const cv::Mat cvImage(
+            image.height(),
+            image.width(),
+            CV_8UC4,
+            const_cast<uchar *>(image.constBits()),
+            static_cast<std::size_t>(image.bytesPerLine())
+        );
+
+        cv::Mat phashMat;
+        cv::img_hash::pHash(cvImage, phashMat);
+
+        std::array<std::byte, 8> rawPHash;
+        std::memcpy(rawPHash.data(), phashMat.datastart, rawPHash.size());
+
+        return Photo::PHash(rawPHash);
+    }
+}
+
+
+TEST(PHashCalculatorTest, nullImageHasNoPHash)
+{
+    EXPECT_FALSE(PHashCalculator::calculate(QImage()).has_value());
+}
+
+
+TEST(PHashCalculatorTest, resultsAreIdenticalToOpenCVImplementation)
+{
+    for (const QSize& size: { QSize(32, 32), QSize(100, 75), QSize(640, 480), QSize(333, 1000) })
+    {
+        const QImage image = testImage(size.width(), size.height());
+
+        for (const QImage::Format format: { QImage::Format_RGB32, QImage::Format_ARGB32, QImage::Format_RGB888, QImage::Format_Grayscale8 })
+        {
+            const QImage converted = image.convertToFormat(format);
+            const std::optional<Photo::PHash> phash = PHashCalculator::calculate(converted);
+
+            ASSERT_TRUE(phash.has_value());
+            EXPECT_EQ(phash->value(), referencePHash(converted).value()) << "size: " << size.width() << "x" << size.height() << " format: " << format;
+        }
+    }
+}
+
+
+TEST(PHashCalculatorTest, loadedImageHasSameHashAsImageFromFile)
+{
+    QTemporaryDir dir;
+
+    for (const char* format: {"png", "jpg"})
+    {
+        const QString path = dir.filePath(QString("image.%1").arg(format));
+        ASSERT_TRUE(testImage(1600, 1200).save(path));
+
+        const auto phash = PHashCalculator::calculate(PHashCalculator::load(path));
+
+        ASSERT_TRUE(phash.has_value());
+        EXPECT_EQ(phash->value(), referencePHash(QImage(path)).value()) << "format: " << format;
+    }
+}
+
+
+TEST(PHashCalculatorTest, readerUsedForHeaderCanBeUsedForDecoding)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("image.jpg");
+    ASSERT_TRUE(testImage(640, 480).save(path));
+
+    QImageReader reader(path);
+    EXPECT_EQ(reader.size(), QSize(640, 480));
+
+    const auto phash = PHashCalculator::calculate(PHashCalculator::load(reader));
+
+    ASSERT_TRUE(phash.has_value());
+    EXPECT_EQ(phash->value(), referencePHash(QImage(path)).value());
+}
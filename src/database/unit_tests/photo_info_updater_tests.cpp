@@ -1,6 +1,7 @@
 
 #include <gmock/gmock.h>
 
+#include "database/general_flags.hpp"
 #include "database_tools/implementation/photo_info_updater.hpp"
 #include "database_tools/implementation/photos_analyzer_constants.hpp"
 #include "unit_tests_utils/empty_logger.hpp"
@@ -22,30 +23,41 @@ using testing::ReturnRef;
 using testing::NiceMock;
 using namespace PhotosAnalyzerConsts;
 
-TEST(PhotoInfoUpdaterTest, tagsUpdate)
+namespace
 {
-    FakeTaskExecutor taskExecutor;
-    NiceMock<MockBackend> backend;
-    NiceMock<ILoggerFactoryMock> loggerFactoryMock;
-    NiceMock<IConfigurationMock> configurationMock;
-    NiceMock<ICoreFactoryAccessorMock> coreFactory;
-    NiceMock<MockDatabase> db;
-    NiceMock<MediaInformationMock> mediaInformation;
-
-    ON_CALL(mediaInformation, getInformation).WillByDefault(Return(FileInformation{}));
-    ON_CALL(coreFactory, getConfiguration).WillByDefault(ReturnRef(configurationMock));
-    ON_CALL(coreFactory, getLoggerFactory).WillByDefault(ReturnRef(loggerFactoryMock));
-    ON_CALL(coreFactory, getTaskExecutor).WillByDefault(ReturnRef(taskExecutor));
-    ON_CALL(loggerFactoryMock, get(An<const QString &>())).WillByDefault(Invoke([](const auto &)
+    struct PhotoInfoUpdaterTest: testing::Test
     {
-        return std::make_unique<EmptyLogger>();
-    }));
+        PhotoInfoUpdaterTest()
+        {
+            ON_CALL(mediaInformation, getInformation(_)).WillByDefault(Return(FileInformation{}));
+            ON_CALL(mediaInformation, getInformation(_, _)).WillByDefault(Return(FileInformation{}));
+            ON_CALL(coreFactory, getConfiguration).WillByDefault(ReturnRef(configurationMock));
+            ON_CALL(coreFactory, getLoggerFactory).WillByDefault(ReturnRef(loggerFactoryMock));
+            ON_CALL(coreFactory, getTaskExecutor).WillByDefault(ReturnRef(taskExecutor));
+            ON_CALL(loggerFactoryMock, get(An<const QString &>())).WillByDefault(Invoke([](const auto &)
+            {
+                return std::make_unique<EmptyLogger>();
+            }));
 
-    ON_CALL(db, execute).WillByDefault(Invoke([&backend](std::unique_ptr<Database::IDatabase::ITask>&& task)
-    {
-        task->run(backend);
-    }));
+            ON_CALL(db, execute).WillByDefault(Invoke([this](std::unique_ptr<Database::IDatabase::ITask>&& task)
+            {
+                task->run(backend);
+            }));
+        }
+
+        FakeTaskExecutor taskExecutor;
+        NiceMock<MockBackend> backend;
+        NiceMock<ILoggerFactoryMock> loggerFactoryMock;
+        NiceMock<IConfigurationMock> configurationMock;
+        NiceMock<ICoreFactoryAccessorMock> coreFactory;
+        NiceMock<MockDatabase> db;
+        NiceMock<MediaInformationMock> mediaInformation;
+    };
+}
 
+
+TEST_F(PhotoInfoUpdaterTest, tagsUpdate)
+{
     // orignal state of photo
     Photo::DataDelta photo(Photo::Id(123));
     photo.insert<Photo::Field::Path>("/path/to/file.jpeg");
@@ -64,3 +76,70 @@ TEST(PhotoInfoUpdaterTest, tagsUpdate)
     const auto lockedData = sharedData->lock();
     EXPECT_EQ(*lockedData, newPhotoData);
 }
+
+
+TEST_F(PhotoInfoUpdaterTest, allStagesInOneTask)
+{
+    FileInformation info;
+    info.common.dimension = QSize(1200, 800);
+    info.common.creationTime = QDateTime(QDate(2021, 4, 15), QTime(12, 30, 0));
+
+    // file information should be read once for all stages, with reader used later for decoding
+    EXPECT_CALL(mediaInformation, getInformation(QString("/path/to/file.jpeg"), _)).WillOnce(Return(info));
+    EXPECT_CALL(mediaInformation, getInformation(QString("/path/to/file.jpeg"))).Times(0);
+
+    // file does not exist so it cannot be decoded
+    EXPECT_CALL(backend, setBits(Photo::Id(123),
+                                 Database::CommonGeneralFlags::PHashState,
+                                 static_cast<int>(Database::CommonGeneralFlags::PHashStateType::Incomaptible)));
+
+    Photo::DataDelta photo(Photo::Id(123));
+    photo.insert<Photo::Field::Path>("/path/to/file.jpeg");
+    photo.insert<Photo::Field::Flags>( std::map<Photo::FlagsE, int>{ {Photo::FlagsE::StagingArea, 1} } );
+    photo.insert<Photo::Field::Tags>( Tag::TagsList{} );
+
+    Photo::DataDelta newPhotoData(photo);
+    newPhotoData.insert<Photo::Field::Geometry>(QSize(1200, 800));
+    newPhotoData.get<Photo::Field::Flags>()[Photo::FlagsE::GeometryLoaded] = GeometryFlagVersion;
+    newPhotoData.get<Photo::Field::Flags>()[Photo::FlagsE::ExifLoaded] = ExifFlagVersion;
+    newPhotoData.get<Photo::Field::Tags>()[Tag::Types::Date] = QDate(2021, 4, 15);
+    newPhotoData.get<Photo::Field::Tags>()[Tag::Types::Time] = QTime(12, 30, 0);
+
+    PhotoInfoUpdater updater(taskExecutor, mediaInformation, &coreFactory, db);
+
+    auto sharedData = std::make_shared<Photo::SafeDataDelta>(photo);
+    updater.updateMetadata(sharedData, {.geometry = true, .tags = true, .pHash = true});
+
+    const auto lockedData = sharedData->lock();
+    EXPECT_EQ(*lockedData, newPhotoData);
+}
+
+
+TEST_F(PhotoInfoUpdaterTest, exifDataForSeriesDetectionIsStored)
+{
+    FileInformation info;
+    info.common.creationTime = QDateTime(QDate(2021, 4, 15), QTime(12, 30, 0));
+    info.details = ImageFile{ .sequenceNumber = 3, .exposure = -1.5f };
+
+    ON_CALL(mediaInformation, getInformation(_)).WillByDefault(Return(info));
+
+    EXPECT_CALL(backend, set(Photo::Id(123), Database::CommonGeneralFlags::ExifSequenceNumber, 3));
+    EXPECT_CALL(backend, set(Photo::Id(123), Database::CommonGeneralFlags::ExifExposure, -150));
+
+    // photo has date already, it should not be overridden
+    Photo::DataDelta photo(Photo::Id(123));
+    photo.insert<Photo::Field::Path>("/path/to/file.jpeg");
+    photo.insert<Photo::Field::Flags>( std::map<Photo::FlagsE, int>{ {Photo::FlagsE::ExifLoaded, 2} } );
+    photo.insert<Photo::Field::Tags>( std::map<Tag::Types, TagValue>{ {Tag::Types::Date, QDate(2020, 1, 1)} } );
+
+    Photo::DataDelta newPhotoData(photo);
+    newPhotoData.get<Photo::Field::Flags>()[Photo::FlagsE::ExifLoaded] = ExifFlagVersion;
+
+    PhotoInfoUpdater updater(taskExecutor, mediaInformation, &coreFactory, db);
+
+    auto sharedData = std::make_shared<Photo::SafeDataDelta>(photo);
+    updater.updateTags(sharedData);
+
+    const auto lockedData = sharedData->lock();
+    EXPECT_EQ(*lockedData, newPhotoData);
+}
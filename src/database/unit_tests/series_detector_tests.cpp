@@ -10,12 +10,15 @@
 #include <unit_tests_utils/mock_photo_operator.hpp>
 
 #include "backends/memory_backend/memory_backend.hpp"
+#include "database_tools/implementation/photos_analyzer_constants.hpp"
 #include "database_tools/json_to_backend.hpp"
 #include "database_tools/series_detector.hpp"
+#include "database/general_flags.hpp"
 #include "unit_tests_utils/db_for_series_detection.json.hpp"
 #include "unit_tests_utils/mock_database.hpp"
 
 
+using testing::An;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
@@ -36,6 +39,18 @@ class SeriesDetectorTest: public testing::Test
             {
                 task->run(backend);
             }));
+
+            // route batched reads through getPhotoDelta() so tests can mock data of single photos
+            ON_CALL(backend, getPhotoDeltas(An<const std::vector<Photo::Id> &>(), _)).WillByDefault(Invoke([this](const std::vector<Photo::Id>& ids, const std::set<Photo::Field>& fields)
+            {
+                std::vector<Photo::DataDelta> deltas;
+                std::ranges::transform(ids, std::back_inserter(deltas), [this, &fields](const Photo::Id& id)
+                {
+                    return backend.getPhotoDelta(id, fields);
+                });
+
+                return deltas;
+            }));
         }
 };
 
@@ -397,3 +412,146 @@ TEST_F(SeriesDetectorTest, Complexity)
     const SeriesDetector sd(logger, db, exif);
     const std::vector<GroupCandidate> groupCanditates = sd.listCandidates();
 }
+
+
+TEST_F(SeriesDetectorTest, storedExifDataIsUsedForAnalyzedPhotos)
+{
+    NiceMock<MockExifReader> exif;
+    NiceMock<PhotoOperatorMock> photoOperator;
+
+    ON_CALL(backend, photoOperator()).WillByDefault(ReturnRef(photoOperator));
+
+    // Mock 6 photos analyzed by current version of PhotosAnalyzer.
+    // Their exif data is stored in database so files should not be touched.
+    std::vector<Photo::Id> all_photos =
+    {
+        Photo::Id(1), Photo::Id(2), Photo::Id(3), Photo::Id(4), Photo::Id(5), Photo::Id(6)
+    };
+
+    ON_CALL(photoOperator, onPhotos(_, Database::Action(Database::Actions::Sort(Database::Actions::Sort::By::Timestamp)))).WillByDefault(Return(all_photos));
+    ON_CALL(backend, getPhotoDelta(_, _)).WillByDefault(Invoke([](const Photo::Id& id, const auto &) -> Photo::DataDelta
+    {
+        Photo::Data data;
+        data.id = id;
+        data.path = QString("path: %1.jpeg").arg(id.value());
+        data.tags.emplace(Tag::Types::Date, QDate::fromString("2000.12.01", "yyyy.MM.dd"));
+        data.tags.emplace(Tag::Types::Time, QTime::fromString(QString("12.00.%1").arg(id.value()), "hh.mm.s"));
+        data.flags[Photo::FlagsE::ExifLoaded] = PhotosAnalyzerConsts::ExifFlagVersion;
+
+        return Photo::DataDelta(data);
+    }));
+
+    std::map<Photo::Id, int> sequenceNumbers;
+    for (const auto& id: all_photos)
+        sequenceNumbers.emplace(id, (id.value() - 1) % 3 + 1);   // id:1 -> 1, id:2 -> 2, id:3 -> 3, id:4 -> 1 ...
+
+    ON_CALL(backend, getFlagValues(Database::CommonGeneralFlags::ExifSequenceNumber)).WillByDefault(Return(sequenceNumbers));
+    EXPECT_CALL(exif, get(_, _)).Times(0);
+
+    const SeriesDetector sd(logger, db, exif);
+    const std::vector<GroupCandidate> groupCanditates = sd.listCandidates();
+
+    ASSERT_EQ(groupCanditates.size(), 2);
+    ASSERT_EQ(groupCanditates.front().members.size(), 3);
+    ASSERT_EQ(groupCanditates.back().members.size(), 3);
+    EXPECT_EQ(groupCanditates.front().type, GroupCandidate::Type::Series);
+    EXPECT_EQ(groupCanditates.back().type, GroupCandidate::Type::Series);
+}
+
+
+TEST_F(SeriesDetectorTest, photosRemovedDuringDetectionAreSkipped)
+{
+    NiceMock<MockExifReader> exif;
+    NiceMock<PhotoOperatorMock> photoOperator;
+
+    ON_CALL(backend, photoOperator()).WillByDefault(ReturnRef(photoOperator));
+
+    // the same data as in smartphoneSeries test
+    std::vector<Photo::Id> all_photos =
+    {
+        Photo::Id(1), Photo::Id(2), Photo::Id(3), Photo::Id(4), Photo::Id(5), Photo::Id(6)
+    };
+
+    ON_CALL(photoOperator, onPhotos(_, Database::Action(Database::Actions::Sort(Database::Actions::Sort::By::Timestamp)))).WillByDefault(Return(all_photos));
+    ON_CALL(backend, getPhotoDelta(_, _)).WillByDefault(Invoke([](const Photo::Id& id, const auto &) -> Photo::DataDelta
+    {
+        Photo::Data data;
+        data.id = id;
+        data.path = QString("path_BURST%1.jpeg").arg(id.value() % 3 + 1);
+        data.tags.emplace(Tag::Types::Date, QDate::fromString("2000.12.01", "yyyy.MM.dd"));
+        data.tags.emplace(Tag::Types::Time, QTime::fromString(QString("12.00.%1").arg(id.value()), "hh.mm.s"));
+
+        return Photo::DataDelta(data);
+    }));
+
+    // photo #1 disappears before groups are materialized
+    ON_CALL(backend, getPhotoDeltas(An<const std::vector<Photo::Id> &>(), _)).WillByDefault(Invoke([this](const std::vector<Photo::Id>& ids, const std::set<Photo::Field>& fields)
+    {
+        std::vector<Photo::DataDelta> deltas;
+
+        for (const Photo::Id& id: ids)
+            if (fields.contains(Photo::Field::GroupInfo) == false || id != Photo::Id(1))
+                deltas.push_back(backend.getPhotoDelta(id, fields));
+
+        return deltas;
+    }));
+
+    const SeriesDetector sd(logger, db, exif);
+    const std::vector<GroupCandidate> groupCanditates = sd.listCandidates();
+
+    ASSERT_EQ(groupCanditates.size(), 2);
+    EXPECT_EQ(groupCanditates.front().members.size(), 2);
+    EXPECT_EQ(groupCanditates.back().members.size(), 3);
+}
+
+
+TEST_F(SeriesDetectorTest, groupsAreReportedInPortions)
+{
+    NiceMock<MockExifReader> exif;
+    NiceMock<PhotoOperatorMock> photoOperator;
+
+    ON_CALL(backend, photoOperator()).WillByDefault(ReturnRef(photoOperator));
+
+    // Mock 500 photos
+    // taken in pairs (1 second between photos in pair)
+    // with 1 minute gap between pairs
+    std::vector<Photo::Id> all_photos;
+
+    for(int i = 1; i <= 500; i++)
+        all_photos.push_back(Photo::Id(i));
+
+    ON_CALL(photoOperator, onPhotos(_, Database::Action(Database::Actions::Sort(Database::Actions::Sort::By::Timestamp)))).WillByDefault(Return(all_photos));
+    ON_CALL(backend, getPhotoDelta(_, _)).WillByDefault(Invoke([](const Photo::Id& id, const auto &) -> Photo::DataDelta
+    {
+        const int pair = (id.value() - 1) / 2;
+        const int inPair = (id.value() - 1) % 2;
+
+        Photo::Data data;
+        data.id = id;
+        data.path = QString("path: %1.jpeg").arg(id.value());
+        data.tags.emplace(Tag::Types::Date, QDate::fromString("2000.12.01", "yyyy.MM.dd"));
+        data.tags.emplace(Tag::Types::Time, QTime(0, 0).addSecs(pair * 60 + inPair));
+
+        return Photo::DataDelta(data);
+    }));
+
+    QPromise<std::vector<GroupCandidate>> promise;
+    promise.start();
+
+    const SeriesDetector sd(logger, db, exif, nullptr, &promise);
+    const std::vector<GroupCandidate> groupCanditates = sd.listCandidates(SeriesDetector::Rules(std::chrono::seconds(10), true));
+
+    promise.finish();
+
+    ASSERT_EQ(groupCanditates.size(), 250);
+
+    // groups are delivered through promise in more than one portion, but all of them are there
+    const QList<std::vector<GroupCandidate>> portions = promise.future().results();
+    EXPECT_GT(portions.size(), 1);
+
+    std::size_t reported = 0;
+    for (const auto& portion: portions)
+        reported += portion.size();
+
+    EXPECT_EQ(reported, groupCanditates.size());
+}
@@ -0,0 +1,138 @@
+
+#include <random>
+
+#include <gmock/gmock.h>
+
+#include "database_tools/similar_photos_finder.hpp"
+
+
+namespace
+{
+    Photo::DataDelta photo(int id, qlonglong hash)
+    {
+        Photo::DataDelta delta{Photo::Id(id)};
+        delta.insert<Photo::Field::PHash>(Photo::PHash(hash));
+
+        return delta;
+    }
+
+    std::vector<std::vector<int>> ids(const std::vector<std::vector<Photo::DataDelta>>& groups)
+    {
+        std::vector<std::vector<int>> result;
+
+        for (const auto& group: groups)
+        {
+            std::vector<int> groupIds;
+
+            for (const auto& delta: group)
+                groupIds.push_back(delta.getId().value());
+
+            result.push_back(groupIds);
+        }
+
+        return result;
+    }
+}
+
+
+TEST(SimilarPhotosFinderTest, distanceIsNumberOfDifferentBits)
+{
+    EXPECT_EQ(SimilarPhotosFinder::distance(Photo::PHash(0x0), Photo::PHash(0x0)), 0);
+    EXPECT_EQ(SimilarPhotosFinder::distance(Photo::PHash(0x0), Photo::PHash(0x1)), 1);
+    EXPECT_EQ(SimilarPhotosFinder::distance(Photo::PHash(0xf0), Photo::PHash(0x0f)), 8);
+    EXPECT_EQ(SimilarPhotosFinder::distance(Photo::PHash(-1), Photo::PHash(0x0)), 64);
+}
+
+
+TEST(SimilarPhotosFinderTest, exactDuplicatesForZeroDistance)
+{
+    const SimilarPhotosFinder finder(0);
+
+    const auto groups = finder.findGroups({
+        photo(1, 0x1000),
+        photo(2, 0x1001),
+        photo(3, 0x1000),
+        photo(4, 0x2000),
+        photo(5, 0x0100),
+        photo(6, 0x0100),
+    });
+
+    EXPECT_EQ(ids(groups), (std::vector<std::vector<int>>{ {5, 6}, {1, 3} }));
+}
+
+
+TEST(SimilarPhotosFinderTest, photosWithoutPHashAreIgnored)
+{
+    const SimilarPhotosFinder finder(2);
+
+    const auto groups = finder.findGroups({
+        photo(1, 0x1000),
+        Photo::DataDelta(Photo::Id(2)),
+        photo(3, 0x1000),
+        Photo::DataDelta(Photo::Id(4)),
+    });
+
+    EXPECT_EQ(ids(groups), (std::vector<std::vector<int>>{ {1, 3} }));
+}
+
+
+TEST(SimilarPhotosFinderTest, similarHashesAreGrouped)
+{
+    const SimilarPhotosFinder finder(3);
+
+    const auto groups = finder.findGroups({
+        photo(1, 0x0f00000000000000),
+        photo(2, 0x0f00000000000007),               // 3 bits from photo 1
+        photo(3, 0x0f0000000000000f),               // 4 bits from photo 1 but 1 bit from photo 2
+        photo(4, 0x00000000000000f0),               // far from everything
+        photo(5, 0x7000000000000000),
+        photo(6, 0x7000000000000001),
+    });
+
+    EXPECT_EQ(ids(groups), (std::vector<std::vector<int>>{ {1, 2, 3}, {5, 6} }));
+}
+
+
+TEST(SimilarPhotosFinderTest, matchesBruteForce)
+{
+    const int maxDistance = 5;
+    std::mt19937_64 generator(1234);
+    std::vector<Photo::DataDelta> photos;
+
+    // clusters of hashes with a few bits flipped
+    for (int cluster = 0; cluster < 50; cluster++)
+    {
+        const std::uint64_t base = generator();
+
+        for (int i = 0; i < 4; i++)
+        {
+            std::uint64_t hash = base;
+
+            for (int bit = 0; bit < i; bit++)
+                hash ^= std::uint64_t(1) << (generator() % 64);
+
+            photos.push_back(photo(static_cast<int>(photos.size()), static_cast<qlonglong>(hash)));
+        }
+    }
+
+    const SimilarPhotosFinder finder(maxDistance);
+    const auto groups = finder.findGroups(photos);
+
+    std::map<int, std::size_t> groupOf;
+    for (std::size_t g = 0; g < groups.size(); g++)
+        for (const auto& delta: groups[g])
+            groupOf[delta.getId().value()] = g;
+
+    for (const auto& lhs: photos)
+        for (const auto& rhs: photos)
+        {
+            const auto distance = SimilarPhotosFinder::distance(lhs.get<Photo::Field::PHash>(), rhs.get<Photo::Field::PHash>());
+
+            if (lhs.getId() != rhs.getId() && distance <= maxDistance)
+            {
+                ASSERT_TRUE(groupOf.contains(lhs.getId().value()));
+                ASSERT_TRUE(groupOf.contains(rhs.getId().value()));
+                EXPECT_EQ(groupOf[lhs.getId().value()], groupOf[rhs.getId().value()]);
+            }
+        }
+}
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <QTime>
 
+#include "generic_sql_query_constructor.hpp"
 #include "sql_filter_query_generator.hpp"
 #include "unit_tests_utils/printers.hpp"
 
@@ -343,6 +344,43 @@ TEST(SqlFilterQueryGeneratorTest, FilterPhotosMatchingDoubleExpression)
 }
 
 
+namespace
+{
+    struct FullTextSearchQueryConstructor: Database::GenericSqlQueryConstructor
+    {
+        QString prepareFullTextSearchQuery(const QString& table, const QString& column, const QString& phrase) const override
+        {
+            return QString("SELECT id FROM %1_fts WHERE %2 MATCH '%3'").arg(table, column, phrase);
+        }
+    };
+}
+
+
+TEST(SqlFilterQueryGeneratorTest, FilterPhotosMatchingExpressionWithFullTextSearch)
+{
+    const FullTextSearchQueryConstructor queryConstructor;
+    Database::SqlFilterQueryGenerator generator(queryConstructor);
+
+    const SearchExpressionEvaluator::Expression expression = { {"Person 1", false}, {"Person 2", true} };
+    Database::FilterPhotosMatchingExpression filter(expression);
+
+    const QString query = generator.generate(filter);
+
+    const QString expected_query =
+        "SELECT photos.id FROM photos "
+        "WHERE photos.id IN "
+        "("
+            "SELECT photos.id FROM photos JOIN (tags) ON (photos.id = tags.photo_id) WHERE (tags.id IN (SELECT id FROM tags_fts WHERE value MATCH 'Person 1') OR tags.value = 'Person 2')"
+        ") "
+        "OR photos.id IN "
+        "("
+            "SELECT photos.id FROM photos JOIN (people, people_names) ON (photos.id = people.photo_id AND people.person_id = people_names.id) WHERE (people_names.id IN (SELECT id FROM people_names_fts WHERE name MATCH 'Person 1') OR people_names.name = 'Person 2')"
+        ")";
+
+    EXPECT_EQ(expected_query, query);
+}
+
+
 TEST(SqlFilterQueryGeneratorTest, FiltersPhotosByRegularRole)
 {
     Database::SqlFilterQueryGenerator generator;
@@ -405,3 +443,27 @@ TEST(SqlFilterQueryGeneratorTest, FiltersSimilarPhotos)
 
     EXPECT_EQ(query, expectedResult);
 }
+
+
+TEST(SqlFilterQueryGeneratorTest, FiltersPhotosInDirectories)
+{
+    Database::SqlFilterQueryGenerator generator;
+    Database::FilterPhotosInDirectories filter({"prj:/a", "prj:/it's/"});
+
+    const QString query = generator.generate(filter);
+
+    EXPECT_EQ(query, "SELECT photos.id FROM photos WHERE "
+                     "(photos.path > 'prj:/a/' AND photos.path < 'prj:/a0' AND INSTR(SUBSTR(photos.path, 8), '/') = 0) OR "
+                     "(photos.path > 'prj:/it''s/' AND photos.path < 'prj:/it''s0' AND INSTR(SUBSTR(photos.path, 11), '/') = 0)");
+}
+
+
+TEST(SqlFilterQueryGeneratorTest, FiltersPhotosInDirectoriesRecursively)
+{
+    Database::SqlFilterQueryGenerator generator;
+    Database::FilterPhotosInDirectories filter({"prj:/a"}, true);
+
+    const QString query = generator.generate(filter);
+
+    EXPECT_EQ(query, "SELECT photos.id FROM photos WHERE (photos.path > 'prj:/a/' AND photos.path < 'prj:/a0')");
+}
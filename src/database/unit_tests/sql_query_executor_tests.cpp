@@ -0,0 +1,95 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVariant>
+
+#include "sql_query_executor.hpp"
+#include "unit_tests_utils/empty_logger.hpp"
+
+
+namespace
+{
+    const QString connectionName = "SqlQueryExecutorTest";
+}
+
+
+class SqlQueryExecutorTest: public testing::Test
+{
+    public:
+        SqlQueryExecutorTest()
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+            db.setDatabaseName(":memory:");
+            db.open();
+
+            m_executor.set(&m_logger);
+            m_executor.set(std::this_thread::get_id());
+        }
+
+        ~SqlQueryExecutorTest()
+        {
+            m_executor.clearCache();
+
+            QSqlDatabase::database(connectionName).close();
+            QSqlDatabase::removeDatabase(connectionName);
+        }
+
+    protected:
+        EmptyLogger m_logger;
+        Database::SqlQueryExecutor m_executor;
+};
+
+
+TEST_F(SqlQueryExecutorTest, statementsAreReused)
+{
+    const QSqlDatabase db = QSqlDatabase::database(connectionName);
+
+    QSqlQuery& first = m_executor.cachedQuery(db, "SELECT :value");
+    first.bindValue(":value", 1);
+    ASSERT_TRUE(m_executor.exec(first));
+
+    QSqlQuery& second = m_executor.cachedQuery(db, "SELECT :value");
+    second.bindValue(":value", 2);
+    ASSERT_TRUE(m_executor.exec(second));
+    ASSERT_TRUE(second.next());
+
+    QSqlQuery& other = m_executor.cachedQuery(db, "SELECT :value + 1");
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &other);
+    EXPECT_EQ(second.value(0).toInt(), 2);
+    EXPECT_EQ(m_executor.cachedStatements(), 2);
+}
+
+
+TEST_F(SqlQueryExecutorTest, cacheIsDroppedWhenCleared)
+{
+    const QSqlDatabase db = QSqlDatabase::database(connectionName);
+
+    m_executor.cachedQuery(db, "SELECT 1");
+    m_executor.cachedQuery(db, "SELECT 2");
+    ASSERT_EQ(m_executor.cachedStatements(), 2);
+
+    m_executor.clearCache();
+
+    EXPECT_EQ(m_executor.cachedStatements(), 0);
+}
+
+
+TEST_F(SqlQueryExecutorTest, brokenStatementsAreNotCached)
+{
+    const QSqlDatabase db = QSqlDatabase::database(connectionName);
+    const QString statement = "SELECT value FROM test_table";
+
+    m_executor.cachedQuery(db, statement);                          // table does not exist yet
+    EXPECT_EQ(m_executor.cachedStatements(), 0);
+
+    QSqlQuery query(db);
+    ASSERT_TRUE(m_executor.exec("CREATE TABLE test_table(value INTEGER)", &query));
+
+    QSqlQuery& cached = m_executor.cachedQuery(db, statement);
+    EXPECT_TRUE(m_executor.exec(cached));
+    EXPECT_EQ(m_executor.cachedStatements(), 1);
+}
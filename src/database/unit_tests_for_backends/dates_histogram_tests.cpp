@@ -0,0 +1,52 @@
+#include <QDate>
+#include <QTime>
+
+#include "common.hpp"
+
+
+template<typename T>
+struct DatesHistogramTest: DatabaseTest<T>
+{
+
+};
+
+TYPED_TEST_SUITE(DatesHistogramTest, BackendTypes);
+
+
+TYPED_TEST(DatesHistogramTest, histogramFollowsChanges)
+{
+    Tag::TagsList tags1, tags2;
+    tags1.emplace(Tag::Types::Date, QDate(2020, 1, 1));
+    tags1.emplace(Tag::Types::Time, QTime(23, 59, 59));
+    tags2.emplace(Tag::Types::Date, QDate(2020, 1, 2));
+
+    Photo::DataDelta pd1, pd2, pd3, pd4;
+    pd1.insert<Photo::Field::Path>("photo1.jpeg");
+    pd1.insert<Photo::Field::Tags>(tags1);
+    pd2.insert<Photo::Field::Path>("photo2.jpeg");
+    pd2.insert<Photo::Field::Tags>(tags1);
+    pd3.insert<Photo::Field::Path>("photo3.jpeg");
+    pd3.insert<Photo::Field::Tags>(tags2);
+    pd4.insert<Photo::Field::Path>("photo4.jpeg");                      // no date
+
+    std::vector<Photo::DataDelta> photos = { pd1, pd2, pd3, pd4 };
+    this->m_backend->addPhotos(photos);
+
+    const std::map<QDate, int> initial = { {QDate(), 1}, {QDate(2020, 1, 1), 2}, {QDate(2020, 1, 2), 1} };
+    EXPECT_EQ(this->m_backend->getDatesHistogram(), initial);
+
+    // move photo to another day
+    Photo::DataDelta changed(photos[1].getId());
+    changed.insert<Photo::Field::Tags>(tags2);
+    this->m_backend->update({changed});
+
+    const std::map<QDate, int> afterUpdate = { {QDate(), 1}, {QDate(2020, 1, 1), 1}, {QDate(2020, 1, 2), 2} };
+    EXPECT_EQ(this->m_backend->getDatesHistogram(), afterUpdate);
+
+    // remove photos, days with no photos disappear
+    this->m_backend->photoOperator().removePhoto(photos[0].getId());
+    this->m_backend->photoOperator().removePhoto(photos[3].getId());
+
+    const std::map<QDate, int> afterRemoval = { {QDate(2020, 1, 2), 2} };
+    EXPECT_EQ(this->m_backend->getDatesHistogram(), afterRemoval);
+}
@@ -1,4 +1,7 @@
 
+#include <QDate>
+#include <QTime>
+
 #include "common.hpp"
 
 using testing::UnorderedElementsAreArray;
@@ -51,3 +54,79 @@ TYPED_TEST(FiltersTest, generalFlagsFilterTests)
         EXPECT_THAT(value55Photos, ElementsAre(ids.back()));
     }
 }
+
+
+TYPED_TEST(FiltersTest, directoriesFilterTests)
+{
+    Photo::DataDelta pd1, pd2, pd3, pd4;
+    pd1.insert<Photo::Field::Path>("prj:/photo1.jpeg");
+    pd2.insert<Photo::Field::Path>("prj:/a/photo2.jpeg");
+    pd3.insert<Photo::Field::Path>("prj:/a/b/photo3.jpeg");
+    pd4.insert<Photo::Field::Path>("prj:/ab/photo4.jpeg");
+
+    std::vector<Photo::DataDelta> photos = { pd1, pd2, pd3, pd4 };
+    this->m_backend->addPhotos(photos);
+
+    {
+        const Database::FilterPhotosInDirectories filter({"prj:/a"});
+        const auto ids = this->m_backend->photoOperator().getPhotos({filter});
+        EXPECT_THAT(ids, ElementsAre(photos[1].getId()));
+    }
+
+    {
+        const Database::FilterPhotosInDirectories filter({"prj:/a"}, true);
+        const auto ids = this->m_backend->photoOperator().getPhotos({filter});
+        EXPECT_THAT(ids, UnorderedElementsAreArray({photos[1].getId(), photos[2].getId()}));
+    }
+
+    {
+        const Database::FilterPhotosInDirectories filter({"prj:", "prj:/ab"});
+        const auto ids = this->m_backend->photoOperator().getPhotos({filter});
+        EXPECT_THAT(ids, UnorderedElementsAreArray({photos[0].getId(), photos[3].getId()}));
+    }
+}
+
+
+TYPED_TEST(FiltersTest, dateFilterTests)
+{
+    Tag::TagsList tags1, tags2, tags3;
+    tags1.emplace(Tag::Types::Date, QDate(2020, 1, 1));
+    tags1.emplace(Tag::Types::Time, QTime(10, 0, 0));
+    tags2.emplace(Tag::Types::Date, QDate(2020, 1, 2));
+    tags3.emplace(Tag::Types::Date, QDate(2020, 1, 3));
+    tags3.emplace(Tag::Types::Time, QTime(23, 59, 59));
+
+    Photo::DataDelta pd1, pd2, pd3, pd4;
+    pd1.insert<Photo::Field::Path>("photo1.jpeg");
+    pd1.insert<Photo::Field::Tags>(tags1);
+    pd2.insert<Photo::Field::Path>("photo2.jpeg");
+    pd2.insert<Photo::Field::Tags>(tags2);
+    pd3.insert<Photo::Field::Path>("photo3.jpeg");
+    pd3.insert<Photo::Field::Tags>(tags3);
+    pd4.insert<Photo::Field::Path>("photo4.jpeg");                      // no date
+
+    std::vector<Photo::DataDelta> photos = { pd1, pd2, pd3, pd4 };
+    this->m_backend->addPhotos(photos);
+
+    auto filtered = [this](const QDate& date, Database::ComparisonOp op, bool includeEmpty)
+    {
+        const Database::FilterPhotosWithTag filter(Tag::Types::Date, date, op, includeEmpty);
+
+        return this->m_backend->photoOperator().getPhotos({filter});
+    };
+
+    EXPECT_THAT(filtered(QDate(2020, 1, 2), Database::ComparisonOp::GreaterOrEqual, true),
+                UnorderedElementsAreArray({photos[1].getId(), photos[2].getId()}));
+
+    EXPECT_THAT(filtered(QDate(2020, 1, 2), Database::ComparisonOp::LessOrEqual, true),
+                UnorderedElementsAreArray({photos[0].getId(), photos[1].getId(), photos[3].getId()}));
+
+    EXPECT_THAT(filtered(QDate(2020, 1, 3), Database::ComparisonOp::Equal, false),
+                ElementsAre(photos[2].getId()));
+
+    EXPECT_THAT(filtered(QDate(2020, 1, 2), Database::ComparisonOp::Less, false),
+                ElementsAre(photos[0].getId()));
+
+    EXPECT_THAT(filtered(QDate(2020, 1, 1), Database::ComparisonOp::Greater, false),
+                UnorderedElementsAreArray({photos[1].getId(), photos[2].getId()}));
+}
@@ -74,3 +74,29 @@ TYPED_TEST(GeneralFlagsTest, setAndClearBits)
     this->m_backend->clearBits(id, "test1", 0x2);
     EXPECT_EQ(this->m_backend->get(id, "test1"), 0x11);
 }
+
+
+TYPED_TEST(GeneralFlagsTest, valuesOfAllPhotos)
+{
+    // store 3 photos
+    Photo::DataDelta pd1, pd2, pd3;
+    pd1.insert<Photo::Field::Path>("photo1.jpeg");
+    pd2.insert<Photo::Field::Path>("photo2.jpeg");
+    pd3.insert<Photo::Field::Path>("photo3.jpeg");
+
+    std::vector<Photo::DataDelta> photos = { pd1, pd2, pd3 };
+    this->m_backend->addPhotos(photos);
+
+    const auto id1 = photos[0].getId();
+    const auto id2 = photos[1].getId();
+    const auto id3 = photos[2].getId();
+
+    this->m_backend->set(id1, "test1", 5);
+    this->m_backend->set(id2, "test2", 6);
+    this->m_backend->set(id3, "test1", -7);
+
+    const std::map<Photo::Id, int> expected = { {id1, 5}, {id3, -7} };
+
+    EXPECT_EQ(this->m_backend->getFlagValues("test1"), expected);
+    EXPECT_TRUE(this->m_backend->getFlagValues("test3").empty());
+}
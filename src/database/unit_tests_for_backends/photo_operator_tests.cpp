@@ -1,3 +1,5 @@
+#include <QDate>
+#include <QTime>
 
 #include "database_tools/json_to_backend.hpp"
 #include "unit_tests_utils/sample_db.json.hpp"
@@ -88,6 +90,43 @@ TYPED_TEST(PhotoOperatorTest, sortingByTimestampActionOnPhotos)
 }
 
 
+TYPED_TEST(PhotoOperatorTest, sortingByTimestampFollowsDateChanges)
+{
+    auto dateTags = [](const QDate& date, const QTime& time)
+    {
+        Tag::TagsList tags;
+        tags.emplace(Tag::Types::Date, date);
+        tags.emplace(Tag::Types::Time, time);
+
+        return tags;
+    };
+
+    Photo::DataDelta pd1, pd2, pd3;
+    pd1.insert<Photo::Field::Path>("photo1.jpeg");
+    pd1.insert<Photo::Field::Tags>(dateTags(QDate(2021, 5, 1), QTime(12, 0, 0)));
+    pd2.insert<Photo::Field::Path>("photo2.jpeg");
+    pd2.insert<Photo::Field::Tags>(dateTags(QDate(2021, 5, 1), QTime(13, 0, 0)));
+    pd3.insert<Photo::Field::Path>("photo3.jpeg");
+    pd3.insert<Photo::Field::Tags>(dateTags(QDate(2021, 5, 2), QTime(8, 0, 0)));
+
+    std::vector<Photo::DataDelta> photos = { pd1, pd2, pd3 };
+    this->m_backend->addPhotos(photos);
+
+    const Database::Actions::Sort sort(Database::Actions::Sort::By::Timestamp, Qt::AscendingOrder);
+
+    EXPECT_THAT(this->m_backend->photoOperator().onPhotos({}, {sort}),
+                ElementsAre(photos[0].getId(), photos[1].getId(), photos[2].getId()));
+
+    // move last photo to the beginning of timeline
+    Photo::DataDelta update(photos[2].getId());
+    update.insert<Photo::Field::Tags>(dateTags(QDate(2021, 4, 30), QTime(23, 0, 0)));
+    this->m_backend->update({update});
+
+    EXPECT_THAT(this->m_backend->photoOperator().onPhotos({}, {sort}),
+                ElementsAre(photos[2].getId(), photos[0].getId(), photos[1].getId()));
+}
+
+
 TYPED_TEST(PhotoOperatorTest, sortingByPHash)
 {
     // fill backend with sample data
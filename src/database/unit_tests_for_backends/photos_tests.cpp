@@ -144,3 +144,108 @@ TYPED_TEST(PhotosTest, retrievingPartialDataInDelta)
         EXPECT_TRUE(same(photo, photoDelta));
     }
 }
+
+
+TYPED_TEST(PhotosTest, retrievingManyPhotosAtOnce)
+{
+    Database::JsonToBackend converter(*this->m_backend.get());
+    converter.append(RichDB::db1);
+
+    auto ids = this->m_backend->photoOperator().getPhotos(Database::EmptyFilter());
+    ASSERT_EQ(ids.size(), 3);
+
+    std::reverse(ids.begin(), ids.end());
+
+    const auto photoDeltas = this->m_backend->getPhotoDeltas(ids, {Photo::Field::Path, Photo::Field::Tags, Photo::Field::PHash});
+    ASSERT_EQ(photoDeltas.size(), 3);
+
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        auto photoDelta = photoDeltas[i];
+        const auto photo = this->m_backend->getPhoto(ids[i]);
+
+        EXPECT_TRUE(photoDelta.has(Photo::Field::Path));
+        EXPECT_TRUE(photoDelta.has(Photo::Field::Tags));
+        EXPECT_FALSE(photoDelta.has(Photo::Field::Flags));
+        EXPECT_FALSE(photoDelta.has(Photo::Field::Geometry));
+
+        EXPECT_TRUE(same(photo, photoDelta));
+    }
+}
+
+
+TYPED_TEST(PhotosTest, retrievingManyPhotosSkipsMissingOnes)
+{
+    Database::JsonToBackend converter(*this->m_backend.get());
+    converter.append(RichDB::db1);
+
+    auto ids = this->m_backend->photoOperator().getPhotos(Database::EmptyFilter());
+    ASSERT_EQ(ids.size(), 3);
+
+    this->m_backend->photoOperator().removePhoto(ids[1]);
+
+    const auto photoDeltas = this->m_backend->getPhotoDeltas(ids, {Photo::Field::Path});
+    ASSERT_EQ(photoDeltas.size(), 2);
+    EXPECT_EQ(photoDeltas[0].getId(), ids[0]);
+    EXPECT_EQ(photoDeltas[1].getId(), ids[2]);
+}
+
+
+TYPED_TEST(PhotosTest, idsOfRemovedPhotosAreNotReused)
+{
+    std::vector<Photo::DataDelta> photos(2);
+    photos[0].insert<Photo::Field::Path>("photo1.jpeg");
+    photos[1].insert<Photo::Field::Path>("photo2.jpeg");
+    ASSERT_TRUE(this->m_backend->addPhotos(photos));
+
+    // remove photo with the biggest id
+    const Photo::Id removed = photos[1].getId();
+    this->m_backend->photoOperator().removePhoto(removed);
+
+    std::vector<Photo::DataDelta> newPhotos(1);
+    newPhotos[0].insert<Photo::Field::Path>("photo3.jpeg");
+    ASSERT_TRUE(this->m_backend->addPhotos(newPhotos));
+
+    EXPECT_NE(newPhotos[0].getId(), removed);
+    EXPECT_NE(newPhotos[0].getId(), photos[0].getId());
+}
+
+
+TYPED_TEST(PhotosTest, retrievingPhotosMatchingFilter)
+{
+    Database::JsonToBackend converter(*this->m_backend.get());
+    converter.append(RichDB::db1);
+
+    const auto photoDeltas = this->m_backend->getPhotoDeltas(Database::EmptyFilter());
+    ASSERT_EQ(photoDeltas.size(), 3);
+
+    for (auto photoDelta: photoDeltas)
+    {
+        const auto photo = this->m_backend->getPhoto(photoDelta.getId());
+        const auto singlePhotoDelta = this->m_backend->getPhotoDelta(photoDelta.getId());
+
+        EXPECT_TRUE(same(photo, photoDelta));
+        EXPECT_EQ(photoDelta, singlePhotoDelta);
+    }
+}
+
+
+TYPED_TEST(PhotosTest, updatingPath)
+{
+    Database::JsonToBackend converter(*this->m_backend.get());
+    converter.append(RichDB::db1);
+
+    const auto ids = this->m_backend->photoOperator().getPhotos(Database::EmptyFilter());
+    ASSERT_FALSE(ids.empty());
+
+    const auto before = this->m_backend->getPhoto(ids.front());
+
+    Photo::DataDelta delta(ids.front());
+    delta.insert<Photo::Field::Path>("/some/new/path.jpeg");
+    this->m_backend->update({delta});
+
+    const auto after = this->m_backend->getPhoto(ids.front());
+
+    EXPECT_EQ(after.path, "/some/new/path.jpeg");
+    EXPECT_EQ(after.tags, before.tags);
+}
@@ -0,0 +1,95 @@
+#include <QDate>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+#include "backends/sql_backends/sqlite_backend/backend.hpp"
+#include "project_info.hpp"
+#include "unit_tests_utils/empty_logger.hpp"
+
+
+namespace
+{
+    bool tableExists(const QString& dbPath, const QString& table)
+    {
+        bool exists = false;
+
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "sqlite_backend_tests");
+            db.setDatabaseName(dbPath);
+            db.open();
+
+            QSqlQuery query(db);
+            query.exec(QString("SELECT name FROM sqlite_master WHERE name='%1';").arg(table));
+            exists = query.next();
+        }
+
+        QSqlDatabase::removeDatabase("sqlite_backend_tests");
+
+        return exists;
+    }
+}
+
+
+TEST(SQLiteBackendTest, partiallyCreatedFullTextIndexIsRemoved)
+{
+    QTemporaryDir wd;
+    const QString dbPath = wd.filePath("db");
+
+    // trigger with name used by full text index makes index creation fail in the middle
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "sqlite_backend_tests");
+        db.setDatabaseName(dbPath);
+        ASSERT_TRUE(db.open());
+
+        QSqlQuery query(db);
+        ASSERT_TRUE(query.exec("CREATE TABLE blocker(id INTEGER);"));
+        ASSERT_TRUE(query.exec("CREATE TRIGGER tags_fts_au AFTER INSERT ON blocker BEGIN SELECT 1; END;"));
+    }
+    QSqlDatabase::removeDatabase("sqlite_backend_tests");
+
+    EmptyLogger logger;
+
+    {
+        Database::SQLiteBackend backend(nullptr, &logger);
+        EXPECT_TRUE(backend.init(Database::ProjectInfo(dbPath, "SQLite")));
+        backend.closeConnections();
+    }
+
+    EXPECT_FALSE(tableExists(dbPath, "tags_fts"));
+}
+
+
+TEST(SQLiteBackendTest, readOnlyBackendSeesCurrentDatesHistogram)
+{
+    QTemporaryDir wd;
+    const Database::ProjectInfo prjInfo(wd.filePath("db"), "SQLite");
+
+    EmptyLogger logger;
+    Database::SQLiteBackend writer(nullptr, &logger);
+    Database::SQLiteBackend reader(nullptr, &logger, Database::ASqlBackend::AccessMode::ReadOnly);
+
+    ASSERT_TRUE(writer.init(prjInfo));
+    ASSERT_TRUE(reader.init(prjInfo));
+
+    auto addPhoto = [&writer](const QString& path, const QDate& date)
+    {
+        Photo::DataDelta photo;
+        photo.insert<Photo::Field::Path>(path);
+        photo.insert<Photo::Field::Tags>(Tag::TagsList{ {Tag::Types::Date, date} });
+
+        std::vector<Photo::DataDelta> photos = { photo };
+        writer.addPhotos(photos);
+    };
+
+    addPhoto("photo1.jpeg", QDate(2020, 1, 1));
+    EXPECT_EQ(reader.getDatesHistogram(), (std::map<QDate, int>{ {QDate(2020, 1, 1), 1} }));
+
+    // changes made by other connection are visible
+    addPhoto("photo2.jpeg", QDate(2020, 1, 2));
+    EXPECT_EQ(reader.getDatesHistogram(), (std::map<QDate, int>{ {QDate(2020, 1, 1), 1}, {QDate(2020, 1, 2), 1} }));
+
+    reader.closeConnections();
+    writer.closeConnections();
+}
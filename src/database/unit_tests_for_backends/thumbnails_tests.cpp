@@ -56,3 +56,35 @@ TYPED_TEST(ThumbnailsTest, emptyResultWhenMissing)
 
     EXPECT_TRUE(thumbnail.isEmpty());
 }
+
+
+TYPED_TEST(ThumbnailsTest, takingThumbnailsRemovesThemFromDatabase)
+{
+    std::vector<Photo::DataDelta> photos;
+
+    for(int i = 0; i < 5; i++)
+    {
+        Photo::DataDelta photo;
+        photo.insert<Photo::Field::Path>(QString("/path/photo%1.jpeg").arg(i));
+        photos.push_back(photo);
+    }
+
+    this->m_backend->addPhotos(photos);
+
+    for(const auto& photo: photos)
+        this->m_backend->setThumbnail(photo.getId(), QByteArray::number(photo.getId().value()));
+
+    const auto firstChunk = this->m_backend->takeThumbnails(3);
+    const auto secondChunk = this->m_backend->takeThumbnails(3);
+    const auto thirdChunk = this->m_backend->takeThumbnails(3);
+
+    EXPECT_EQ(firstChunk.size(), 3);
+    EXPECT_EQ(secondChunk.size(), 2);
+    EXPECT_TRUE(thirdChunk.empty());
+
+    for(const auto& [id, data]: firstChunk)
+    {
+        EXPECT_EQ(data, QByteArray::number(id.value()));
+        EXPECT_TRUE(this->m_backend->getThumbnail(id).isEmpty());
+    }
+}
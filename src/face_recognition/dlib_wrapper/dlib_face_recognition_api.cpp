@@ -123,6 +123,15 @@ namespace dlib_api
             return qrects;
         }
 
+        // shape_predictor is used in read only mode, so one instance can be shared between threads
+        template<const char* model>
+        const dlib::shape_predictor& shared_shape_predictor()
+        {
+            static const dlib::shape_predictor predictor = ObjectDeserializer<dlib::shape_predictor, model>()();
+
+            return predictor;
+        }
+
         cnn_face_detection_model_v1* construct_cnn_face_detector()
         {
             const auto cnn_face_detection_model = modelPath<human_face_model>();
@@ -150,7 +159,7 @@ namespace dlib_api
 
 
     FaceLocator::FaceLocator(ILogger* logger):
-        m_data(std::make_unique<Data>(logger, has_hardware_accelearion()))
+        m_data(std::make_unique<Data>(logger, uses_hardware_acceleration()))
     {
         if (m_data->cuda_available == false)
             m_data->logger->warning("No CUDA devices. Hardware acceleration disabled.");
@@ -318,16 +327,12 @@ namespace dlib_api
     {
         Data(ILogger* log)
             : face_encoder( modelPath<face_recognition_model>().toStdString() )
-            , logger(log)
+            , logger(log->subLogger("FaceEncoder"))
         {
         }
 
         face_recognition_model_v1 face_encoder;
-
-        lazy_ptr<dlib::shape_predictor, ObjectDeserializer<dlib::shape_predictor, predictor_5_point_model>> predictor_5_point;
-        lazy_ptr<dlib::shape_predictor, ObjectDeserializer<dlib::shape_predictor, predictor_68_point_model>> predictor_68_point;
-
-        ILogger* logger;
+        std::unique_ptr<ILogger> logger;
     };
 
 
@@ -356,8 +361,8 @@ namespace dlib_api
 
         const dlib::rectangle face_location(0, 0, size.width() - 1 , size.height() -1);
         const dlib::shape_predictor& pose_predictor = model == Large?
-                                                      *m_data->predictor_68_point :
-                                                      *m_data->predictor_5_point;
+                                                      shared_shape_predictor<predictor_68_point_model>() :
+                                                      shared_shape_predictor<predictor_5_point_model>();
 
         const auto image = qimage_to_dlib_matrix(qimage);
         const auto object_detection = pose_predictor(image, face_location);
@@ -402,19 +407,17 @@ namespace dlib_api
             const std::size_t size = std::min(face_encoding.size(), face_to_compare.size());
             assert(size == 128);
 
-            std::vector<double> diff(size, 0.0);
-
-            for(std::size_t i = 0; i < size; i++)
-                diff[i] = face_encoding[i] - face_to_compare[i];
-
-            // calculating 2-norm from `diff` as in original python code
+            // calculating 2-norm from difference of encodings as in original python code
             // https://docs.scipy.org/doc/numpy/reference/generated/numpy.linalg.norm.html#numpy.linalg.norm
             // https://en.wikipedia.org/wiki/Norm_(mathematics)  -> p-norm
 
-            const double norm_squared = std::accumulate(diff.begin(), diff.end(), 0.0, [](double sum, double v)
+            double norm_squared = 0.0;
+
+            for(std::size_t i = 0; i < size; i++)
             {
-                return sum + std::fabs(v) * std::fabs(v);
-            });
+                const double diff = face_encoding[i] - face_to_compare[i];
+                norm_squared += diff * diff;
+            }
 
             const double norm = std::sqrt(norm_squared);
 
@@ -433,4 +436,12 @@ namespace dlib_api
             return true;
     }
 
+
+    bool uses_hardware_acceleration()
+    {
+        static const bool acceleration = has_hardware_accelearion();
+
+        return acceleration;
+    }
+
 }
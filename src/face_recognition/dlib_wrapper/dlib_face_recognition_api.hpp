@@ -26,7 +26,8 @@ namespace dlib_api
 
     typedef std::vector<double> FaceEncodings;
 
-    // FaceLocator may be a very heavy object. Delete it as soon as it is not needed.
+    // FaceLocator may be a very heavy object.
+    // It is not thread safe, but it can be reused by one thread for many images.
     // based on:
     // https://github.com/ageitgey/face_recognition/blob/5fe85a1a8cbd1b994b505464b555d12cd25eee5f/face_recognition/api.py#L108
     class DLIB_WRAPPER_EXPORT FaceLocator
@@ -51,6 +52,9 @@ namespace dlib_api
             std::optional<QVector<QRect>> _face_locations_hog(const QImage &, int);
     };
 
+    // FaceEncoder loads face recognition model on construction.
+    // It is not thread safe, but it can be reused by one thread for many faces.
+    // Shape predictors are shared between all instances.
     class DLIB_WRAPPER_EXPORT FaceEncoder
     {
         public:
@@ -79,6 +83,12 @@ namespace dlib_api
      * we cannot work - dlib will crash/throw on CUDA usage
      */
     DLIB_WRAPPER_EXPORT bool check_system_prerequisites();
+
+    /**
+     * @brief check if dlib is going to use CUDA
+     * @return true if CUDA devices are available and dlib was built with CUDA support.
+     */
+    DLIB_WRAPPER_EXPORT bool uses_hardware_acceleration();
 }
 
 #endif // DLIB_FACE_RECOGNITION_API_HPP_INCLUDED
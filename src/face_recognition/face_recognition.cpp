@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <QByteArray>
@@ -52,7 +53,39 @@ using namespace std::placeholders;
 
 namespace
 {
-    std::mutex g_dlibMutex;   // global mutex for dlib usage.
+    std::mutex g_gpuMutex;    // GPU memory is limited, so when CUDA is used, dlib is used by one thread at a time.
+
+    // dlib models are expensive to load and are not thread safe.
+    // Keep them per thread, so each worker loads them once and can use them in parallel with other workers.
+    dlib_api::FaceLocator& threadFaceLocator(ILogger* logger)
+    {
+        thread_local std::unique_ptr<dlib_api::FaceLocator> locator;
+
+        if (locator.get() == nullptr)
+            locator = std::make_unique<dlib_api::FaceLocator>(logger);
+
+        return *locator;
+    }
+
+    dlib_api::FaceEncoder& threadFaceEncoder(ILogger* logger)
+    {
+        thread_local std::unique_ptr<dlib_api::FaceEncoder> encoder;
+
+        if (encoder.get() == nullptr)
+            encoder = std::make_unique<dlib_api::FaceEncoder>(logger);
+
+        return *encoder;
+    }
+
+    std::unique_lock<std::mutex> lockGpu()
+    {
+        std::unique_lock lock(g_gpuMutex, std::defer_lock);
+
+        if (dlib_api::uses_hardware_acceleration())
+            lock.lock();
+
+        return lock;
+    }
 
     int chooseClosestMatching(const std::vector<double>& distances)
     {
@@ -129,7 +162,8 @@ Person::Fingerprint FaceRecognition::getFingerprint(const OrientedImage& image,
 {
     const QImage face = face_rect.isEmpty()? image.get(): image.get().copy(face_rect);
 
-    dlib_api::FaceEncoder faceEndoder(m_data->m_logger.get());
+    auto lock = lockGpu();
+    dlib_api::FaceEncoder& faceEndoder = threadFaceEncoder(m_data->m_logger.get());
     const dlib_api::FaceEncodings face_encodings = faceEndoder.face_encodings(face);
 
     return face_encodings;
@@ -147,13 +181,13 @@ int FaceRecognition::recognize(const Person::Fingerprint& unknown, const std::ve
 
 QVector<QRect> FaceRecognition::fetchFaces(const OrientedImage& orientedPhoto, double scale) const
 {
-    std::lock_guard lock(g_dlibMutex);
     QVector<QRect> result;
 
     const QSize scaledSize = orientedPhoto.get().size() * scale;
     const QImage photo = orientedPhoto.get().scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
-    result = dlib_api::FaceLocator(m_data->m_logger.get()).face_locations(photo, 0);
+    auto lock = lockGpu();
+    result = threadFaceLocator(m_data->m_logger.get()).face_locations(photo, 0);
 
     std::transform(result.begin(), result.end(), result.begin(), [scale](const QRect& face){
         return QRect(face.topLeft().x() / scale, face.topLeft().y() / scale,
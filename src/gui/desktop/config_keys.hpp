@@ -18,4 +18,14 @@ namespace UpdateConfigKeys
     const char* const lastCheck       = "updater::last_check";
 }
 
+namespace CollectionConfigKeys
+{
+    const char* const monitorChanges  = "collection::monitor_changes";
+}
+
+namespace ThumbnailsConfigKeys
+{
+    const char* const memoryCacheSize = "thumbnails::memory_cache_size";     // in MiB
+}
+
 #endif // CONFIG_KEYS_HPP
@@ -29,6 +29,12 @@ QCheckBox* MainTab::updateCheckBox()
 }
 
 
+QCheckBox* MainTab::monitorCheckBox()
+{
+    return ui->monitorCheckBox;
+}
+
+
 MainTabController::MainTabController(): m_configuration(nullptr), m_tabWidget(nullptr)
 {
 
@@ -66,7 +72,10 @@ QWidget* MainTabController::constructTab()
 
     const auto enabled = m_configuration->getEntry(UpdateConfigKeys::updateEnabled);
 
+    const auto monitor = m_configuration->getEntry(CollectionConfigKeys::monitorChanges);
+
     m_tabWidget->updateCheckBox()->setChecked(enabled.toBool());
+    m_tabWidget->monitorCheckBox()->setChecked(monitor.toBool());
 
     return m_tabWidget;
 }
@@ -75,8 +84,10 @@ QWidget* MainTabController::constructTab()
 void MainTabController::applyConfiguration()
 {
     const bool enabled = m_tabWidget->updateCheckBox()->checkState() == Qt::Checked;
+    const bool monitor = m_tabWidget->monitorCheckBox()->checkState() == Qt::Checked;
 
     m_configuration->setEntry(UpdateConfigKeys::updateEnabled, enabled);
+    m_configuration->setEntry(CollectionConfigKeys::monitorChanges, monitor);
 }
 
 
@@ -27,6 +27,7 @@ class MainTab: public QWidget
         MainTab& operator=(const MainTab &) = delete;
 
         QCheckBox* updateCheckBox();
+        QCheckBox* monitorCheckBox();
 
     private:
         Ui::MainTab *ui;
@@ -24,6 +24,7 @@
 #include <updater/updater.hpp>
 #endif
 
+#include "config_keys.hpp"
 #include "ui/mainwindow.hpp"
 #include "quick_items/objects_accessor.hpp"
 #include "utils/features_manager.hpp"
@@ -111,20 +112,23 @@ void Gui::run()
 
     // defaults
 #ifdef OS_WIN
-    configuration.setDefaultValue(ExternalToolsConfigKeys::aisPath, FileSystem().getDataPath() + "/tools/Hugin/align_image_stack.exe");
     configuration.setDefaultValue(ExternalToolsConfigKeys::magickPath, FileSystem().getDataPath() + "/tools/ImageMagick/magick.exe");
     configuration.setDefaultValue(ExternalToolsConfigKeys::ffmpegPath, FileSystem().getDataPath() + "/tools/FFMpeg/bin/ffmpeg.exe");
     configuration.setDefaultValue(ExternalToolsConfigKeys::exiftoolPath, FileSystem().getDataPath() + "/tools/ExifTool/exiftool.exe");
 #else
-    configuration.setDefaultValue(ExternalToolsConfigKeys::aisPath, QStandardPaths::findExecutable("align_image_stack"));
     configuration.setDefaultValue(ExternalToolsConfigKeys::magickPath, QStandardPaths::findExecutable("magick"));
     configuration.setDefaultValue(ExternalToolsConfigKeys::ffmpegPath, QStandardPaths::findExecutable("ffmpeg"));
     configuration.setDefaultValue(ExternalToolsConfigKeys::exiftoolPath, QStandardPaths::findExecutable("exiftool"));
 #endif
+    configuration.setDefaultValue(ThumbnailsConfigKeys::memoryCacheSize, 64);
 
     //
     auto thumbnail_generator_logger = loggerFactory.get("ThumbnailGenerator");
-    ThumbnailsCache thumbnailsCache;
+    ThumbnailsCache thumbnailsCache(configuration.getEntry(ThumbnailsConfigKeys::memoryCacheSize).toLongLong() * 1024 * 1024);
+    configuration.watchFor(ThumbnailsConfigKeys::memoryCacheSize, [&thumbnailsCache](const QString &, const QVariant& value)
+    {
+        thumbnailsCache.setBudget(value.toLongLong() * 1024 * 1024);
+    });
     ThumbnailGenerator thumbnailGenerator(thumbnail_generator_logger.get(), &configuration);
     ThumbnailManager thbMgr(&m_coreFactory.getTaskExecutor(), thumbnailGenerator, thumbnailsCache, loggerFactory.get("ThumbnailManager"));
 
@@ -1,6 +1,7 @@
 
 #include <core/function_wrappers.hpp>
 #include <core/qmodel_utils.hpp>
+#include <database/database_tools/similar_photos_finder.hpp>
 #include <database/iphoto_operator.hpp>
 #include <database/photo_utils.hpp>
 
@@ -55,6 +56,17 @@ void DuplicatesModel::setDB(Database::IDatabase* db)
 }
 
 
+void DuplicatesModel::setMaxPHashDistance(int distance)
+{
+    if (m_maxPHashDistance != distance)
+    {
+        m_maxPHashDistance = distance;
+
+        emit maxPHashDistanceChanged(distance);
+    }
+}
+
+
 bool DuplicatesModel::isWorking() const
 {
     return m_workInProgress;
@@ -68,6 +80,12 @@ Database::IDatabase * DuplicatesModel::db() const
 }
 
 
+int DuplicatesModel::maxPHashDistance() const
+{
+    return m_maxPHashDistance;
+}
+
+
 void DuplicatesModel::reloadDuplicates()
 {
     if (m_db && m_workInProgress == false)
@@ -76,19 +94,16 @@ void DuplicatesModel::reloadDuplicates()
 
         setWorkInProgress(true);
 
-        auto resultCallback = make_cross_thread_function<std::vector<Photo::DataDelta>>(this, &DuplicatesModel::compileDuplicates);
+        auto resultCallback = make_cross_thread_function<std::vector<std::vector<Photo::DataDelta>>>(this, &DuplicatesModel::setDuplicates);
 
-        m_db->exec([resultCallback](Database::IBackend& backend)
+        m_db->execRead([resultCallback, maxDistance = m_maxPHashDistance](Database::IBackend& backend)
         {
-            const auto ids = backend.photoOperator().onPhotos(Database::FilterSimilarPhotos{}, Database::Actions::Sort(Database::Actions::Sort::By::PHash));
-
-            std::vector<Photo::DataDelta> data;
-            data.reserve(ids.size());
+            const std::vector<Photo::DataDelta> data = backend.getPhotoDeltas(Database::FilterPhotosWithPHash{}, {Photo::Field::PHash, Photo::Field::Path});
 
-            for(const auto& id: ids)
-                data.push_back(backend.getPhotoDelta(id, {Photo::Field::PHash, Photo::Field::Path}));
+            const SimilarPhotosFinder finder(maxDistance);
+            const auto groups = finder.findGroups(data);
 
-            resultCallback(data);
+            resultCallback(groups);
         },
         "Looking for photo duplicates"
         );
@@ -96,22 +111,9 @@ void DuplicatesModel::reloadDuplicates()
 }
 
 
-void DuplicatesModel::compileDuplicates(const std::vector<Photo::DataDelta>& duplicatePhotos)
+void DuplicatesModel::setDuplicates(const std::vector<std::vector<Photo::DataDelta>>& duplicates)
 {
-    std::vector<std::vector<Photo::DataDelta>> grouped;
-
-    for(auto it = duplicatePhotos.begin(); it != duplicatePhotos.end();)
-    {
-        const auto currentPHash = it->get<Photo::Field::PHash>();
-
-        auto nextIt = std::find_if_not(it, duplicatePhotos.end(), [&currentPHash](const Photo::DataDelta& data) {
-            return data.get<Photo::Field::PHash>() == currentPHash;
-        });
-
-        grouped.push_back(std::vector(it, nextIt));
-
-        it = nextIt;
-    }
+    std::vector<std::vector<Photo::DataDelta>> grouped = duplicates;
 
     beginInsertRows({}, 0, grouped.size() - 1);
     m_duplicates.swap(grouped);
@@ -12,6 +12,7 @@ class DuplicatesModel: public QAbstractListModel
     Q_OBJECT
     Q_PROPERTY(Database::IDatabase* database READ db WRITE setDB NOTIFY dbChanged)
     Q_PROPERTY(bool workInProgress READ isWorking NOTIFY workStatusChanged)
+    Q_PROPERTY(int maxPHashDistance READ maxPHashDistance WRITE setMaxPHashDistance NOTIFY maxPHashDistanceChanged)
 
 public:
     QVariant data(const QModelIndex& index, int role) const override;
@@ -19,8 +20,10 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
     void setDB(Database::IDatabase *);
+    void setMaxPHashDistance(int);
     bool isWorking() const;
     Database::IDatabase* db() const;
+    int maxPHashDistance() const;
 
     Q_INVOKABLE void reloadDuplicates();
 
@@ -28,14 +31,16 @@ private:
     std::vector<std::vector<Photo::DataDelta>> m_duplicates;
     Database::IDatabase* m_db = nullptr;
     bool m_workInProgress = false;
+    int m_maxPHashDistance = 4;             // max number of different bits in phashes of similar photos
 
-    void compileDuplicates(const std::vector<Photo::DataDelta> &);
+    void setDuplicates(const std::vector<std::vector<Photo::DataDelta>> &);
     void setWorkInProgress(bool);
     void clear();
 
 signals:
     void dbChanged() const;
     void workStatusChanged(bool) const;
+    void maxPHashDistanceChanged(int) const;
 };
 
 #endif
@@ -105,10 +105,7 @@ void FlatModel::setDatabase(Database::IDatabase* db)
 
 void FlatModel::setFilter(const Database::Filter& filters)
 {
-    {
-        std::lock_guard<std::mutex> lock(m_filtersMutex);
-        m_filters = filters;
-    }
+    m_filters = filters;
 
     updatePhotos();
 }
@@ -208,16 +205,23 @@ Photo::Id FlatModel::getId(int row) const
 void FlatModel::reloadPhotos()
 {
     resetModel();
-
-    if (m_db != nullptr)
-        m_db->exec(std::bind(&FlatModel::fetchMatchingPhotos, this, _1));
+    updatePhotos();
 }
 
 
 void FlatModel::updatePhotos()
 {
     if (m_db != nullptr)
-        m_db->exec(std::bind(&FlatModel::fetchMatchingPhotos, this, _1));
+    {
+        // Reader threads may finish queries in any order.
+        // Generation is used to recognize results of the most recent request.
+        const std::size_t generation = ++m_fetchGeneration;
+
+        m_db->execRead([this, filters = m_filters, generation](Database::IBackend& backend)
+        {
+            fetchMatchingPhotos(backend, filters, generation);
+        });
+    }
 }
 
 
@@ -285,14 +289,6 @@ void FlatModel::invalidatePhotos(const std::set<Photo::Id>& ids)
 }
 
 
-const Database::Filter& FlatModel::filters() const
-{
-    std::lock_guard<std::mutex> lock(m_filtersMutex);
-
-    return m_filters;
-}
-
-
 const Photo::DataDelta& FlatModel::photoData(const Photo::Id& id) const
 {
     assert(m_idToRow.find(id) != m_idToRow.end());
@@ -309,39 +305,61 @@ const Photo::DataDelta& FlatModel::photoData(const Photo::Id& id) const
 }
 
 
-//TODO: consider grouping queries
 void FlatModel::fetchPhotoData(const Photo::Id& id) const
 {
-    auto b = std::bind(qOverload<Database::IBackend &, const Photo::Id &>(&FlatModel::fetchPhotoProperties), this, _1, id);
+    bool scheduleFetch = false;
 
-    m_db->exec(b);
+    {
+        std::lock_guard<std::mutex> lock(m_propertiesToFetchMutex);
+
+        // there is a pending task for fetching properties? Let it fetch this one also
+        scheduleFetch = m_propertiesToFetch.empty();
+        m_propertiesToFetch.push_back(id);
+    }
+
+    if (scheduleFetch)
+    {
+        auto b = std::bind(&FlatModel::fetchPhotoProperties, this, _1);
+
+        m_db->execRead(b);
+    }
 }
 
 
-void FlatModel::fetchMatchingPhotos(Database::IBackend& backend)
+void FlatModel::fetchMatchingPhotos(Database::IBackend& backend, const Database::Filter& filters, std::size_t generation)
 {
     const Database::Actions::GroupAction sort_action({
         Database::Actions::Sort(Database::Actions::Sort::By::Timestamp),
         Database::Actions::Sort(Database::Actions::Sort::By::ID)
     });
 
-    const auto view_filters = filters();
-    const auto photos = backend.photoOperator().onPhotos(view_filters, sort_action);
+    const auto photos = backend.photoOperator().onPhotos(filters, sort_action);
 
-    invokeMethod(this, &FlatModel::fetchedPhotos, photos);
+    invokeMethod(this, &FlatModel::fetchedPhotos, photos, generation);
 }
 
 
-void FlatModel::fetchPhotoProperties(Database::IBackend& backend, const Photo::Id& id) const
+void FlatModel::fetchPhotoProperties(Database::IBackend& backend) const
 {
-    auto photo = backend.getPhotoDelta(id, {Photo::Field::Path, Photo::Field::Flags, Photo::Field::GroupInfo});
+    std::vector<Photo::Id> ids;
 
-    invokeMethod(const_cast<FlatModel*>(this), &FlatModel::fetchedPhotoProperties, id, photo);
+    {
+        std::lock_guard<std::mutex> lock(m_propertiesToFetchMutex);
+        ids.swap(m_propertiesToFetch);
+    }
+
+    const auto photos = backend.getPhotoDeltas(ids, {Photo::Field::Path, Photo::Field::Flags, Photo::Field::GroupInfo});
+
+    invokeMethod(const_cast<FlatModel*>(this), &FlatModel::fetchedPhotoProperties, photos);
 }
 
 
-void FlatModel::fetchedPhotos(const std::vector<Photo::Id>& photos)
+void FlatModel::fetchedPhotos(const std::vector<Photo::Id>& photos, std::size_t generation)
 {
+    // results of outdated request, newer one is on its way
+    if (generation != m_fetchGeneration)
+        return;
+
     auto last_new_it = [&photos](){ return photos.end(); };
     auto last_old_it = [this](){ return m_photos.end(); };
     auto new_photos_it = photos.begin();
@@ -424,18 +442,22 @@ void FlatModel::fetchedPhotos(const std::vector<Photo::Id>& photos)
 }
 
 
-void FlatModel::fetchedPhotoProperties(const Photo::Id& id, const Photo::DataDelta& properties)
+void FlatModel::fetchedPhotoProperties(const std::vector<Photo::DataDelta>& photos)
 {
-    auto it = m_idToRow.find(id);
-
-    // photo may have been removed from model in the meantime (between fetchPhotoProperties and fetchedPhotoProperties execution)
-    if (it != m_idToRow.end())
+    for (const Photo::DataDelta& properties: photos)
     {
-        const int row = it->second;
-        m_properties[id] = properties;
+        const Photo::Id& id = properties.getId();
+        auto it = m_idToRow.find(id);
 
-        const QModelIndex idx = createIndex(row, 0);
-        emit dataChanged(idx, idx, {PhotoDataRole});
+        // photo may have been removed from model in the meantime (between fetchPhotoProperties and fetchedPhotoProperties execution)
+        if (it != m_idToRow.end())
+        {
+            const int row = it->second;
+            m_properties[id] = properties;
+
+            const QModelIndex idx = createIndex(row, 0);
+            emit dataChanged(idx, idx, {PhotoDataRole});
+        }
     }
 }
 
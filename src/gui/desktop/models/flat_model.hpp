@@ -61,10 +61,12 @@ class FlatModel: public APhotoDataModel
     private:
         Database::Filter m_filters;
         std::vector<Photo::Id> m_photos;
-        mutable std::mutex m_filtersMutex;
         mutable std::map<Photo::Id, int> m_idToRow;
         mutable std::map<Photo::Id, Photo::DataDelta> m_properties;
+        mutable std::vector<Photo::Id> m_propertiesToFetch;
+        mutable std::mutex m_propertiesToFetchMutex;
         Database::IDatabase* m_db;
+        std::size_t m_fetchGeneration = 0;
 
         void reloadPhotos();
         void updatePhotos();
@@ -72,18 +74,17 @@ class FlatModel: public APhotoDataModel
         void resetModel();
         void removePhotos(const std::vector<Photo::Id> &);
         void invalidatePhotos(const std::set<Photo::Id> &);
-        const Database::Filter& filters() const;
 
         const Photo::DataDelta& photoData(const Photo::Id &) const;
         void fetchPhotoData(const Photo::Id &) const;
 
         // methods working on backend
-        void fetchMatchingPhotos(Database::IBackend &);
-        void fetchPhotoProperties(Database::IBackend &, const Photo::Id &) const;
+        void fetchMatchingPhotos(Database::IBackend &, const Database::Filter &, std::size_t generation);
+        void fetchPhotoProperties(Database::IBackend &) const;
 
         // results from backend
-        void fetchedPhotos(const std::vector<Photo::Id> &);
-        void fetchedPhotoProperties(const Photo::Id &, const Photo::DataDelta &);
+        void fetchedPhotos(const std::vector<Photo::Id> &, std::size_t generation);
+        void fetchedPhotoProperties(const std::vector<Photo::DataDelta> &);
 
         // altering model
         template<typename T>
@@ -26,14 +26,16 @@ SeriesModel::SeriesModel()
     , m_project()
     , m_core()
 {
-
+    // candidates are delivered in portions, as soon as they are found
+    connect(&m_candidatesWatcher, &QFutureWatcher<std::vector<GroupCandidate>>::resultsReadyAt, this, &SeriesModel::appendCandidates);
+    connect(&m_candidatesWatcher, &QFutureWatcher<std::vector<GroupCandidate>>::finished, this, &SeriesModel::fetchingFinished);
 }
 
 
 SeriesModel::~SeriesModel()
 {
-    m_candidatesFuture.cancel();
-    m_candidatesFuture.waitForFinished();
+    m_candidatesWatcher.cancel();
+    m_candidatesWatcher.waitForFinished();
 }
 
 
@@ -162,35 +164,50 @@ void SeriesModel::fetchGroups()
 
     auto& executor = m_core->getTaskExecutor();
 
-    m_candidatesFuture = runOn<std::vector<GroupCandidate>>
+    const auto future = runOn<std::vector<GroupCandidate>>
     (
         executor,
-        [this](QPromise<std::vector<GroupCandidate>>& promise)
+        [this, &executor](QPromise<std::vector<GroupCandidate>>& promise)
         {
             IExifReaderFactory& exif = m_core->getExifReaderFactory();
 
             QElapsedTimer timer;
 
             auto detectLogger = m_logger->subLogger("SeriesDetector");
-            SeriesDetector detector(*detectLogger, m_project->getDatabase(), exif.get(), &promise);
+            SeriesDetector detector(*detectLogger, m_project->getDatabase(), exif.get(), &executor, &promise);
 
+            // results are reported by detector through promise
             timer.start();
-            promise.addResult(detector.listCandidates());
+            detector.listCandidates();
             m_logger->debug(QString("Photos analysis took %1s").arg(timer.elapsed()/1000.0));
         },
         "SeriesDetector"
     );
 
-    m_candidatesFuture.then(std::bind(&SeriesModel::updateModel, this, _1));
+    m_candidatesWatcher.setFuture(future);
+}
+
+
+void SeriesModel::appendCandidates(int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        const std::vector<GroupCandidate> candidates = m_candidatesWatcher.resultAt(i);
+
+        if (candidates.empty())
+            continue;
+
+        const int first = rowCount({});
+        beginInsertRows({}, first, first + static_cast<int>(candidates.size()) - 1);
+        m_candidates.insert(m_candidates.end(), candidates.begin(), candidates.end());
+        endInsertRows();
+    }
 }
 
 
-void SeriesModel::updateModel(const std::vector<GroupCandidate>& canditates)
+void SeriesModel::fetchingFinished()
 {
-    beginInsertRows({}, 0, canditates.size() - 1);
-    m_candidates = canditates;
-    m_logger->info(QString("Got %1 group canditates").arg(canditates.size()));
-    endInsertRows();
+    m_logger->info(QString("Got %1 group canditates").arg(m_candidates.size()));
 
     setState(State::Loaded);
 }
@@ -3,7 +3,7 @@
 #define SERIESMODEL_HPP
 
 #include <QAbstractItemModel>
-#include <QFuture>
+#include <QFutureWatcher>
 
 #include <core/icore_factory_accessor.hpp>
 #include <core/itasks_view.hpp>
@@ -62,12 +62,13 @@ private:
     std::vector<GroupCandidate> m_candidates;
     Project* m_project = nullptr;
     ICoreFactoryAccessor* m_core = nullptr;
-    QFuture<std::vector<GroupCandidate>> m_candidatesFuture;
+    QFutureWatcher<std::vector<GroupCandidate>> m_candidatesWatcher;
     State m_state = Idle;
 
     void setState(State);
     void fetchGroups();
-    void updateModel(const std::vector<GroupCandidate> &);
+    void appendCandidates(int begin, int end);
+    void fetchingFinished();
     void clear();
 };
 
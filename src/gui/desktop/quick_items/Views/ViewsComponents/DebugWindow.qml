@@ -14,6 +14,10 @@ Item {
             model: ObservablesRegistry.executors
 
             Column {
+                id: executorInfo
+
+                property var statistics: modelData.statistics
+
                 Text {
                     text: modelData.name
                     font.bold: true
@@ -30,6 +34,14 @@ Item {
                 Text {
                     text: qsTr("Execution speed")+ ": " + modelData.executionSpeed + " " + qsTr("tps", "tasks per second");
                 }
+
+                Repeater {
+                    model: Object.keys(executorInfo.statistics)
+
+                    Text {
+                        text: modelData + ": " + executorInfo.statistics[modelData]
+                    }
+                }
             }
         }
     }
@@ -69,10 +69,12 @@ void ContextMenuManager::setProject(Project* prj)
 {
     m_project = prj;
     m_translator.reset();
+    m_knownFaces.reset();
 
     if (m_project)
     {
         m_translator = std::make_unique<IdToDataConverter>(m_project->getDatabase());
+        m_knownFaces = std::make_unique<KnownFacesIndex>(m_project->getDatabase());
         connect(m_translator.get(), &IdToDataConverter::photoDataFetched,
                 this, &ContextMenuManager::updateModel);
     }
@@ -224,6 +226,6 @@ void ContextMenuManager::facesAction()
     Photo::DataDelta delta(first.id);
     delta.insert<Photo::Field::Path>(first.path);
 
-    FacesDialog faces_dialog(delta, m_core, m_project);
+    FacesDialog faces_dialog(delta, m_core, m_project, *m_knownFaces);
     faces_dialog.exec();
 }
@@ -10,6 +10,7 @@
 #include <database/database_tools/id_to_data_converter.hpp>
 #include <project_utils/project.hpp>
 #include "models/actions_model.hpp"
+#include "utils/known_faces_index.hpp"
 
 
 class ContextMenuManager: public QObject
@@ -39,6 +40,7 @@ signals:
 
 private:
     std::unique_ptr<IdToDataConverter> m_translator;
+    std::unique_ptr<KnownFacesIndex> m_knownFaces;
     std::vector<Photo::Data> m_photos;
     ActionsModel m_model;
     QList<QVariant> m_selection;
@@ -271,11 +271,8 @@ void PhotosModelControllerComponent::updateModelFilters()
 }
 
 
-void PhotosModelControllerComponent::setAvailableDates(const std::vector<TagValue>& dates_as_tags)
+void PhotosModelControllerComponent::setAvailableDates(const std::vector<QDate>& dates)
 {
-    std::vector<QDate> dates;
-    std::transform(dates_as_tags.begin(), dates_as_tags.end(), std::back_inserter(dates), [](const auto& d) { return d.getDate(); });
-
     if (dates != m_dates)
     {
         m_dates = dates;
@@ -359,16 +356,13 @@ QStringList PhotosModelControllerComponent::rawCategories() const
 
 void PhotosModelControllerComponent::getTimeRangeForFilters(Database::IBackend& backend)
 {
-    auto dates = backend.listTagValues(Tag::Types::Date, {});
+    // histogram is sorted by date. Photos without date (if any) come first as invalid QDate
+    const auto histogram = backend.getDatesHistogram();
 
-    const Database::FilterPhotosWithTag with_date_filter(Tag::Types::Date);
-    const Database::FilterNotMatchingFilter without_date_filter(with_date_filter);
-    const auto photos_without_date_tag = backend.photoOperator().getPhotos(without_date_filter);
-
-    if (photos_without_date_tag.empty() == false)
-        dates.push_back(QDate());
+    std::vector<QDate> dates;
+    dates.reserve(histogram.size());
 
-    std::sort(dates.begin(), dates.end());
+    std::transform(histogram.begin(), histogram.end(), std::back_inserter(dates), [](const auto& entry) { return entry.first; });
     invokeMethod(this, &PhotosModelControllerComponent::setAvailableDates, dates);
 }
 
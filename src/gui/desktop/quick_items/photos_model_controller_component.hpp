@@ -111,7 +111,7 @@ class PhotosModelControllerComponent: public QObject
 
         void clear();
         void updateModelFilters();
-        void setAvailableDates(const std::vector<TagValue> &);
+        void setAvailableDates(const std::vector<QDate> &);
         void updateTimeRange();
         Database::Filter allFilters() const;
         QStringList rawCategories() const;
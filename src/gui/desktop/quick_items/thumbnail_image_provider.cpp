@@ -1,6 +1,8 @@
 
 #include <future>
 
+#include <QPointer>
+
 #include <core/function_wrappers.hpp>
 #include "thumbnail_image_provider.hpp"
 
@@ -15,14 +17,37 @@ namespace
                 if (requestedSize.isEmpty())
                     handleDone({});
                 else
-                    thbMgr.fetch(id, requestedSize, [this](const QImage& thumb)
+                {
+                    // response may be released by engine (after cancel()) while fetch is still running
+                    const QPointer<AsyncImageResponse> response(this);
+
+                    thbMgr.fetch(id, requestedSize, [response](const QImage& thumb)
                     {
-                        invokeMethod(this, &AsyncImageResponse::handleDone, thumb);
-                    });
+                        call_from_object_thread(response, &AsyncImageResponse::handleDone, thumb);
+                    }, m_cancellationToken);
+                }
+            }
+
+            void cancel() override
+            {
+                // image is not needed anymore (delegate was destroyed or scrolled out)
+                m_cancellationToken.cancel();
+
+                // engine expects finished() after cancel() to release response.
+                // Canceled task won't deliver anything, so finish here (not from within cancel() call itself).
+                QMetaObject::invokeMethod(this, [this]()
+                {
+                    handleDone({});
+                }, Qt::QueuedConnection);
             }
 
             void handleDone(QImage image)
             {
+                // thumbnail may arrive just before (or after) cancelation
+                if (m_finished)
+                    return;
+
+                m_finished = true;
                 m_image = image;
                 emit finished();
             }
@@ -33,6 +58,8 @@ namespace
             }
 
             QImage m_image;
+            CancellationToken m_cancellationToken;
+            bool m_finished = false;
     };
 }
 
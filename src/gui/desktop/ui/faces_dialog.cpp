@@ -60,10 +60,10 @@ namespace
     };
 }
 
-FacesDialog::FacesDialog(const Photo::DataDelta& pd, ICoreFactoryAccessor* coreAccessor, Project* prj, QWidget *parent):
+FacesDialog::FacesDialog(const Photo::DataDelta& pd, ICoreFactoryAccessor* coreAccessor, Project* prj, KnownFacesIndex& knownFaces, QWidget *parent):
     QDialog(parent),
     m_id(pd.getId()),
-    m_peopleManipulator(pd.getId(), prj->getDatabase(), *coreAccessor),
+    m_peopleManipulator(pd.getId(), prj->getDatabase(), *coreAccessor, knownFaces),
     m_faces(),
     m_photoPath(pd.get<Photo::Field::Path>()),
     ui(new Ui::FacesDialog),
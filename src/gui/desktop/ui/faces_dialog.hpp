@@ -21,6 +21,7 @@ namespace Ui {
     class FacesDialog;
 }
 
+class KnownFacesIndex;
 class Project;
 
 class FacesDialog: public QDialog
@@ -28,7 +29,7 @@ class FacesDialog: public QDialog
         Q_OBJECT
 
     public:
-        FacesDialog(const Photo::DataDelta& pd, ICoreFactoryAccessor* coreAccessor, Project* prj, QWidget* parent = 0 );
+        FacesDialog(const Photo::DataDelta& pd, ICoreFactoryAccessor* coreAccessor, Project* prj, KnownFacesIndex& knownFaces, QWidget* parent = 0 );
         ~FacesDialog();
 
     protected:
@@ -40,7 +40,9 @@
 #include "models/flat_model.hpp"
 #include "widgets/project_creator/project_creator_dialog.hpp"
 #include "ui_utils/config_dialog_manager.hpp"
+#include "utils/collection_monitor.hpp"
 #include "utils/collection_scanner.hpp"
+#include "utils/disk_thumbnails_cache.hpp"
 #include "utils/groups_manager.hpp"
 #include "utils/grouppers/collage_generator.hpp"
 #include "utils/model_index_utils.hpp"
@@ -143,6 +145,12 @@ void MainWindow::setupConfig()
 {
     // setup defaults
     m_configuration.setDefaultValue(UpdateConfigKeys::updateEnabled,   true);
+    m_configuration.setDefaultValue(CollectionConfigKeys::monitorChanges, false);
+
+    m_configuration.watchFor(CollectionConfigKeys::monitorChanges, [this](const QString &, const QVariant &)
+    {
+        QMetaObject::invokeMethod(this, &MainWindow::updateCollectionMonitor, Qt::QueuedConnection);
+    });
 
     loadRecentCollections();
 }
@@ -277,13 +285,36 @@ void MainWindow::updateTools()
     {
         m_photosAnalyzer = std::make_unique<PhotosAnalyzer>(m_coreAccessor, m_currentPrj->getDatabase());
         m_photosAnalyzer->set(&m_tasksModel);
-        m_thumbnailsManager->setDatabaseCache(&m_currentPrj->getDatabase());
+        const QString thumbnailsLocation = m_currentPrj->getProjectInfo().getInternalLocation(ProjectInfo::Thumbnails);
+        m_thumbnailsManager->setDatabaseCache(&m_currentPrj->getDatabase(), std::make_unique<DiskThumbnailsCache>(thumbnailsLocation));
     }
     else
     {
         m_photosAnalyzer.reset();
         m_thumbnailsManager->setDatabaseCache(nullptr);
     }
+
+    updateCollectionMonitor();
+}
+
+
+void MainWindow::updateCollectionMonitor()
+{
+    const bool enabled = m_configuration.getEntry(CollectionConfigKeys::monitorChanges).toBool();
+
+    if (m_currentPrj && enabled)
+    {
+        if (m_collectionMonitor == nullptr)
+        {
+            auto monitor = std::make_unique<CollectionMonitor>(*m_currentPrj.get(), m_loggerFactory);
+            connect(monitor.get(), &CollectionMonitor::rescanRequired, this, &MainWindow::on_actionScan_collection_triggered);
+
+            if (monitor->start())
+                m_collectionMonitor = std::move(monitor);
+        }
+    }
+    else
+        m_collectionMonitor.reset();
 }
 
 
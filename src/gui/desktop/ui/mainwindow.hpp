@@ -17,6 +17,7 @@
 #include "utils/features_observer.hpp"
 
 
+class CollectionMonitor;
 class ConfigDialogManager;
 class LookTabController;
 class MainTabController;
@@ -62,6 +63,7 @@ class MainWindow: public QObject
         QPointer<QObject>         m_collectionScanner;
         QQmlApplicationEngine     m_mainView;
         std::unique_ptr<PhotosAnalyzer> m_photosAnalyzer;
+        std::unique_ptr<CollectionMonitor> m_collectionMonitor;
         std::unique_ptr<ConfigDialogManager> m_configDialogManager;
         std::unique_ptr<MainTabController> m_mainTabCtrl;
         std::unique_ptr<ToolsTabController> m_toolsTabCtrl;
@@ -73,6 +75,7 @@ class MainWindow: public QObject
         void closeProject();
         void updateGui();
         void updateTools();
+        void updateCollectionMonitor();
         void updateProjectProperties();
         void registerConfigTab();
 
@@ -289,7 +289,6 @@ void PhotosGroupingDialog::makeAnimation()
     AnimationGenerator::Data generator_data;
 
     generator_data.storage = m_tmpDir->path();
-    generator_data.alignImageStackPath = m_config.getEntry(ExternalToolsConfigKeys::aisPath).toString();
     generator_data.magickPath = m_config.getEntry(ExternalToolsConfigKeys::magickPath).toString();
     generator_data.photos = getPhotos();
     generator_data.fps = ui->speedSpinBox->value();
@@ -308,7 +307,6 @@ void PhotosGroupingDialog::makeHDR()
     HDRGenerator::Data generator_data;
 
     generator_data.storage = m_tmpDir->path();
-    generator_data.alignImageStackPath = m_config.getEntry(ExternalToolsConfigKeys::aisPath).toString();
     generator_data.photos = getPhotos();
 
     auto hdr_task = std::make_unique<HDRGenerator>(generator_data, m_logger, m_exifReaderFactory);
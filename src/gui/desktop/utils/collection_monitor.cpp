@@ -0,0 +1,263 @@
+#include "collection_monitor.hpp"
+
+#include <map>
+
+#include <QFileInfo>
+
+#include <database/general_flags.hpp>
+#include <database/ibackend.hpp>
+#include <database/idatabase.hpp>
+#include <project_utils/project.hpp>
+
+#ifdef Q_OS_LINUX
+#include <photos_crawler/default_filesystem_monitors/inotify_monitor.hpp>
+#endif
+
+
+namespace
+{
+    // all paths are relative to project's base dir
+    struct CollectionChanges
+    {
+        QStringList added;
+        QStringList removedFiles;
+        QStringList removedDirectories;
+        std::vector<FileSystemChanges::Move> movedFiles;
+        std::vector<FileSystemChanges::Move> movedDirectories;
+    };
+
+    constexpr int MissingBit = static_cast<int>(Database::CommonGeneralFlags::StateType::Missing);
+
+    std::map<QString, Photo::Id> photosMatching(Database::IBackend& backend, const Database::Filter& filter)
+    {
+        std::map<QString, Photo::Id> photos;
+
+        for (const auto& photo: backend.getPhotoDeltas(filter, {Photo::Field::Path}))
+            photos.emplace(photo.get<Photo::Field::Path>(), photo.getId());
+
+        return photos;
+    }
+
+    bool isMissing(Database::IBackend& backend, const Photo::Id& id)
+    {
+        const std::optional<int> state = backend.get(id, Database::CommonGeneralFlags::State);
+
+        return state.has_value() && (*state & MissingBit) != 0;
+    }
+
+    void markMissing(Database::IBackend& backend, const Photo::Id& id)
+    {
+        backend.setBits(id, Database::CommonGeneralFlags::State, MissingBit);
+    }
+
+    void markAvailable(Database::IBackend& backend, const Photo::Id& id)
+    {
+        if (isMissing(backend, id))
+            backend.clearBits(id, Database::CommonGeneralFlags::State, MissingBit);
+    }
+
+    /**
+     * \brief change path of moved photos
+     * \param sources photos to be moved (path -> id)
+     * \param destinations photos already known under destination paths (path -> id)
+     * \param newPath function converting source path to destination one
+     *
+     * When destination path is already known (file was moved over other one, or it was moved back
+     * to place it was once missing from), the known entry is restored and source becomes missing.
+     */
+    template<typename F>
+    void relocate(Database::IBackend& backend, const std::map<QString, Photo::Id>& sources, const std::map<QString, Photo::Id>& destinations, F newPath)
+    {
+        std::vector<Photo::DataDelta> moved;
+
+        for (const auto& [path, id]: sources)
+        {
+            const QString destination = newPath(path);
+            const auto it = destinations.find(destination);
+
+            if (it == destinations.end())
+            {
+                Photo::DataDelta delta(id);
+                delta.insert<Photo::Field::Path>(destination);
+                moved.push_back(delta);
+            }
+            else
+            {
+                markAvailable(backend, it->second);
+                markMissing(backend, id);
+            }
+        }
+
+        if (moved.empty() == false)
+            backend.update(moved);
+    }
+
+    void applyChanges(Database::IBackend& backend, CollectionChanges changes)
+    {
+        // moves go first so renamed photos are not treated as new ones
+        for (const auto& move: changes.movedDirectories)
+        {
+            const auto sources = photosMatching(backend, Database::FilterPhotosInDirectories({move.from}, true));
+            const auto destinations = photosMatching(backend, Database::FilterPhotosInDirectories({move.to}, true));
+
+            relocate(backend, sources, destinations, [&move](const QString& path)
+            {
+                return move.to + path.mid(move.from.size());
+            });
+        }
+
+        for (const auto& move: changes.movedFiles)
+        {
+            const auto sources = photosMatching(backend, Database::FilterPhotosWithPath(move.from));
+
+            if (sources.empty())
+                changes.added.append(move.to);      // source was not known (collection was not scanned yet?), treat as new file
+            else
+            {
+                const auto destinations = photosMatching(backend, Database::FilterPhotosWithPath(move.to));
+
+                relocate(backend, sources, destinations, [&move](const QString &)
+                {
+                    return move.to;
+                });
+            }
+        }
+
+        // removals
+        std::map<QString, Photo::Id> removed;
+
+        if (changes.removedDirectories.isEmpty() == false)
+            removed = photosMatching(backend, Database::FilterPhotosInDirectories(changes.removedDirectories, true));
+
+        for (const QString& path: changes.removedFiles)
+            removed.merge(photosMatching(backend, Database::FilterPhotosWithPath(path)));
+
+        for (const auto& [path, id]: removed)
+            markMissing(backend, id);
+
+        // additions
+        std::vector<Photo::DataDelta> newPhotos;
+
+        for (const QString& path: changes.added)
+        {
+            const auto known = photosMatching(backend, Database::FilterPhotosWithPath(path));
+
+            if (known.empty())
+            {
+                const Photo::FlagValues flags = { {Photo::FlagsE::StagingArea, 1} };
+
+                Photo::DataDelta photo;
+                photo.insert<Photo::Field::Path>(path);
+                photo.insert<Photo::Field::Flags>(flags);
+                newPhotos.push_back(photo);
+            }
+            else
+                for (const auto& [knownPath, id]: known)
+                    markAvailable(backend, id);
+        }
+
+        if (newPhotos.empty() == false)
+            backend.addPhotos(newPhotos);
+    }
+}
+
+
+CollectionMonitor::CollectionMonitor(const Project& project, const ILoggerFactory& loggerFactory)
+    : m_logger(loggerFactory.get("CollectionMonitor"))
+    , m_project(project)
+{
+
+}
+
+
+CollectionMonitor::~CollectionMonitor()
+{
+    if (m_monitor)
+        m_monitor->stop();
+}
+
+
+bool CollectionMonitor::start()
+{
+#ifdef Q_OS_LINUX
+    auto monitor = std::make_unique<InotifyMonitor>(m_logger->subLogger("Inotify"));
+
+    // database, thumbnails etc are modified all the time, do not watch them
+    monitor->ignorePaths({m_project.getProjectInfo().getInternalLocation()});
+
+    if (monitor->watch(m_project.getProjectInfo().getBaseDir(), this))
+    {
+        m_monitor = std::move(monitor);
+        return true;
+    }
+
+    m_logger->warning("Could not start collection monitoring");
+#else
+    m_logger->warning("Collection monitoring is not supported on this platform");
+#endif
+
+    return false;
+}
+
+
+void CollectionMonitor::changed(const FileSystemChanges& changes)
+{
+    if (changes.overflow)
+    {
+        m_logger->warning("Some file system changes were lost, collection needs to be rescanned");
+        emit rescanRequired();
+
+        return;
+    }
+
+    // changes are reported with a delay, so verify them against current state of disk
+    CollectionChanges collectionChanges;
+
+    for (const QString& path: changes.added)
+        if (m_analyzer.isMediaFile(path) && QFileInfo(path).isFile())
+            collectionChanges.added.append(m_project.makePathRelative(path));
+
+    for (const auto& removal: changes.removed)
+        if (QFileInfo::exists(removal.path) == false)
+        {
+            const QString relative = m_project.makePathRelative(removal.path);
+
+            if (removal.isDirectory)
+                collectionChanges.removedDirectories.append(relative);
+            else if (m_analyzer.isMediaFile(removal.path))
+                collectionChanges.removedFiles.append(relative);
+        }
+
+    for (const auto& move: changes.moved)
+    {
+        const QFileInfo destination(move.to);
+        const FileSystemChanges::Move relative{ m_project.makePathRelative(move.from), m_project.makePathRelative(move.to) };
+
+        if (destination.isDir())
+            collectionChanges.movedDirectories.push_back(relative);
+        else if (destination.isFile())
+        {
+            const bool fromMedia = m_analyzer.isMediaFile(move.from);
+            const bool toMedia = m_analyzer.isMediaFile(move.to);
+
+            if (fromMedia && toMedia)
+                collectionChanges.movedFiles.push_back(relative);
+            else if (toMedia)
+                collectionChanges.added.append(relative.to);
+            else if (fromMedia)
+                collectionChanges.removedFiles.append(relative.from);
+        }
+    }
+
+    m_logger->debug(QString("Applying changes: %1 added, %2 files and %3 directories removed, %4 files and %5 directories moved")
+                        .arg(collectionChanges.added.size())
+                        .arg(collectionChanges.removedFiles.size())
+                        .arg(collectionChanges.removedDirectories.size())
+                        .arg(collectionChanges.movedFiles.size())
+                        .arg(collectionChanges.movedDirectories.size()));
+
+    m_project.getDatabase().exec([collectionChanges](Database::IBackend& backend)
+    {
+        applyChanges(backend, collectionChanges);
+    });
+}
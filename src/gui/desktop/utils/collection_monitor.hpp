@@ -0,0 +1,52 @@
+#ifndef COLLECTION_MONITOR_HPP
+#define COLLECTION_MONITOR_HPP
+
+#include <memory>
+
+#include <QObject>
+
+#include <core/ilogger.hpp>
+#include <core/ilogger_factory.hpp>
+#include <photos_crawler/default_analyzers/file_analyzer.hpp>
+#include <photos_crawler/ifile_system_monitor.hpp>
+
+class Project;
+
+
+/**
+ * \brief Keeps database in sync with collection's directory while project is open
+ *
+ * Changes reported by file system monitor are applied directly to database:
+ * new files are added to staging area, removed ones are marked as missing
+ * and moved files (or whole directories) get new path so theirs tags,
+ * people and groups are preserved.
+ * When monitor loses events, rescanRequired() is emitted so full scan can be run.
+ */
+class CollectionMonitor: public QObject, private IFileSystemChangesNotifier
+{
+        Q_OBJECT
+
+    public:
+        CollectionMonitor(const Project &, const ILoggerFactory &);
+        CollectionMonitor(const CollectionMonitor &) = delete;
+        ~CollectionMonitor();
+
+        CollectionMonitor& operator=(const CollectionMonitor &) = delete;
+
+        /// start monitoring. Returns false when monitoring is not available
+        bool start();
+
+    signals:
+        void rescanRequired() const;
+
+    private:
+        FileAnalyzer m_analyzer;
+        std::unique_ptr<IFileSystemMonitor> m_monitor;
+        std::unique_ptr<ILogger> m_logger;
+        const Project& m_project;
+
+        // IFileSystemChangesNotifier:
+        void changed(const FileSystemChanges &) override;
+};
+
+#endif
@@ -19,6 +19,7 @@
 
 
 #include <algorithm>
+#include <QDir>
 #include <QFileInfo>
 #include <QLabel>
 #include <QPushButton>
@@ -32,6 +33,13 @@
 #include "project_utils/project.hpp"
 
 
+namespace
+{
+    // each directory is a separate condition in SQL query, so keep queries reasonably small
+    constexpr qsizetype DirectoriesPerQuery = 128;
+}
+
+
 CollectionScanner::CollectionScanner(const Project& project, ITasksView& tasksView, INotifications& notifications):
     QObject(),
     m_collector(project),
@@ -40,7 +48,8 @@ CollectionScanner::CollectionScanner(const Project& project, ITasksView& tasksVi
     m_tasksView(tasksView),
     m_notifications(notifications),
     m_gotPhotos(false),
-    m_gotDBPhotos(false)
+    m_gotDBPhotos(false),
+    m_fullScan(true)
 {
     connect(&m_collector, &PhotosCollector::finished, this, &CollectionScanner::diskScanDone);
 }
@@ -56,40 +65,23 @@ void CollectionScanner::scan()
 {
     m_progressTask = m_tasksView.add(tr("Scanning collection"));
 
-    // collect photos from disk
-    using namespace std::placeholders;
-    auto disk_callback = std::bind(&CollectionScanner::gotDiskPhoto, this, _1);
-
-    m_collector.collect(m_project.getProjectInfo().getBaseDir(), disk_callback);
-
-    // collect photos from db
-    auto db_callback = std::bind(&CollectionScanner::gotDBPhotos, this, _1, _2);
-
-    m_database.exec([db_callback](Database::IBackend& backend)
-    {
-        // collect all photos but separate missing from others
-        const Database::FilterPhotosWithGeneralFlag filterMissing(Database::CommonGeneralFlags::State,
-                                                                  static_cast<int>(Database::CommonGeneralFlags::StateType::Missing),
-                                                                  Database::FilterPhotosWithGeneralFlag::Mode::Bit);
-        const Database::FilterNotMatchingFilter filterNotMissing(filterMissing);
-
-        auto photos = backend.photoOperator().getPhotos(filterNotMissing);
-        auto missingPhotos = backend.photoOperator().getPhotos(filterMissing);
+    m_diskPhotos.clear();
+    m_gotPhotos = false;
+    m_gotDBPhotos = false;
 
-        std::vector<Photo::DataDelta> photoDeltas;
-        photoDeltas.reserve(photos.size());
+    // snapshot of previous scan allows to skip directories which did not change
+    m_snapshot = std::make_shared<DirectoriesSnapshot>();
+    m_fullScan = m_snapshot->load(snapshotPath()) == false || m_snapshot->isEmpty();
 
-        for(const Photo::Id& id: photos)
-            photoDeltas.push_back(backend.getPhotoDelta(id, {Photo::Field::Path}));
-
-        std::vector<Photo::DataDelta> missingPhotoDeltas;
-        missingPhotoDeltas.reserve(missingPhotos.size());
+    // collect photos from disk
+    using namespace std::placeholders;
+    auto disk_callback = std::bind(&CollectionScanner::gotDiskPhotos, this, _1);
 
-        for(const Photo::Id& id: missingPhotos)
-            missingPhotoDeltas.push_back(backend.getPhotoDelta(id, {Photo::Field::Path}));
+    m_collector.collect(m_project.getProjectInfo().getBaseDir(), disk_callback, m_snapshot.get());
 
-        db_callback(photoDeltas, missingPhotoDeltas);
-    });
+    // without snapshot all photos from db are needed, collect them in parallel with disk scan
+    if (m_fullScan)
+        fetchDBPhotos(std::nullopt);
 }
 
 
@@ -97,7 +89,19 @@ void CollectionScanner::diskScanDone()
 {
     m_gotPhotos = true;
 
-    checkIfReady();
+    if (m_fullScan)
+        checkIfReady();
+    else
+    {
+        // collect db photos from directories which were listed or removed
+        const QStringList changedDirectories = m_snapshot->changedDirectories();
+        QStringList directories;
+
+        for (const QString& directory: changedDirectories)
+            directories.append(m_project.makePathRelative(directory));
+
+        fetchDBPhotos(directories);
+    }
 }
 
 
@@ -165,6 +169,15 @@ void CollectionScanner::performAnalysis()
             }
         });
 
+    // remember state of disk when changes are stored in db
+    m_database.exec([snapshot = m_snapshot, path = snapshotPath()](Database::IBackend &)
+    {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        snapshot->save(path);
+    });
+
+    m_snapshot.reset();
+
     // finalization
     addNotification(pureNewPhotos.size(), removedPhotos.size(), restoredPhotos.size());
     m_progressTask->finished();
@@ -180,12 +193,68 @@ void CollectionScanner::checkIfReady()
 }
 
 
-void CollectionScanner::gotDiskPhoto(const QString& path)
+void CollectionScanner::fetchDBPhotos(const std::optional<QStringList>& directories)
 {
-    const QString relative = m_project.makePathRelative(path);
-    Photo::DataDelta photo;
-    photo.insert<Photo::Field::Path>(relative);
-    m_diskPhotos.push_back(photo);
+    if (directories.has_value() && directories->isEmpty())
+    {
+        gotDBPhotos({}, {});
+        return;
+    }
+
+    auto db_callback = std::bind(&CollectionScanner::gotDBPhotos, this, std::placeholders::_1, std::placeholders::_2);
+
+    m_database.exec([db_callback, directories](Database::IBackend& backend)
+    {
+        // collect photos but separate missing from others
+        const Database::FilterPhotosWithGeneralFlag filterMissing(Database::CommonGeneralFlags::State,
+                                                                  static_cast<int>(Database::CommonGeneralFlags::StateType::Missing),
+                                                                  Database::FilterPhotosWithGeneralFlag::Mode::Bit);
+        const Database::FilterNotMatchingFilter filterNotMissing(filterMissing);
+
+        if (directories.has_value())
+        {
+            std::vector<Photo::DataDelta> photoDeltas;
+            std::vector<Photo::DataDelta> missingPhotoDeltas;
+
+            for (qsizetype i = 0; i < directories->size(); i += DirectoriesPerQuery)
+            {
+                const Database::FilterPhotosInDirectories inDirectories(directories->mid(i, DirectoriesPerQuery));
+
+                const auto photos = backend.getPhotoDeltas(Database::GroupFilter{inDirectories, filterNotMissing}, {Photo::Field::Path});
+                const auto missingPhotos = backend.getPhotoDeltas(Database::GroupFilter{inDirectories, filterMissing}, {Photo::Field::Path});
+
+                photoDeltas.insert(photoDeltas.end(), photos.begin(), photos.end());
+                missingPhotoDeltas.insert(missingPhotoDeltas.end(), missingPhotos.begin(), missingPhotos.end());
+            }
+
+            db_callback(photoDeltas, missingPhotoDeltas);
+        }
+        else
+        {
+            const auto photoDeltas = backend.getPhotoDeltas(filterNotMissing, {Photo::Field::Path});
+            const auto missingPhotoDeltas = backend.getPhotoDeltas(filterMissing, {Photo::Field::Path});
+
+            db_callback(photoDeltas, missingPhotoDeltas);
+        }
+    });
+}
+
+
+QString CollectionScanner::snapshotPath() const
+{
+    return m_project.getProjectInfo().getInternalLocation(ProjectInfo::Cache) + "/directories.snapshot";
+}
+
+
+void CollectionScanner::gotDiskPhotos(const QStringList& paths)
+{
+    for (const QString& path: paths)
+    {
+        const QString relative = m_project.makePathRelative(path);
+        Photo::DataDelta photo;
+        photo.insert<Photo::Field::Path>(relative);
+        m_diskPhotos.push_back(photo);
+    }
 }
 
 
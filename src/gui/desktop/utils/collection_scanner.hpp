@@ -21,10 +21,13 @@
 #define COLLECTIONDIRSCANDIALOG_HPP
 
 #include <atomic>
+#include <memory>
+#include <optional>
 #include <set>
 
 #include <core/itasks_view.hpp>
 #include <database/idatabase.hpp>
+#include <photos_crawler/default_filesystem_scanners/directories_snapshot.hpp>
 #include "utils/photos_collector.hpp"
 #include "inotifications.hpp"
 
@@ -46,6 +49,7 @@ class CollectionScanner: public QObject
         void scanFinished() const;
 
     private:
+        std::shared_ptr<DirectoriesSnapshot> m_snapshot;
         PhotosCollector m_collector;
         std::vector<Photo::DataDelta> m_diskPhotos;
         std::vector<Photo::DataDelta> m_dbPhotos;
@@ -57,6 +61,7 @@ class CollectionScanner: public QObject
         INotifications& m_notifications;
         std::atomic<bool> m_gotPhotos;
         std::atomic<bool> m_gotDBPhotos;
+        bool m_fullScan;
 
         // slots:
         void diskScanDone();
@@ -64,8 +69,10 @@ class CollectionScanner: public QObject
         //
 
         void checkIfReady();
+        void fetchDBPhotos(const std::optional<QStringList> &);
+        QString snapshotPath() const;
 
-        void gotDiskPhoto(const QString &);
+        void gotDiskPhotos(const QStringList &);
         void gotDBPhotos(const std::vector<Photo::DataDelta> &, const std::vector<Photo::DataDelta> &);
         void addNotification(std::size_t, std::size_t, std::size_t);
 };
@@ -0,0 +1,76 @@
+
+#include <QDir>
+#include <QSaveFile>
+
+#include "disk_thumbnails_cache.hpp"
+
+
+DiskThumbnailsCache::DiskThumbnailsCache(const QString& location)
+    : m_location(location)
+{
+    QDir().mkpath(m_location);
+}
+
+
+std::optional<QImage> DiskThumbnailsCache::find(const Photo::Id& id, const ThumbnailParameters& params)
+{
+    std::optional<QImage> result;
+
+    QImage img(pathFor(id, params), "JPG");
+
+    if (img.isNull() == false)
+        result = img;
+
+    return result;
+}
+
+
+void DiskThumbnailsCache::store(const Photo::Id& id, const ThumbnailParameters& params, const QImage& img)
+{
+    QDir().mkpath(directoryFor(id));
+
+    // QSaveFile writes to temporary file and renames it on commit
+    // so readers will never see partially written thumbnail
+    QSaveFile file(pathFor(id, params));
+
+    if (file.open(QIODevice::WriteOnly) && img.save(&file, "JPG"))
+        file.commit();
+    else
+        file.cancelWriting();
+}
+
+
+void DiskThumbnailsCache::remove(const Photo::Id& id)
+{
+    QDir dir(directoryFor(id));
+    const QStringList thumbnails = dir.entryList({ QString("%1_*.jpg").arg(id.value()) }, QDir::Files);
+
+    for(const QString& thumbnail: thumbnails)
+        dir.remove(thumbnail);
+}
+
+
+void DiskThumbnailsCache::clear()
+{
+    QDir(m_location).removeRecursively();
+    QDir().mkpath(m_location);
+}
+
+
+QString DiskThumbnailsCache::directoryFor(const Photo::Id& id) const
+{
+    // spread files among subdirectories to keep directories small
+    return QString("%1/%2").arg(m_location).arg(id.value() % 256, 2, 16, QChar('0'));
+}
+
+
+QString DiskThumbnailsCache::pathFor(const Photo::Id& id, const ThumbnailParameters& params) const
+{
+    const QSize& size = std::get<0>(params);
+
+    return QString("%1/%2_%3x%4.jpg")
+        .arg(directoryFor(id))
+        .arg(id.value())
+        .arg(size.width())
+        .arg(size.height());
+}
@@ -0,0 +1,37 @@
+
+#ifndef DISK_THUMBNAILS_CACHE_HPP_INCLUDED
+#define DISK_THUMBNAILS_CACHE_HPP_INCLUDED
+
+#include <QString>
+
+#include "ithumbnails_cache.hpp"
+
+
+/**
+ * @brief Persistent thumbnails storage
+ *
+ * Thumbnails are stored as jpeg files in a directory tree:
+ * <location>/<id % 256>/<id>_<width>x<height>.jpg
+ *
+ * Each thumbnail is a separate file written atomically,
+ * so cache can be read and written from many threads at once
+ * without any synchronization with database.
+ */
+class DiskThumbnailsCache: public IThumbnailsCache
+{
+    public:
+        explicit DiskThumbnailsCache(const QString& location);
+
+        std::optional<QImage> find(const Photo::Id &, const ThumbnailParameters &) override;
+        void store(const Photo::Id &, const ThumbnailParameters &, const QImage &) override;
+        void remove(const Photo::Id &) override;
+        void clear() override;
+
+    private:
+        const QString m_location;
+
+        QString directoryFor(const Photo::Id &) const;
+        QString pathFor(const Photo::Id &, const ThumbnailParameters &) const;
+};
+
+#endif
@@ -9,7 +9,6 @@ namespace
     const std::map<QString, QString> Tools =
     {
         { gui::features::ToolMagick   ,"Magick"          },
-        { gui::features::ToolAIS      ,"AlignImageStack" },
         { gui::features::ToolFFMpeg   ,"FFMpeg"          },
         { gui::features::ToolExifTool ,"ExifTool"        }
     };
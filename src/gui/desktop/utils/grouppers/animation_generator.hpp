@@ -24,10 +24,6 @@
 
 #include "generator_utils.hpp"
 
-class QProcess;
-
-struct ILogger;
-
 class AnimationGenerator: public GeneratorUtils::BreakableTask
 {
         Q_OBJECT
@@ -37,14 +33,13 @@ class AnimationGenerator: public GeneratorUtils::BreakableTask
         {
             QString storage;
             QString magickPath;
-            QString alignImageStackPath;
             QStringList photos;
             double fps;
             double delay;
             int scale;                          // % of original size
             bool stabilize;
 
-            Data(): storage(), magickPath(), alignImageStackPath(), photos(), fps(0.0), delay(0.0), scale(100), stabilize(false) {}
+            Data(): storage(), magickPath(), photos(), fps(0.0), delay(0.0), scale(100), stabilize(false) {}
         };
 
         AnimationGenerator(const Data& data, ILogger *, IExifReaderFactory &);
@@ -58,10 +53,8 @@ class AnimationGenerator: public GeneratorUtils::BreakableTask
 
     private:
         Data m_data;
-        ILogger* m_logger;
 
-        QStringList stabilize(const QStringList &);
-        QString generateAnimation(const QStringList &);
+        QString generateAnimation(const std::vector<cv::Mat> &);
 };
 
 
@@ -18,174 +18,145 @@
 
 #include "generator_utils.hpp"
 
-#include <QEventLoop>
-#include <QRegularExpression>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <optional>
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/video/tracking.hpp>
 
 #include <core/iexif_reader.hpp>
 #include <core/image_tools.hpp>
-#include <core/utils.hpp>
-#include <system/system.hpp>
 
 
 namespace
 {
-    const QRegularExpression loadImages_regExp(R"(^Load\/Image\/.*100% complete.*)");
-    const QRegularExpression mogrify_regExp(R"(^Mogrify\/Image\/.*)");
-    const QRegularExpression dither_regExp(R"(^Dither\/Image\/.*100% complete.*)");
-
-    const QRegularExpression cp_regExp("^(?:Creating control points between|Optimizing Variables).*");
-    const QRegularExpression run_regExp("^Run called.*");
-    const QRegularExpression remapping_regExp("^remapping.*");
-}
-
-namespace GeneratorUtils
-{
+    constexpr int AlignmentSize = 1024;             // max size of photos used for alignment
+    constexpr int PyramidTopSize = 128;             // min size of photos at top of alignment pyramid
 
-    GenericAnalyzer::GenericAnalyzer(ILogger* logger, int tailLenght):
-        QObject(),
-        m_logger(logger),
-        m_tailLenght(tailLenght)
+    // grayscale, downscaled copies of photo used for alignment. Smallest one last
+    std::vector<cv::Mat> alignmentPyramid(const cv::Mat& photo, const cv::Size& size)
     {
-    }
+        cv::Mat gray;
+        cv::cvtColor(photo, gray, cv::COLOR_BGR2GRAY);
+        cv::resize(gray, gray, size, 0.0, 0.0, cv::INTER_AREA);
 
+        std::vector<cv::Mat> pyramid = { gray };
 
-    void GenericAnalyzer::operator()(QIODevice& device)
-    {
-        while(device.bytesAvailable() > 0 && device.canReadLine())
+        while (std::min(pyramid.back().cols, pyramid.back().rows) >= PyramidTopSize * 2)
         {
-            const QByteArray line_raw = device.readLine();
-            const QString line(line_raw);
-            const QString lineTrimmed = line.trimmed();
-            const QString message = "tool output: " + lineTrimmed;
-
-            addMessage(lineTrimmed);
-            m_logger->debug(message);
-
-            processMessage(lineTrimmed);
+            cv::Mat level;
+            cv::pyrDown(pyramid.back(), level);
+            pyramid.push_back(level);
         }
-    }
-
 
-    const QStringList& GenericAnalyzer::tail() const
-    {
-        return m_tail;
+        return pyramid;
     }
 
 
-    void GenericAnalyzer::addMessage(const QString& m)
-    {
-        m_tail.append(m);
-
-        if (m_tail.size() > m_tailLenght)
-            m_tail.pop_front();
-    }
-
-
-    ///////////////////////////////////////////////////////////////////////////
-
-
-    AISOutputAnalyzer::AISOutputAnalyzer(ILogger* logger, int photos_count):
-        GenericAnalyzer(logger, 10),
-        m_photos_count(photos_count)
+    // find warp which maps base's coordinates into photo's coordinates.
+    // Works from top of pyramid (coarse, but fast and resistant to big moves) down to its bottom
+    std::optional<cv::Mat> findWarp(const std::vector<cv::Mat>& base, const std::vector<cv::Mat>& photo)
     {
-        stabilization_data.stabilization_steps =  photos_count - 1 // there will be n-1 control points groups
-                                                  + 4;             // and 4 optimization steps
-    }
+        assert(base.size() == photo.size());
 
+        const cv::TermCriteria criteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 50, 1e-4);
+        cv::Mat warp = cv::Mat::eye(2, 3, CV_32F);
 
-    void AISOutputAnalyzer::processMessage(const QString& line)
-    {
-        switch (stabilization_data.state)
+        try
         {
-            case Data::StabilizingImages:
-                if (cp_regExp.match(line).hasMatch())
-                {
-                    stabilization_data.stabilization_step++;
-
-                    emit progress( stabilization_data.stabilization_step * 100 /
-                                   stabilization_data.stabilization_steps);
-                }
-                else if (run_regExp.match(line).hasMatch())
+            for (std::size_t i = base.size(); i-- > 0;)
+            {
+                if (i + 1 < base.size())
                 {
-                    stabilization_data.state = stabilization_data.SavingImages;
-
-                    emit operation(tr("Saving stabilized images"));
-                }
-
-                break;
-
-            case Data::SavingImages:
-                if (remapping_regExp.match(line).hasMatch())
-                {
-                    stabilization_data.photos_saved++;
-
-                    emit progress( stabilization_data.photos_saved * 100 / m_photos_count );
+                    warp.at<float>(0, 2) *= 2.0f;
+                    warp.at<float>(1, 2) *= 2.0f;
                 }
 
-                break;
+                cv::findTransformECC(base[i], photo[i], warp, cv::MOTION_EUCLIDEAN, criteria, cv::noArray(), 5);
+            }
+        }
+        catch(const cv::Exception &)
+        {
+            return {};
         }
-    }
-
-
-    ///////////////////////////////////////////////////////////////////////////
-
 
-    ProcessRunner::ProcessRunner(): m_work(true)
-    {
+        return warp;
     }
 
 
-    void ProcessRunner::operator()(QProcess& pr)
+    // area of base photo covered by all warped photos
+    cv::Rect commonArea(const std::vector<cv::Mat>& warps, const cv::Size& size)
     {
-        QEventLoop loop;
-
-        connect(this, &ProcessRunner::stop, &pr, &QProcess::terminate);
-        connect(&pr, qOverload<int, QProcess::ExitStatus>(&QProcess::finished), &loop, &QEventLoop::exit);
-        connect(&pr, qOverload<int, QProcess::ExitStatus>(&QProcess::finished), this, &ProcessRunner::exitCode, Qt::DirectConnection);
+        double left = 0.0, top = 0.0;
+        double right = size.width, bottom = size.height;
 
-        if (m_work)
+        for (const cv::Mat& warp: warps)
         {
-            pr.start();
-            loop.exec();
+            cv::Mat inverted;
+            cv::invertAffineTransform(warp, inverted);
+
+            const std::vector<cv::Point2f> corners =
+            {
+                {0.0f, 0.0f},
+                {static_cast<float>(size.width), 0.0f},
+                {0.0f, static_cast<float>(size.height)},
+                {static_cast<float>(size.width), static_cast<float>(size.height)}
+            };
+
+            std::vector<cv::Point2f> c;
+            cv::transform(corners, c, inverted);
+
+            left   = std::max({left,   static_cast<double>(c[0].x), static_cast<double>(c[2].x)});
+            right  = std::min({right,  static_cast<double>(c[1].x), static_cast<double>(c[3].x)});
+            top    = std::max({top,    static_cast<double>(c[0].y), static_cast<double>(c[1].y)});
+            bottom = std::min({bottom, static_cast<double>(c[2].y), static_cast<double>(c[3].y)});
         }
 
-        if (m_work == false)
-            throw false;
+        const cv::Rect area(cv::Point(static_cast<int>(std::ceil(left)), static_cast<int>(std::ceil(top))),
+                            cv::Point(static_cast<int>(std::floor(right)), static_cast<int>(std::floor(bottom))));
+
+        return area.empty()? cv::Rect(cv::Point(), size): area;
     }
+}
 
 
-    void GeneratorUtils::ProcessRunner::cancel()
+namespace GeneratorUtils
+{
+    cv::Mat toMat(const QImage& image)
     {
-        m_work = false;
-
-        emit stop();
+        const QImage bgr = image.convertToFormat(QImage::Format_BGR888);
+        const cv::Mat wrapper(bgr.height(),
+                              bgr.width(),
+                              CV_8UC3,
+                              const_cast<uchar *>(bgr.constBits()),
+                              static_cast<std::size_t>(bgr.bytesPerLine()));
+
+        return wrapper.clone();
     }
 
 
-    int ProcessRunner::getExitCode() const
+    QImage toImage(const cv::Mat& mat)
     {
-        return m_exitCode;
-    }
+        assert(mat.type() == CV_8UC3);
 
+        const QImage wrapper(mat.data, mat.cols, mat.rows, static_cast<qsizetype>(mat.step), QImage::Format_BGR888);
 
-    void ProcessRunner::exitCode(int e)
-    {
-        m_exitCode = e;
+        return wrapper.copy();
     }
 
 
     ///////////////////////////////////////////////////////////////////////////
 
 
-    BreakableTask::BreakableTask(const QString& storage, IExifReaderFactory& exif):
+    BreakableTask::BreakableTask(const QString& storage, ILogger* logger, IExifReaderFactory& exif):
         QObject(),
-        m_tmpDir(System::createTmpDir("BT_tmp", System::Confidential | System::BigFiles)),
         m_storage(storage),
-        m_runner(),
-        m_exif(exif)
+        m_logger(logger),
+        m_exif(exif),
+        m_work(true)
     {
-        connect(this, &BreakableTask::canceled,
-                &m_runner, &GeneratorUtils::ProcessRunner::cancel);
     }
 
 
@@ -209,43 +180,132 @@ namespace GeneratorUtils
 
     void BreakableTask::cancel()
     {
+        m_work = false;
+
         emit canceled();
     }
 
 
-    QStringList BreakableTask::preparePhotos(const QStringList& photos, int scale)
+    void BreakableTask::throwIfCanceled() const
+    {
+        if (m_work == false)
+            throw false;
+    }
+
+
+    std::vector<cv::Mat> BreakableTask::preparePhotos(const QStringList& photos, int scale)
     {
         emit operation(tr("Preparing photos"));
         emit progress(0);
 
-        IExifReader& exif = m_exif.get();
+        const int p_s = static_cast<int>(photos.size());
+        std::vector<cv::Mat> prepared_photos(photos.size());
+        std::atomic<int> prepared = 0;
 
-        int photo_index = 0;
-        QStringList prepared_photos;
+        cv::parallel_for_(cv::Range(0, p_s), [&](const cv::Range& range)
+        {
+            IExifReader& exif = m_exif.get();
+
+            for (int i = range.start; i < range.end && m_work; i++)
+            {
+                const OrientedImage normalized = Image::normalized(photos[i], exif);
+
+                if (normalized->isNull() == false)
+                {
+                    const QImage scaled = scale == 100?
+                        normalized.get():
+                        normalized->scaled(normalized->width() * scale / 100, normalized->height() * scale / 100, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+                    prepared_photos[i] = toMat(scaled);
+                }
 
-        const int p_s = photos.size();
+                emit progress( ++prepared * 100 / p_s );
+            }
+        });
 
+        throwIfCanceled();
+
+        QStringList broken;
         for (int i = 0; i < p_s; i++)
+            if (prepared_photos[i].empty())
+                broken.append(photos[i]);
+
+        if (broken.isEmpty() == false)
+            throw broken;
+
+        return prepared_photos;
+    }
+
+
+    std::vector<cv::Mat> BreakableTask::alignPhotos(const std::vector<cv::Mat>& photos, std::size_t reference)
+    {
+        assert(reference < photos.size());
+
+        emit operation(tr("Aligning photos"));
+        emit progress(0);
+
+        const int p_s = static_cast<int>(photos.size());
+        const cv::Mat& base = photos[reference];
+        const double factor = std::min(1.0, static_cast<double>(AlignmentSize) / std::max(base.cols, base.rows));
+        const cv::Size alignmentSize(static_cast<int>(base.cols * factor), static_cast<int>(base.rows * factor));
+        const std::vector<cv::Mat> basePyramid = alignmentPyramid(base, alignmentSize);
+
+        std::vector<cv::Mat> resized(photos.size());
+        std::vector<cv::Mat> warps(photos.size());
+        std::vector<char> failed(photos.size(), false);
+        std::atomic<int> aligned = 0;
+
+        cv::parallel_for_(cv::Range(0, p_s), [&](const cv::Range& range)
         {
-            const QString& photo = photos[i];
-            const QString location = QString("%1/%2.tiff")
-                                    .arg(m_tmpDir->path())
-                                    .arg(photo_index);
+            for (int i = range.start; i < range.end && m_work; i++)
+            {
+                // photos of different sizes are stretched to reference's size
+                if (photos[i].size() != base.size())
+                    cv::resize(photos[i], resized[i], base.size(), 0.0, 0.0, cv::INTER_AREA);
+                else
+                    resized[i] = photos[i];
 
-            const OrientedImage normalized = Image::normalized(photo, exif);
-            const QImage scaled = scale == 100?
-                normalized.get():
-                normalized->scaled(normalized->width() * scale / 100, normalized->height() * scale / 100, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+                std::optional<cv::Mat> warp;
 
-            scaled.save(location);
+                if (static_cast<std::size_t>(i) != reference)
+                    warp = findWarp(basePyramid, alignmentPyramid(resized[i], alignmentSize));
 
-            prepared_photos << location;
-            photo_index++;
+                failed[i] = static_cast<std::size_t>(i) != reference && warp.has_value() == false;
+                warps[i] = warp.value_or(cv::Mat::eye(2, 3, CV_32F));
 
-            emit progress( (i + 1) * 100 /p_s );
-        }
+                // scale translation to photo's size
+                warps[i].at<float>(0, 2) /= static_cast<float>(factor);
+                warps[i].at<float>(1, 2) /= static_cast<float>(factor);
 
-        return prepared_photos;
+                emit progress( ++aligned * 100 / p_s );
+            }
+        });
+
+        throwIfCanceled();
+
+        for (int i = 0; i < p_s; i++)
+            if (failed[i])
+                m_logger->warning(QString("Could not align photo #%1, it will be used as is.").arg(i));
+
+        emit operation(tr("Applying alignment to photos"));
+
+        const cv::Rect area = commonArea(warps, base.size());
+        std::vector<cv::Mat> aligned_photos(photos.size());
+
+        cv::parallel_for_(cv::Range(0, p_s), [&](const cv::Range& range)
+        {
+            for (int i = range.start; i < range.end; i++)
+            {
+                // move warp's origin to the top left corner of common area so warpAffine crops photo for us
+                cv::Mat warp = warps[i].clone();
+                warp.at<float>(0, 2) += warp.at<float>(0, 0) * area.x + warp.at<float>(0, 1) * area.y;
+                warp.at<float>(1, 2) += warp.at<float>(1, 0) * area.x + warp.at<float>(1, 1) * area.y;
+
+                cv::warpAffine(resized[i], aligned_photos[i], warp, area.size(), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_REPLICATE);
+            }
+        });
+
+        return aligned_photos;
     }
 
 }
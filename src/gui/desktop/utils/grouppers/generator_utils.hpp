@@ -19,138 +19,22 @@
 #ifndef GENERATORUTILS_HPP
 #define GENERATORUTILS_HPP
 
-#include <functional>
+#include <atomic>
+#include <vector>
 
-#include <QProcess>
+#include <QImage>
 #include <QStringList>
+#include <opencv2/core.hpp>
 
 #include <core/ilogger.hpp>
 #include <core/itask_executor.hpp>
 
 struct IExifReaderFactory;
-struct ITmpDir;
 
 namespace GeneratorUtils
 {
-    template<typename T>
-    void append(QStringList& list, const T& arg)
-    {
-        list << arg;
-    }
-
-    template<typename T, typename ...Args>
-    void append(QStringList& list, const T& arg, Args... args)
-    {
-        list << arg;
-        append(list, args...);
-    }
-
-    template<typename T, typename L, typename ...Args>
-    void execute(ILogger* logger,
-                 const QString& executable,
-                 T&& outputDataCallback,
-                 L&& launcher,
-                 const Args... args)
-    {
-        QStringList arguments;
-        append(arguments, args...);
-
-        QProcess pr;
-        pr.setProcessChannelMode(QProcess::MergedChannels);
-
-        QObject::connect(&pr, &QIODevice::readyRead, [&outputDataCallback, &pr]()
-        {
-            outputDataCallback(pr);
-        });
-
-        pr.setProgram(executable);
-        pr.setArguments(arguments);
-
-        const QString info_message = QString("Executing %1 %2").arg(executable).arg(arguments.join(" "));
-
-        logger->info(info_message);
-
-        launcher(pr);
-    }
-
-
-    class GenericAnalyzer: public QObject
-    {
-            Q_OBJECT
-
-        public:
-            GenericAnalyzer(ILogger *, int tailLenght);
-            virtual ~GenericAnalyzer() = default;
-
-            const QStringList& tail() const;
-
-            virtual void operator()(QIODevice& device) final;
-
-        protected:
-            virtual void processMessage(const QString &) = 0;
-
-        private:
-            QStringList m_tail;
-            ILogger* m_logger;
-            int m_tailLenght;
-
-            void addMessage(const QString &);
-
-        signals:
-            void operation(const QString &);
-            void progress(int);
-            void finished(const QString &);
-    };
-
-
-    class AISOutputAnalyzer: public GenericAnalyzer
-    {
-            Q_OBJECT
-
-        public:
-            AISOutputAnalyzer(ILogger* logger, int photos_count);
-
-            void processMessage(const QString &) override;
-
-        private:
-            struct Data
-            {
-                int stabilization_steps = 0;
-                int stabilization_step = 0;
-                int photos_saved = 0;
-
-                enum
-                {
-                    StabilizingImages,
-                    SavingImages,
-                } state = StabilizingImages;
-            } stabilization_data;
-
-            const int m_photos_count;
-    };
-
-
-    class ProcessRunner: public QObject
-    {
-            Q_OBJECT
-
-        public:
-            ProcessRunner();
-
-            void operator()(QProcess &);      // throws `bool` if action was cancelled or was launched again after cancelation
-            void cancel();
-
-            int getExitCode() const;
-
-        private:
-            int m_exitCode;
-            bool m_work;
-
-            void exitCode(int);
-
-        signals:
-            void stop();
-    };
+    cv::Mat toMat(const QImage &);                  // converts image to 8 bit BGR matrix
+    QImage toImage(const cv::Mat &);                // converts 8 bit BGR matrix to image
 
 
     class BreakableTask: public QObject, public ITaskExecutor::ITask
@@ -158,21 +42,45 @@ namespace GeneratorUtils
             Q_OBJECT
 
         public:
-            BreakableTask(const QString& storage, IExifReaderFactory &);
+            BreakableTask(const QString& storage, ILogger *, IExifReaderFactory &);
             virtual ~BreakableTask();
 
             void perform() override final;
             void cancel();
 
         protected:
-            std::shared_ptr<ITmpDir> m_tmpDir;
             const QString m_storage;
-            ProcessRunner m_runner;
+            ILogger* m_logger;
             IExifReaderFactory& m_exif;
 
             virtual void run() = 0;
 
-            QStringList preparePhotos(const QStringList& photos, int scale);
+            void throwIfCanceled() const;           // throws `bool` if task was cancelled
+
+            /**
+             * \brief load photos into memory
+             * \param photos paths to photos
+             * \param scale % of original size
+             * \return photos rotated according to exif data
+             *
+             * Photos are loaded in parallel.
+             * Throws QStringList with paths of photos which could not be loaded.
+             */
+            std::vector<cv::Mat> preparePhotos(const QStringList& photos, int scale);
+
+            /**
+             * \brief align photos with reference one
+             * \param photos photos to be aligned
+             * \param reference index of photo others will be aligned to
+             * \return aligned photos cropped to area common for all of them
+             *
+             * Translation and rotation between photos is found with ECC
+             * algorithm on downscaled, grayscale copies of photos.
+             */
+            std::vector<cv::Mat> alignPhotos(const std::vector<cv::Mat>& photos, std::size_t reference);
+
+        private:
+            std::atomic<bool> m_work;
 
         signals:
             void operation(const QString &) const;
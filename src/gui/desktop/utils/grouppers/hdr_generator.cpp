@@ -16,8 +16,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QImage>
 #include <opencv2/imgcodecs.hpp>
+#include <opencv2/photo.hpp>
 
 #include "hdr_generator.hpp"
 
@@ -25,9 +25,8 @@
 
 
 HDRGenerator::HDRGenerator(const Data& data, ILogger* logger, IExifReaderFactory& exif):
-    GeneratorUtils::BreakableTask(data.storage, exif),
-    m_data(data),
-    m_logger(logger)
+    GeneratorUtils::BreakableTask(data.storage, logger, exif),
+    m_data(data)
 {
 }
 
@@ -40,37 +39,33 @@ std::string HDRGenerator::name() const
 
 void HDRGenerator::run()
 {
-    using GeneratorUtils::AISOutputAnalyzer;
-
-    // rotate photos
-    const QStringList rotated = preparePhotos(m_data.photos, 100);
-
-    // blend them!
-    const int photos_count = static_cast<int>(m_data.photos.size());
-    AISOutputAnalyzer analyzer(m_logger, photos_count);
-    connect(&analyzer, &AISOutputAnalyzer::operation, this, &HDRGenerator::operation);
-    connect(&analyzer, &AISOutputAnalyzer::progress,  this, &HDRGenerator::progress);
-    connect(&analyzer, &AISOutputAnalyzer::finished,  this, &HDRGenerator::finished);
-
-    emit operation(tr("generating HDR"));
-    const QString location = System::getUniqueFileName(m_storage, "hdr");
-
-    GeneratorUtils::execute(m_logger,
-            m_data.alignImageStackPath,
-            analyzer,
-            m_runner,
-            "-C",
-            "-v",                              // for align_image_stack_output_analizer
-            "-d", "-i", "-x", "-y", "-z",
-            "-s", "0",
-            "-o", location,
-            rotated);
-
-    emit operation(tr("Saving result"));
-
-    const QString output = System::getUniqueFileName(m_storage, "jpeg");
-    const cv::Mat cvmat = cv::imread(location.toStdString());
-    cv::imwrite(output.toStdString(), cvmat);
-
-    emit finished(output);
+    try
+    {
+        const std::vector<cv::Mat> prepared = preparePhotos(m_data.photos, 100);
+
+        // align to middle photo, usually it is the one with normal exposure
+        const std::vector<cv::Mat> aligned = alignPhotos(prepared, prepared.size() / 2);
+
+        // blend them!
+        emit operation(tr("generating HDR"));
+        emit progress(-1);
+
+        cv::Mat fusion;
+        cv::createMergeMertens()->process(aligned, fusion);
+        throwIfCanceled();
+
+        emit operation(tr("Saving result"));
+
+        cv::Mat result;
+        fusion.convertTo(result, CV_8UC3, 255.0);
+
+        const QString output = System::getUniqueFileName(m_storage, "jpeg");
+        cv::imwrite(output.toStdString(), result);
+
+        emit finished(output);
+    }
+    catch(const QStringList& photos)
+    {
+        emit error(tr("Could not load photos"), photos);
+    }
 }
@@ -29,10 +29,9 @@ class HDRGenerator: public GeneratorUtils::BreakableTask
         struct Data
         {
             QString storage;
-            QString alignImageStackPath;
             QStringList photos;
 
-            Data(): storage(), alignImageStackPath(), photos() {}
+            Data(): storage(), photos() {}
         };
 
         HDRGenerator(const Data& photos, ILogger *, IExifReaderFactory &);
@@ -42,7 +41,6 @@ class HDRGenerator: public GeneratorUtils::BreakableTask
 
     private:
         const Data m_data;
-        ILogger* m_logger;
 };
 
 #endif // HDRGENERATOR_HPP
@@ -4,6 +4,7 @@
 
 #include <optional>
 #include <QImage>
+#include <QVariantMap>
 
 #include <database/photo_types.hpp>
 
@@ -16,7 +17,15 @@ struct IThumbnailsCache
 
     virtual std::optional<QImage> find(const Photo::Id &, const ThumbnailParameters &) = 0;
     virtual void store(const Photo::Id &, const ThumbnailParameters &, const QImage &) = 0;
+    virtual void remove(const Photo::Id &) = 0;                 // remove all thumbnails of given photo
     virtual void clear() = 0;
+
+    // Parameters under which thumbnail for given parameters should be generated and stored.
+    // Allows cache to keep thumbnails in sizes it can reuse for other requests.
+    virtual ThumbnailParameters storageParameters(const ThumbnailParameters& params) const { return params; }
+
+    // Cache usage statistics (hits, misses etc)
+    virtual QVariantMap statistics() const { return {}; }
 };
 
 #endif
@@ -3,23 +3,30 @@
 #define ITHUMBNAILS_MANAGER_HPP
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <QSize>
 
+#include <core/cancellation_token.hpp>
 #include <database/idatabase.hpp>
 
+#include "ithumbnails_cache.hpp"
+
 
 struct IThumbnailsManager
 {
     virtual ~IThumbnailsManager() = default;
 
     // Request thumbnail. Third parameter is a callback which will be called as soon as thumbnail is accessible.
-    virtual void fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)> &) = 0;
+    // Request can be withdrawn with cancellation token. Callback won't be called then.
+    virtual void fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)> &, const CancellationToken& = CancellationToken()) = 0;
 
     // Return thumbnail if immediately accessible. Otherwise result is empty.
     virtual std::optional<QImage> fetch(const Photo::Id& id, const QSize& desired_size) = 0;
 
-    virtual void setDatabaseCache(Database::IDatabase *) = 0;
+    // Set database and persistent (disk) cache for base thumbnails.
+    // When persistent cache is provided, thumbnails stored in database are moved to it.
+    virtual void setDatabaseCache(Database::IDatabase *, std::unique_ptr<IThumbnailsCache> = {}) = 0;
 };
 
 #endif
@@ -0,0 +1,202 @@
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+#include <core/task_executor_utils.hpp>
+#include <database/database_executor_traits.hpp>
+#include <database/ibackend.hpp>
+
+#include "known_faces_index.hpp"
+
+
+namespace
+{
+    constexpr std::size_t FingerprintSize = 128;
+    constexpr float MaxDistance = 0.6f;
+
+    typedef std::map<Person::Id, std::vector<PersonFingerprint>> PeopleFingerprints;
+
+    float squaredDistance(const float* lhs, const float* rhs)
+    {
+        // use independent accumulators so compiler can vectorize the loop
+        std::array<float, 8> acc = {};
+
+        for (std::size_t i = 0; i < FingerprintSize; i += acc.size())
+            for (std::size_t j = 0; j < acc.size(); j++)
+            {
+                const float diff = lhs[i + j] - rhs[i + j];
+                acc[j] += diff * diff;
+            }
+
+        return std::accumulate(acc.cbegin(), acc.cend(), 0.0f);
+    }
+}
+
+
+KnownFacesIndex::KnownFacesIndex(Database::IDatabase& db)
+    : m_db(db)
+    , m_loaded(false)
+{
+
+}
+
+
+Person::Id KnownFacesIndex::find(const Person::Fingerprint& fingerprint)
+{
+    std::lock_guard lock(m_mutex);
+    load();
+
+    Person::Id result;
+
+    if (fingerprint.size() == FingerprintSize)
+    {
+        std::array<float, FingerprintSize> unknown;
+        std::copy(fingerprint.cbegin(), fingerprint.cend(), unknown.begin());
+
+        float closest = std::numeric_limits<float>::max();
+        const std::size_t rows = m_rowOwners.size();
+
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            const float distance = squaredDistance(&m_matrix[r * FingerprintSize], unknown.data());
+
+            if (distance < closest)
+            {
+                closest = distance;
+                result = m_rowOwners[r];
+            }
+        }
+
+        if (closest > MaxDistance * MaxDistance)
+            result = Person::Id();
+    }
+
+    return result;
+}
+
+
+void KnownFacesIndex::add(const Person::Id& id, const Person::Fingerprint& fingerprint)
+{
+    std::lock_guard lock(m_mutex);
+
+    // when not loaded yet, fingerprint will be read from database during loading
+    if (m_loaded)
+        modify(id, fingerprint, 1);
+}
+
+
+void KnownFacesIndex::remove(const Person::Id& id, const Person::Fingerprint& fingerprint)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_loaded)
+        modify(id, fingerprint, -1);
+}
+
+
+std::size_t KnownFacesIndex::size()
+{
+    std::lock_guard lock(m_mutex);
+    load();
+
+    return m_rowOwners.size();
+}
+
+
+void KnownFacesIndex::load()
+{
+    if (m_loaded)
+        return;
+
+    const PeopleFingerprints people = evaluate<PeopleFingerprints(Database::IBackend &)>(m_db, [](Database::IBackend& backend)
+    {
+        PeopleFingerprints result;
+
+        const auto all_people = backend.peopleInformationAccessor().listPeople();
+        for(const auto& person: all_people)
+            result.emplace(person.id(), backend.peopleInformationAccessor().fingerprintsFor(person.id()));
+
+        return result;
+    });
+
+    m_loaded = true;
+
+    for (const auto& [id, fingerprints]: people)
+        for (const auto& fingerprint: fingerprints)
+            modify(id, fingerprint.fingerprint(), 1);
+}
+
+
+void KnownFacesIndex::modify(const Person::Id& id, const Person::Fingerprint& fingerprint, int direction)
+{
+    if (id.valid() == false || fingerprint.size() != FingerprintSize)
+        return;
+
+    if (direction < 0 && m_people.contains(id) == false)
+        return;
+
+    PersonFaces& faces = m_people[id];
+    faces.sum.resize(FingerprintSize, 0.0);
+
+    for (std::size_t i = 0; i < FingerprintSize; i++)
+        faces.sum[i] += direction * fingerprint[i];
+
+    if (direction > 0)
+        faces.count++;
+    else
+        faces.count--;
+
+    if (faces.count == 0)
+    {
+        removeRow(id);
+        m_people.erase(id);
+    }
+    else
+        updateRow(id, faces);
+}
+
+
+void KnownFacesIndex::updateRow(const Person::Id& id, const PersonFaces& faces)
+{
+    auto it = m_rows.find(id);
+
+    if (it == m_rows.end())
+    {
+        it = m_rows.emplace(id, m_rowOwners.size()).first;
+        m_rowOwners.push_back(id);
+        m_matrix.resize(m_matrix.size() + FingerprintSize);
+    }
+
+    float* row = &m_matrix[it->second * FingerprintSize];
+
+    for (std::size_t i = 0; i < FingerprintSize; i++)
+        row[i] = static_cast<float>(faces.sum[i] / faces.count);
+}
+
+
+void KnownFacesIndex::removeRow(const Person::Id& id)
+{
+    auto it = m_rows.find(id);
+
+    if (it == m_rows.end())
+        return;
+
+    // move last row in place of removed one
+    const std::size_t row = it->second;
+    const std::size_t last = m_rowOwners.size() - 1;
+
+    if (row != last)
+    {
+        std::copy_n(&m_matrix[last * FingerprintSize], FingerprintSize, &m_matrix[row * FingerprintSize]);
+
+        const Person::Id moved = m_rowOwners[last];
+        m_rowOwners[row] = moved;
+        m_rows[moved] = row;
+    }
+
+    m_rows.erase(it);
+    m_rowOwners.pop_back();
+    m_matrix.resize(last * FingerprintSize);
+}
@@ -0,0 +1,70 @@
+
+#ifndef KNOWN_FACES_INDEX_HPP_INCLUDED
+#define KNOWN_FACES_INDEX_HPP_INCLUDED
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <database/person_data.hpp>
+
+
+namespace Database
+{
+    struct IDatabase;
+}
+
+
+/**
+ * @brief In-memory index of known people's faces
+ *
+ * Keeps average fingerprint of each known person in one contiguous
+ * float matrix, so looking for the closest person is a tight loop over memory.
+ * Index is loaded from database on first use and then kept up to date
+ * with @ref add and @ref remove, so it is meant to live as long as a project is opened.
+ */
+class KnownFacesIndex
+{
+    public:
+        explicit KnownFacesIndex(Database::IDatabase &);
+        KnownFacesIndex(const KnownFacesIndex &) = delete;
+
+        KnownFacesIndex& operator=(const KnownFacesIndex &) = delete;
+
+        /**
+         * @brief find person with face closest to given fingerprint
+         * @return id of found person or invalid id when there is no one similar enough
+         */
+        Person::Id find(const Person::Fingerprint &);
+
+        /// include fingerprint in person's average fingerprint
+        void add(const Person::Id &, const Person::Fingerprint &);
+
+        /// exclude fingerprint from person's average fingerprint
+        void remove(const Person::Id &, const Person::Fingerprint &);
+
+        /// number of indexed people
+        std::size_t size();
+
+    private:
+        struct PersonFaces
+        {
+            std::vector<double> sum;
+            std::size_t count = 0;
+        };
+
+        std::mutex m_mutex;
+        std::map<Person::Id, PersonFaces> m_people;
+        std::map<Person::Id, std::size_t> m_rows;
+        std::vector<Person::Id> m_rowOwners;
+        std::vector<float> m_matrix;
+        Database::IDatabase& m_db;
+        bool m_loaded;
+
+        void load();
+        void modify(const Person::Id &, const Person::Fingerprint &, int);
+        void updateRow(const Person::Id &, const PersonFaces &);
+        void removeRow(const Person::Id &);
+};
+
+#endif
@@ -19,7 +19,6 @@
 
 #include <QFileInfo>
 
-#include <core/containers_utils.hpp>
 #include <core/icore_factory_accessor.hpp>
 #include <core/iexif_reader.hpp>
 #include <core/task_executor_utils.hpp>
@@ -27,30 +26,14 @@
 #include <database/database_executor_traits.hpp>
 #include <face_recognition/face_recognition.hpp>
 
-
-namespace
-{
-    Person::Fingerprint average_fingerprint(const std::vector<PersonFingerprint>& faces)
-    {
-        if (faces.empty())
-            return {};
-
-        Person::Fingerprint avg_face;
-
-        for(const PersonFingerprint& fingerprint: faces)
-            avg_face += fingerprint.fingerprint();
-
-        avg_face /= faces.size();
-
-        return avg_face;
-    }
-}
+#include "known_faces_index.hpp"
 
 
-PeopleManipulator::PeopleManipulator(const Photo::Id& pid, Database::IDatabase& db, ICoreFactoryAccessor& core)
+PeopleManipulator::PeopleManipulator(const Photo::Id& pid, Database::IDatabase& db, ICoreFactoryAccessor& core, KnownFacesIndex& knownFaces)
     : m_pid(pid)
     , m_core(core)
     , m_db(db)
+    , m_knownFaces(knownFaces)
 {
     findFaces();
 }
@@ -96,6 +79,7 @@ void PeopleManipulator::store()
 {
     store_people_names();
     store_fingerprints();
+    update_known_faces();
 
     // update names assigned to face locations
     for (auto& face: m_faces)
@@ -116,7 +100,8 @@ void PeopleManipulator::runOnThread(void (PeopleManipulator::*method)())
     auto safe_task = m_callback_ctrl.make_safe_callback<>(task);
     auto& executor = m_core.getTaskExecutor();
 
-    runOn(executor, safe_task, "PeopleManipulator");
+    // user waits for results. Task will be dropped when manipulator is gone
+    runOn(executor, safe_task, ITaskExecutor::Priority::Interactive, "PeopleManipulator");
 }
 
 
@@ -241,21 +226,13 @@ void PeopleManipulator::recognizeFaces_thrd_calculate_missing_fingerprints()
 
 void PeopleManipulator::recognizeFaces_thrd_recognize_people()
 {
-    FaceRecognition face_recognition(&m_core);
-    const auto people_fingerprints = fetchPeopleAndFingerprints();
-    const std::vector<Person::Fingerprint>& known_fingerprints = std::get<0>(people_fingerprints);
-
     for (FaceInfo& faceInfo: m_faces)
         if (faceInfo.person.name().isEmpty())
         {
-            const int pos = face_recognition.recognize(faceInfo.fingerprint.fingerprint(), known_fingerprints);
+            const Person::Id found_person = m_knownFaces.find(faceInfo.fingerprint.fingerprint());
 
-            if (pos >=0)
-            {
-                const std::vector<Person::Id>& known_people = std::get<1>(people_fingerprints);
-                const Person::Id found_person = known_people[pos];
+            if (found_person.valid())
                 faceInfo.person = personData(found_person);
-            }
         }
 }
 
@@ -322,6 +299,25 @@ void PeopleManipulator::store_fingerprints()
 }
 
 
+void PeopleManipulator::update_known_faces()
+{
+    // called before faces are updated with new people ids
+    for (const auto& face: m_faces)
+    {
+        const Person::Id& previous = face.face.p_id;
+        const Person::Id& current = face.person.id();
+
+        if (previous != current)
+        {
+            const Person::Fingerprint& fingerprint = face.fingerprint.fingerprint();
+
+            m_knownFaces.remove(previous, fingerprint);
+            m_knownFaces.add(current, fingerprint);
+        }
+    }
+}
+
+
 void PeopleManipulator::store_people_information()
 {
     for (const auto& face: m_faces)
@@ -366,32 +362,6 @@ std::vector<PersonInfo> PeopleManipulator::fetchPeopleFromDb() const
 }
 
 
-std::tuple<std::vector<Person::Fingerprint>, std::vector<Person::Id>> PeopleManipulator::fetchPeopleAndFingerprints() const
-{
-    typedef std::tuple<std::vector<Person::Fingerprint>, std::vector<Person::Id>> Result;
-
-    return evaluate<Result(Database::IBackend &)>(m_db, [](Database::IBackend& backend)
-    {
-        std::vector<Person::Fingerprint> people_fingerprints;
-        std::vector<Person::Id> people;
-
-        const auto all_people = backend.peopleInformationAccessor().listPeople();
-        for(const auto& person: all_people)
-        {
-            const auto fingerprints = backend.peopleInformationAccessor().fingerprintsFor(person.id());
-
-            if (fingerprints.empty() == false)
-            {
-                people_fingerprints.push_back(average_fingerprint(fingerprints));
-                people.push_back(person.id());
-            }
-        }
-
-        return std::tuple(people_fingerprints, people);
-    });
-}
-
-
 std::map<PersonInfo::Id, PersonFingerprint> PeopleManipulator::fetchFingerprints(const std::vector<PersonInfo::Id>& ids) const
 {
     typedef std::map<PersonInfo::Id, PersonFingerprint> Result;
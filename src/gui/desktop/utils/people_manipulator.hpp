@@ -24,13 +24,14 @@
 #include <database/idatabase.hpp>
 
 struct ICoreFactoryAccessor;
+class KnownFacesIndex;
 
 class PeopleManipulator: public QObject
 {
         Q_OBJECT
 
     public:
-        PeopleManipulator(const Photo::Id &, Database::IDatabase &, ICoreFactoryAccessor &);
+        PeopleManipulator(const Photo::Id &, Database::IDatabase &, ICoreFactoryAccessor &, KnownFacesIndex &);
         ~PeopleManipulator();
 
         std::size_t facesCount() const;
@@ -62,6 +63,7 @@ class PeopleManipulator: public QObject
         Photo::Id m_pid;
         ICoreFactoryAccessor& m_core;
         Database::IDatabase& m_db;
+        KnownFacesIndex& m_knownFaces;
 
         void runOnThread(void (PeopleManipulator::*)());
 
@@ -79,10 +81,10 @@ class PeopleManipulator: public QObject
         void store_people_names();
         void store_fingerprints();
         void store_people_information();
+        void update_known_faces();
 
         std::vector<QRect> fetchFacesFromDb() const;
         std::vector<PersonInfo> fetchPeopleFromDb() const;
-        std::tuple<std::vector<Person::Fingerprint>, std::vector<Person::Id>> fetchPeopleAndFingerprints() const;
         std::map<PersonInfo::Id, PersonFingerprint> fetchFingerprints(const std::vector<PersonInfo::Id>& ids) const;
         std::vector<PersonName> fetchPeople() const;
         PersonName personData(const Person::Id& id) const;
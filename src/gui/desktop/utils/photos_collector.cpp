@@ -40,7 +40,7 @@ PhotosCollector::~PhotosCollector()
 }
 
 
-void PhotosCollector::collect(const QString& path, const std::function<void(const QString &)>& callback)
+void PhotosCollector::collect(const QString& path, const std::function<void(const QStringList &)>& callback, DirectoriesSnapshot* snapshot)
 {
     stop();
 
@@ -54,6 +54,7 @@ void PhotosCollector::collect(const QString& path, const std::function<void(cons
     const QStringList to_ignore { internals };
 
     scanner->ignorePaths(to_ignore);
+    scanner->setSnapshot(snapshot);
 
     m_crawler = std::make_unique<PhotoCrawler>(std::move(scanner), std::move(analyzer) );
     m_crawler->crawl(path, this);
@@ -67,7 +68,7 @@ void PhotosCollector::stop()
 }
 
 
-void PhotosCollector::found(const QString& path)
+void PhotosCollector::found(const QStringList& paths)
 {
-    m_callback(path);
+    m_callback(paths);
 }
@@ -28,6 +28,7 @@
 #include <photos_crawler/iphoto_crawler.hpp>
 
 class QString;
+class DirectoriesSnapshot;
 
 struct ITasksView;
 class Project;
@@ -42,7 +43,13 @@ class PhotosCollector: public QObject, public IMediaNotification
         ~PhotosCollector();
         PhotosCollector& operator=(const PhotosCollector& other) = delete;
 
-        void collect(const QString &, const std::function<void(const QString &)> &);
+        /**
+         * \brief collect media files from given directory
+         * \param path directory to be scanned
+         * \param callback callback for found files
+         * \param snapshot optional snapshot of previous scan. Directories which did not change since then are not reported.
+         */
+        void collect(const QString& path, const std::function<void(const QStringList &)>& callback, DirectoriesSnapshot* snapshot = nullptr);
         void stop();
 
     signals:
@@ -50,13 +57,13 @@ class PhotosCollector: public QObject, public IMediaNotification
         void finished() override;
 
     private:
-        std::function<void(const QString &)> m_callback;
+        std::function<void(const QStringList &)> m_callback;
         ITasksView* m_tasksView = nullptr;
         std::unique_ptr<IPhotoCrawler> m_crawler;
         const Project& m_project;
 
         // IMediaNotification:
-        void found(const QString& path) override;
+        void found(const QStringList& paths) override;
 };
 
 #endif // PHOTOSCOLLECTOR_HPP
@@ -30,22 +30,30 @@ using namespace std::placeholders;
 
 
 ThumbnailManager::ThumbnailManager(ITaskExecutor* executor, IThumbnailsGenerator& gen, IThumbnailsCache& cache, std::unique_ptr<ILogger> logger, Database::IDatabase* db):
-    m_tasks(executor, TasksQueue::Mode::Lifo),
+    m_tasks(cache, executor, TasksQueue::Mode::Lifo),
     m_logger(std::move(logger)),
+    m_persistentCache(),
+    m_photosRemovedConnection(),
     m_cache(cache),
     m_generator(gen),
-    m_db(db)
+    m_executor(executor),
+    m_db(db),
+    m_thumbnailsInDatabase(true),
+    m_abortMigration(false)
 {
 }
 
 
 ThumbnailManager::~ThumbnailManager()
 {
+    m_abortMigration = true;
     m_callbackCtrl.invalidate();
+
+    QObject::disconnect(m_photosRemovedConnection);
 }
 
 
-void ThumbnailManager::fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)>& callback)
+void ThumbnailManager::fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)>& callback, const CancellationToken& token)
 {
     std::lock_guard<std::mutex> _(m_cacheMutex);
 
@@ -55,67 +63,31 @@ void ThumbnailManager::fetch(const Photo::Id& id, const QSize& desired_size, con
     const IThumbnailsCache::ThumbnailParameters params(desired_size);
     const QImage cached = find(id, params);
 
-    // not cached in memory, search in db (if possible)
+    // not cached in memory, search in persistent cache or db (if possible)
     if (cached.isNull() && m_db)
     {
         auto task = m_callbackCtrl.make_safe_callback([=, this]()
         {
-            QByteArray dbThumb;
-
-            if (m_db)                   // load thumbnail from db
-                dbThumb = evaluate<QByteArray(Database::IBackend &)>(*m_db, [id](Database::IBackend& backend)
-                {
-                    return backend.getThumbnail(id);
-                });
-
-            QImage baseThumbnail;
-
-            // thumbnail not found - generate one and update database cache
-            if (dbThumb.isNull())
-            {
-                // load path to photo
-                const Photo::DataDelta photoData = evaluate<Photo::DataDelta(Database::IBackend &)>(*m_db, [id](Database::IBackend& backend)
-                {
-                    return backend.getPhotoDelta(id, {Photo::Field::Path});
-                });
-
-                // generate base thumbnail
-                baseThumbnail = m_generator.generate(photoData.get<Photo::Field::Path>(), IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize));
-
-                if (baseThumbnail.isNull())
-                    m_logger->error(QString("Generator returned empty thumbnail for %1").arg(photoData.get<Photo::Field::Path>()));
-                else
-                {
-                    // store thumbnail in db
-                    QBuffer buf(&dbThumb);
-                    baseThumbnail.save(&buf, "JPG");
-
-                    execute<Database::IDatabase>(*m_db, [id, dbThumb](Database::IBackend& backend)
-                    {
-                        backend.setThumbnail(id, dbThumb);
-                    });
-                }
-            }
-            else
-            {
-                baseThumbnail = QImage::fromData(dbThumb, "JPG");
-
-                if (baseThumbnail.isNull())
-                    m_logger->error(QString("Error when loading JPG file from raw data for photo %1").arg(id.value()));
-            }
+            QImage baseThumbnail = loadBaseThumbnail(id);
 
             // handle errors in generation
             if (baseThumbnail.isNull())
                 baseThumbnail.load(":/gui/error.svg");
 
-            // resize base thumbnail to required size
-            const QImage thumbnail = m_generator.generateFrom(baseThumbnail, params);
+            // resize base thumbnail to size preferred by cache
+            const IThumbnailsCache::ThumbnailParameters storageParams = m_cache.storageParameters(params);
+            const QImage storedThumbnail = m_generator.generateFrom(baseThumbnail, storageParams);
+            cache(id, storageParams, storedThumbnail);
+
+            // and then to required size
+            const QImage thumbnail = storageParams == params?
+                storedThumbnail:
+                m_generator.generateFrom(storedThumbnail, params);
 
-            cache(id, params, thumbnail);
             callback(thumbnail);
         });
 
-        m_tasks.add(inlineTask("database thumbnail fetch", task));
+        m_tasks.add(inlineTask("database thumbnail fetch", task, ITaskExecutor::Priority::Interactive, token));
     }
     else
         callback(cached);
@@ -132,13 +104,32 @@ std::optional<QImage> ThumbnailManager::fetch(const Photo::Id& id, const QSize&
 }
 
 
-void ThumbnailManager::setDatabaseCache(Database::IDatabase* db)
+void ThumbnailManager::setDatabaseCache(Database::IDatabase* db, std::unique_ptr<IThumbnailsCache> persistentCache)
 {
     std::lock_guard<std::mutex> _(m_cacheMutex);
 
+    m_abortMigration = true;
     m_callbackCtrl.invalidate();
+    m_abortMigration = false;
+
+    QObject::disconnect(m_photosRemovedConnection);
+
     m_db = db;
+    m_persistentCache = std::move(persistentCache);
+    m_thumbnailsInDatabase = true;
     m_cache.clear();
+
+    if (m_db)
+    {
+        auto removed = m_callbackCtrl.make_safe_callback<const std::vector<Photo::Id> &>(std::bind(&ThumbnailManager::photosRemoved, this, _1));
+        m_photosRemovedConnection = QObject::connect(&m_db->backend(), &Database::IBackend::photosRemoved, removed);
+
+        if (m_persistentCache)
+        {
+            auto migration = m_callbackCtrl.make_safe_callback<>(std::bind(&ThumbnailManager::migrateThumbnails, this));
+            runOn(*m_executor, migration, ITaskExecutor::Priority::Background, "ThumbnailManager: thumbnails migration");
+        }
+    }
 }
 
 
@@ -159,3 +150,137 @@ void ThumbnailManager::cache(const Photo::Id& id, const IThumbnailsCache::Thumbn
 {
     m_cache.store(id, params, img);
 }
+
+
+QImage ThumbnailManager::loadBaseThumbnail(const Photo::Id& id)
+{
+    const IThumbnailsCache::ThumbnailParameters baseParams(Parameters::databaseThumbnailSize);
+
+    // persistent cache does not involve database thread, check it first
+    if (m_persistentCache)
+    {
+        const std::optional<QImage> stored = m_persistentCache->find(id, baseParams);
+
+        if (stored.has_value())
+            return *stored;
+    }
+
+    QByteArray dbThumb;
+
+    // load thumbnail from db (no persistent cache or thumbnails not migrated yet)
+    if (m_thumbnailsInDatabase)
+    {
+        Database::ReadOnlyDatabase db{*m_db};
+
+        dbThumb = evaluate<QByteArray(Database::IBackend &)>(db, [id](Database::IBackend& backend)
+        {
+            return backend.getThumbnail(id);
+        });
+    }
+
+    QImage baseThumbnail;
+
+    // thumbnail not found - generate one and update cache
+    if (dbThumb.isNull())
+    {
+        baseThumbnail = generateBaseThumbnail(id);
+
+        if (baseThumbnail.isNull() == false)
+            storeBaseThumbnail(id, baseThumbnail);
+    }
+    else
+    {
+        baseThumbnail = QImage::fromData(dbThumb, "JPG");
+
+        if (baseThumbnail.isNull())
+            m_logger->error(QString("Error when loading JPG file from raw data for photo %1").arg(id.value()));
+    }
+
+    return baseThumbnail;
+}
+
+
+QImage ThumbnailManager::generateBaseThumbnail(const Photo::Id& id)
+{
+    // load path to photo
+    Database::ReadOnlyDatabase db{*m_db};
+
+    const Photo::DataDelta photoData = evaluate<Photo::DataDelta(Database::IBackend &)>(db, [id](Database::IBackend& backend)
+    {
+        return backend.getPhotoDelta(id, {Photo::Field::Path});
+    });
+
+    // generate base thumbnail
+    const QImage baseThumbnail = m_generator.generate(photoData.get<Photo::Field::Path>(), IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize));
+
+    if (baseThumbnail.isNull())
+        m_logger->error(QString("Generator returned empty thumbnail for %1").arg(photoData.get<Photo::Field::Path>()));
+
+    return baseThumbnail;
+}
+
+
+void ThumbnailManager::storeBaseThumbnail(const Photo::Id& id, const QImage& baseThumbnail)
+{
+    if (m_persistentCache)
+        m_persistentCache->store(id, IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize), baseThumbnail);
+    else
+    {
+        // store thumbnail in db
+        QByteArray dbThumb;
+        QBuffer buf(&dbThumb);
+        baseThumbnail.save(&buf, "JPG");
+
+        execute<Database::IDatabase>(*m_db, [id, dbThumb](Database::IBackend& backend)
+        {
+            backend.setThumbnail(id, dbThumb);
+        });
+    }
+}
+
+
+void ThumbnailManager::migrateThumbnails()
+{
+    const IThumbnailsCache::ThumbnailParameters baseParams(Parameters::databaseThumbnailSize);
+    std::size_t migrated = 0;
+
+    // move thumbnails in small chunks, so migration can be interrupted quickly
+    while(m_abortMigration == false)
+    {
+        const auto thumbnails = evaluate<std::vector<std::pair<Photo::Id, QByteArray>>(Database::IBackend &)>(*m_db, [](Database::IBackend& backend)
+        {
+            return backend.takeThumbnails(50);
+        });
+
+        if (thumbnails.empty())
+        {
+            m_thumbnailsInDatabase = false;
+            break;
+        }
+
+        for(const auto& [id, data]: thumbnails)
+        {
+            const QImage thumbnail = QImage::fromData(data, "JPG");
+
+            if (thumbnail.isNull() == false)
+                m_persistentCache->store(id, baseParams, thumbnail);
+        }
+
+        migrated += thumbnails.size();
+    }
+
+    if (migrated > 0)
+        m_logger->info(QString("%1 thumbnails moved from database to disk cache").arg(migrated));
+}
+
+
+void ThumbnailManager::photosRemoved(const std::vector<Photo::Id>& ids)
+{
+    for(const auto& id: ids)
+    {
+        m_cache.remove(id);
+
+        if (m_persistentCache)
+            m_persistentCache->remove(id);
+    }
+}
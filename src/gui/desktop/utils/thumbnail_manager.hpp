@@ -19,6 +19,7 @@
 #ifndef THUMBNAILMANAGER_HPP
 #define THUMBNAILMANAGER_HPP
 
+#include <atomic>
 #include <memory>
 #include <optional>
 
@@ -43,22 +44,59 @@ class ThumbnailManager: public IThumbnailsManager
         explicit ThumbnailManager(ITaskExecutor *, IThumbnailsGenerator &, IThumbnailsCache &, std::unique_ptr<ILogger>, Database::IDatabase * = nullptr);
         ~ThumbnailManager();
 
-        void fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)> &) override;
+        void fetch(const Photo::Id& id, const QSize& desired_size, const std::function<void(const QImage &)> &, const CancellationToken& = CancellationToken()) override;
         std::optional<QImage> fetch(const Photo::Id& id, const QSize& desired_size) override;
 
-        void setDatabaseCache(Database::IDatabase *) override;
+        void setDatabaseCache(Database::IDatabase *, std::unique_ptr<IThumbnailsCache> = {}) override;
 
     private:
+        // tasks queue exposing cache statistics in debug view
+        class ObservableTasksQueue: public ObservableTaskExecutor<TasksQueue>
+        {
+            public:
+                ObservableTasksQueue(const IThumbnailsCache& cache, ITaskExecutor* executor, Mode mode)
+                    : ObservableTaskExecutor<TasksQueue>(executor, mode)
+                    , m_cache(cache)
+                {
+
+                }
+
+                QString name() const override
+                {
+                    return "ThumbnailManager";
+                }
+
+            protected:
+                QVariantMap collectStatistics() const override
+                {
+                    return m_cache.statistics();
+                }
+
+            private:
+                const IThumbnailsCache& m_cache;
+        };
+
         safe_callback_ctrl m_callbackCtrl;
-        ObservableTaskExecutor<TasksQueue> m_tasks;
+        ObservableTasksQueue m_tasks;
         std::unique_ptr<ILogger> m_logger;
+        std::unique_ptr<IThumbnailsCache> m_persistentCache;
+        QMetaObject::Connection m_photosRemovedConnection;
         IThumbnailsCache& m_cache;
         IThumbnailsGenerator& m_generator;
+        ITaskExecutor* m_executor;
         Database::IDatabase* m_db;
         std::mutex m_cacheMutex;
+        std::atomic<bool> m_thumbnailsInDatabase;
+        std::atomic<bool> m_abortMigration;
 
         QImage find(const Photo::Id &, const IThumbnailsCache::ThumbnailParameters &);
         void cache(const Photo::Id &, const IThumbnailsCache::ThumbnailParameters &, const QImage &);
+
+        QImage loadBaseThumbnail(const Photo::Id &);
+        QImage generateBaseThumbnail(const Photo::Id &);
+        void storeBaseThumbnail(const Photo::Id &, const QImage &);
+        void migrateThumbnails();
+        void photosRemoved(const std::vector<Photo::Id> &);
 };
 
 #endif // THUMBNAILMANAGER_HPP
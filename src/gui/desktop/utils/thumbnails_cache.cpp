@@ -16,51 +16,212 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <array>
+
 #include "thumbnails_cache.hpp"
 
 
-uint qHash(const IThumbnailsCache::ThumbnailParameters& params)
+namespace
+{
+    // sizes of thumbnails kept in cache
+    constexpr std::array<int, 5> Levels = {32, 64, 128, 256, 512};
+
+    int edgeOf(const QSize& size)
+    {
+        return std::max(size.width(), size.height());
+    }
+
+    // image is big enough to be scaled down to requested size
+    bool covers(const QImage& image, const QSize& size)
+    {
+        return image.width() >= size.width() && image.height() >= size.height();
+    }
+
+    // image already has size ThumbnailGenerator would produce for requested size
+    bool fits(const QImage& image, const QSize& size)
+    {
+        return image.width() < image.height()?
+            image.width() == size.width():
+            image.height() == size.height();
+    }
+
+    // same scaling rules as ThumbnailGenerator uses
+    QImage downscale(const QImage& image, const QSize& size)
+    {
+        return image.width() < image.height()?
+            image.scaledToWidth(size.width(), Qt::SmoothTransformation):
+            image.scaledToHeight(size.height(), Qt::SmoothTransformation);
+    }
+}
+
+
+ThumbnailsCache::ThumbnailsCache(qint64 budget)
+{
+    m_data.lock()->budget = budget;
+}
+
+
+std::optional<QImage> ThumbnailsCache::find(const Photo::Id& id, const ThumbnailParameters& params)
 {
     const QSize& size = std::get<0>(params);
+    std::optional<QImage> source;
+    bool exactMatch = false;
+
+    {
+        auto data = m_data.lock();
+
+        auto photoIt = data->levels.find(id);
+
+        if (size.isEmpty() == false && photoIt != data->levels.end())
+        {
+            // find smallest level which covers requested size.
+            // Levels are keyed by sizes of stored images, so they are ordered from the smallest one.
+            auto& levels = photoIt->second;
+            auto levelIt = std::ranges::find_if(levels, [&size](const auto& entry)
+            {
+                return covers(entry.second.image, size);
+            });
+
+            if (levelIt != levels.end())
+            {
+                Level& level = levelIt->second;
+
+                data->lru.splice(data->lru.begin(), data->lru, level.lruPosition);
+
+                source = level.image;                   // implicitly shared, no pixels are copied
+                exactMatch = fits(level.image, size);
+            }
+        }
+
+        if (source.has_value())
+            data->hits++;
+        else
+            data->misses++;
+    }
+
+    if (source.has_value() == false || exactMatch)
+        return source;
+
+    // scale without blocking other cache users and keep result for next requests of the same size
+    const QImage scaled = downscale(*source, size);
+    store(id, params, scaled);
+
+    return scaled;
+}
+
+
+void ThumbnailsCache::store(const Photo::Id& id, const ThumbnailParameters &, const QImage& img)
+{
+    // thumbnails are scaled by shorter edge, so they may be much smaller than requested size.
+    // Use actual size of image as a key.
+    const LevelKey key(id, edgeOf(img.size()));
+
+    auto data = m_data.lock();
+
+    removeLevel(*data, key);
+
+    data->lru.push_front(key);
+    data->levels[id][key.second] = Level{ img, data->lru.begin() };
+    data->usedBytes += img.sizeInBytes();
+
+    evict(*data);
+}
+
 
-    return qHash(size.width()) ^ qHash(size.height());
+void ThumbnailsCache::remove(const Photo::Id& id)
+{
+    auto data = m_data.lock();
+    auto photoIt = data->levels.find(id);
+
+    if (photoIt != data->levels.end())
+    {
+        for(const auto& [edge, level]: photoIt->second)
+        {
+            data->usedBytes -= level.image.sizeInBytes();
+            data->lru.erase(level.lruPosition);
+        }
+
+        data->levels.erase(photoIt);
+    }
 }
 
-uint qHash(const std::tuple<Photo::Id, IThumbnailsCache::ThumbnailParameters>& key)
+
+void ThumbnailsCache::clear()
 {
-    const Photo::Id& id = std::get<0>(key);
-    const IThumbnailsCache::ThumbnailParameters& params = std::get<1>(key);
+    auto data = m_data.lock();
 
-    return qHash(id.value()) ^ qHash(params);
+    data->levels.clear();
+    data->lru.clear();
+    data->usedBytes = 0;
 }
 
 
-ThumbnailsCache::ThumbnailsCache(): m_cache(1024)
+IThumbnailsCache::ThumbnailParameters ThumbnailsCache::storageParameters(const ThumbnailParameters& params) const
 {
+    const QSize& size = std::get<0>(params);
+    const auto levelIt = std::lower_bound(Levels.begin(), Levels.end(), edgeOf(size));
+
+    // sizes bigger than biggest level are stored as they are
+    return size.isEmpty() || levelIt == Levels.end()?
+        params:
+        ThumbnailParameters(QSize(*levelIt, *levelIt));
 }
 
 
-std::optional<QImage> ThumbnailsCache::find(const Photo::Id& id, const ThumbnailParameters& params)
+QVariantMap ThumbnailsCache::statistics() const
 {
-    std::optional<QImage> result;
+    auto data = m_data.lock();
+
+    return {
+        { "hits", data->hits },
+        { "misses", data->misses },
+        { "evictions", data->evictions },
+        { "usedBytes", data->usedBytes },
+        { "budget", data->budget },
+        { "levels", static_cast<qint64>(data->lru.size()) },
+    };
+}
 
-    QImage* img = m_cache.lock()->object(std::tie(id, params));
 
-    if (img)
-        result = *img;
+void ThumbnailsCache::setBudget(qint64 bytes)
+{
+    auto data = m_data.lock();
 
-    return result;
+    data->budget = bytes;
+    evict(*data);
 }
 
 
-void ThumbnailsCache::store(const Photo::Id& id, const ThumbnailParameters& params, const QImage& img)
+void ThumbnailsCache::removeLevel(Data& data, const LevelKey& key)
 {
-    QImage* copy = new QImage(img);
-    m_cache.lock()->insert(std::tie(id, params), copy);
+    auto photoIt = data.levels.find(key.first);
+
+    if (photoIt != data.levels.end())
+    {
+        auto& levels = photoIt->second;
+        auto levelIt = levels.find(key.second);
+
+        if (levelIt != levels.end())
+        {
+            data.usedBytes -= levelIt->second.image.sizeInBytes();
+            data.lru.erase(levelIt->second.lruPosition);
+            levels.erase(levelIt);
+        }
+
+        if (levels.empty())
+            data.levels.erase(photoIt);
+    }
 }
 
 
-void ThumbnailsCache::clear()
+void ThumbnailsCache::evict(Data& data)
 {
-    m_cache.lock()->clear();
+    while (data.usedBytes > data.budget && data.lru.empty() == false)
+    {
+        const LevelKey key = data.lru.back();
+        removeLevel(data, key);
+
+        data.evictions++;
+    }
 }
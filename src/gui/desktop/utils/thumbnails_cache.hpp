@@ -19,24 +19,60 @@
 #ifndef THUMBNAILS_CACHE_HPP
 #define THUMBNAILS_CACHE_HPP
 
-#include <QCache>
+#include <list>
+#include <map>
 
 #include <core/ts_resource.hpp>
 #include "ithumbnails_cache.hpp"
 
 
+/**
+ * @brief Memory cache for thumbnails
+ *
+ * For each photo a small set of levels (thumbnails with power of two sizes) is kept.
+ * Levels are identified by sizes of stored images (not by sizes they were requested for).
+ * Requests for any size are served by downscaling the smallest level covering requested size.
+ * Downscaled images are kept in cache as well, so repeated requests do not scale again.
+ * Cache is limited by memory budget, least recently used levels are evicted first.
+ */
 class ThumbnailsCache: public IThumbnailsCache
 {
     public:
-        ThumbnailsCache();
+        explicit ThumbnailsCache(qint64 budget = 64 * 1024 * 1024);
 
         std::optional<QImage> find(const Photo::Id &, const ThumbnailParameters &) override;
         void store(const Photo::Id &, const ThumbnailParameters &, const QImage &) override;
+        void remove(const Photo::Id &) override;
         void clear() override;
+        ThumbnailParameters storageParameters(const ThumbnailParameters &) const override;
+        QVariantMap statistics() const override;
+
+        void setBudget(qint64 bytes);
 
     private:
-        typedef QCache<std::tuple<Photo::Id, ThumbnailParameters>, QImage> CacheContainer;
-        ol::ThreadSafeResource<CacheContainer> m_cache;
+        typedef std::pair<Photo::Id, int> LevelKey;
+
+        struct Level
+        {
+            QImage image;
+            std::list<LevelKey>::iterator lruPosition;
+        };
+
+        struct Data
+        {
+            std::map<Photo::Id, std::map<int, Level>> levels;
+            std::list<LevelKey> lru;                    // most recently used at front
+            qint64 budget = 0;
+            qint64 usedBytes = 0;
+            qint64 hits = 0;
+            qint64 misses = 0;
+            qint64 evictions = 0;
+        };
+
+        mutable ol::ThreadSafeResource<Data> m_data;
+
+        static void removeLevel(Data &, const LevelKey &);
+        static void evict(Data &);
 };
 
 #endif
@@ -7,7 +7,6 @@ namespace gui::features
 {
     const char* const MngFile      = "gui::image::mng";
     const char* const ToolMagick   = "gui::tool::magick";
-    const char* const ToolAIS      = "gui::tool::align_image_stack";
     const char* const ToolFFMpeg   = "gui::tool::ffmpeg";
     const char* const ToolExifTool = "gui::tool::exiftool";
 }
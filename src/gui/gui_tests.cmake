@@ -13,6 +13,8 @@ addTestTarget(gui
                     desktop/models/flat_model.cpp
                     desktop/utils/model_index_utils.cpp
                     desktop/quick_items/selection_manager_component.cpp
+                    desktop/utils/disk_thumbnails_cache.cpp
+                    desktop/utils/known_faces_index.cpp
                     desktop/utils/thumbnail_manager.cpp
                     desktop/utils/thumbnails_cache.cpp
                     desktop/utils/webp_generator.cpp
@@ -29,6 +31,8 @@ addTestTarget(gui
                     unit_tests/test_helpers/internal_task_executor.hpp
 
                     # utils:
+                    unit_tests/utils/disk_thumbnails_cache_tests.cpp
+                    unit_tests/utils/known_faces_index_tests.cpp
                     unit_tests/utils/model_index_utils_tests.cpp
                     unit_tests/utils/selection_manager_component_tests.cpp
                     unit_tests/utils/thumbnails_manager_tests.cpp
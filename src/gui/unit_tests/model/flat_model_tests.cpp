@@ -106,6 +106,33 @@ TEST_F(FlatModelTest, dataAppended)
 }
 
 
+TEST_F(FlatModelTest, outdatedResultsAreIgnored)
+{
+    const auto older_photos_set = std::vector<Photo::Id>{Photo::Id(1), Photo::Id(2)};
+    const auto newer_photos_set = std::vector<Photo::Id>{Photo::Id(3)};
+
+    // keep tasks, so they can be executed in any order
+    std::vector<std::unique_ptr<Database::IDatabase::ITask>> tasks;
+    ON_CALL(db, execute(_)).WillByDefault(Invoke([&tasks](std::unique_ptr<Database::IDatabase::ITask>&& task)
+    {
+        tasks.push_back(std::move(task));
+    }));
+
+    model.setDatabase(&db);
+    model.setFilter({});
+    ASSERT_EQ(tasks.size(), 2);
+
+    EXPECT_CALL(photoOperator, onPhotos(_, _))
+        .WillOnce(Return(newer_photos_set))         // most recent request finishes first
+        .WillOnce(Return(older_photos_set));
+
+    tasks[1]->run(backend);
+    tasks[0]->run(backend);
+
+    EXPECT_EQ(newer_photos_set, model.photos());
+}
+
+
 TEST_F(FlatModelTest, dataPrepended)
 {
     const auto initial_photos_set = std::vector<Photo::Id>{Photo::Id(1), Photo::Id(2), Photo::Id(3)};
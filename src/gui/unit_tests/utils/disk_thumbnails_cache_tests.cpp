@@ -0,0 +1,86 @@
+#include <gmock/gmock.h>
+#include <QTemporaryDir>
+
+#include "gui/desktop/utils/disk_thumbnails_cache.hpp"
+
+
+class DiskThumbnailsCacheTest: public testing::Test
+{
+    public:
+        DiskThumbnailsCacheTest()
+            : cache(dir.path())
+        {
+
+        }
+
+        QTemporaryDir dir;
+        DiskThumbnailsCache cache;
+};
+
+
+TEST_F(DiskThumbnailsCacheTest, returnsNothingWhenEmpty)
+{
+    const std::optional img1 = cache.find(Photo::Id(1), QSize(100, 100));
+    const std::optional img2 = cache.find(Photo::Id(300), QSize(100, 100));
+
+    EXPECT_FALSE(img1.has_value());
+    EXPECT_FALSE(img2.has_value());
+}
+
+
+TEST_F(DiskThumbnailsCacheTest, returnsWhatWasStored)
+{
+    QImage img(200, 100, QImage::Format_RGB32);
+    img.fill(Qt::red);
+
+    cache.store(Photo::Id(1), QSize(100, 100), img);
+
+    const std::optional img1a = cache.find(Photo::Id(1), QSize(100, 100));
+    const std::optional img1b = cache.find(Photo::Id(1), QSize(200, 200));
+    const std::optional img2 = cache.find(Photo::Id(2), QSize(100, 100));
+
+    ASSERT_TRUE(img1a.has_value());
+    EXPECT_EQ(img1a->size(), img.size());
+    EXPECT_FALSE(img1b.has_value());
+    EXPECT_FALSE(img2.has_value());
+}
+
+
+TEST_F(DiskThumbnailsCacheTest, thumbnailsSurviveCacheRecreation)
+{
+    const QImage img(200, 100, QImage::Format_RGB32);
+    cache.store(Photo::Id(5), QSize(100, 100), img);
+
+    DiskThumbnailsCache otherCache(dir.path());
+    const std::optional stored = otherCache.find(Photo::Id(5), QSize(100, 100));
+
+    EXPECT_TRUE(stored.has_value());
+}
+
+
+TEST_F(DiskThumbnailsCacheTest, removesAllThumbnailsOfPhoto)
+{
+    const QImage img(200, 100, QImage::Format_RGB32);
+    cache.store(Photo::Id(5), QSize(100, 100), img);
+    cache.store(Photo::Id(5), QSize(50, 50), img);
+    cache.store(Photo::Id(55), QSize(100, 100), img);
+
+    cache.remove(Photo::Id(5));
+
+    EXPECT_FALSE(cache.find(Photo::Id(5), QSize(100, 100)).has_value());
+    EXPECT_FALSE(cache.find(Photo::Id(5), QSize(50, 50)).has_value());
+    EXPECT_TRUE(cache.find(Photo::Id(55), QSize(100, 100)).has_value());
+}
+
+
+TEST_F(DiskThumbnailsCacheTest, clearRemovesEverything)
+{
+    const QImage img(200, 100, QImage::Format_RGB32);
+    cache.store(Photo::Id(5), QSize(100, 100), img);
+    cache.store(Photo::Id(6), QSize(100, 100), img);
+
+    cache.clear();
+
+    EXPECT_FALSE(cache.find(Photo::Id(5), QSize(100, 100)).has_value());
+    EXPECT_FALSE(cache.find(Photo::Id(6), QSize(100, 100)).has_value());
+}
@@ -0,0 +1,103 @@
+
+#include <gmock/gmock.h>
+
+#include "database/backends/memory_backend/memory_backend.hpp"
+#include "unit_tests_utils/mock_database.hpp"
+#include "utils/known_faces_index.hpp"
+
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace
+{
+    Person::Fingerprint fingerprint(double value)
+    {
+        return Person::Fingerprint(128, value);
+    }
+}
+
+
+class KnownFacesIndexTest: public testing::Test
+{
+    public:
+        KnownFacesIndexTest()
+        {
+            ON_CALL(db, execute(_)).WillByDefault(Invoke([this](std::unique_ptr<Database::IDatabase::ITask>&& task)
+            {
+                task->run(backend);
+            }));
+        }
+
+        Database::MemoryBackend backend;
+        NiceMock<MockDatabase> db;
+};
+
+
+TEST_F(KnownFacesIndexTest, emptyIndexFindsNoOne)
+{
+    KnownFacesIndex index(db);
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.find(fingerprint(0.1)).valid());
+}
+
+
+TEST_F(KnownFacesIndexTest, findsClosestPerson)
+{
+    KnownFacesIndex index(db);
+    ASSERT_EQ(index.size(), 0);                         // load index
+
+    index.add(Person::Id(1), fingerprint(0.1));
+    index.add(Person::Id(2), fingerprint(0.2));
+    index.add(Person::Id(3), fingerprint(0.3));
+
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_EQ(index.find(fingerprint(0.11)), Person::Id(1));
+    EXPECT_EQ(index.find(fingerprint(0.19)), Person::Id(2));
+    EXPECT_EQ(index.find(fingerprint(0.31)), Person::Id(3));
+}
+
+
+TEST_F(KnownFacesIndexTest, ignoresTooDistantFaces)
+{
+    KnownFacesIndex index(db);
+    ASSERT_EQ(index.size(), 0);
+
+    index.add(Person::Id(1), fingerprint(0.1));
+
+    // distance = sqrt(128 * 0.1^2) ~= 1.13
+    EXPECT_FALSE(index.find(fingerprint(0.2)).valid());
+}
+
+
+TEST_F(KnownFacesIndexTest, usesAverageFingerprintOfPerson)
+{
+    KnownFacesIndex index(db);
+    ASSERT_EQ(index.size(), 0);
+
+    index.add(Person::Id(1), fingerprint(0.0));
+    index.add(Person::Id(1), fingerprint(0.4));
+    index.add(Person::Id(2), fingerprint(0.25));
+
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(index.find(fingerprint(0.2)), Person::Id(1));
+
+    index.remove(Person::Id(1), fingerprint(0.4));      // average of person 1 is 0.0 now
+    EXPECT_EQ(index.find(fingerprint(0.2)), Person::Id(2));
+}
+
+
+TEST_F(KnownFacesIndexTest, personWithoutFacesIsRemoved)
+{
+    KnownFacesIndex index(db);
+    ASSERT_EQ(index.size(), 0);
+
+    index.add(Person::Id(1), fingerprint(0.1));
+    index.add(Person::Id(2), fingerprint(0.3));
+    index.remove(Person::Id(1), fingerprint(0.1));
+
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.find(fingerprint(0.28)), Person::Id(2));
+}
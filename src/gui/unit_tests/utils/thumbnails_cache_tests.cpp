@@ -63,3 +63,135 @@ TEST(ThumbnailsCacheTest, returnsWhatWasStored)
     EXPECT_TRUE(img3b.has_value());
     EXPECT_FALSE(img3c.has_value());
 }
+
+
+TEST(ThumbnailsCacheTest, servesSmallerSizesFromBiggerLevels)
+{
+    const QImage img(256, 128, QImage::Format_RGB32);
+
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(128, 128), img);
+
+    const std::optional smaller = cache.find(Photo::Id(1), QSize(100, 100));
+    const std::optional bigger = cache.find(Photo::Id(1), QSize(130, 130));
+
+    ASSERT_TRUE(smaller.has_value());
+    EXPECT_EQ(smaller->height(), 100);
+    EXPECT_FALSE(bigger.has_value());
+}
+
+
+TEST(ThumbnailsCacheTest, keepsDownscaledImages)
+{
+    const QImage img(256, 128, QImage::Format_RGB32);
+
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(128, 128), img);
+
+    const std::optional first = cache.find(Photo::Id(1), QSize(100, 100));
+    const std::optional second = cache.find(Photo::Id(1), QSize(100, 100));
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->cacheKey(), second->cacheKey());     // second request served from cache, not scaled again
+    EXPECT_EQ(cache.statistics()["levels"].toLongLong(), 2);
+}
+
+
+TEST(ThumbnailsCacheTest, levelsSmallerThanRequestedSizeAreNotUsed)
+{
+    // panorama stored for 600x600 request is much smaller than requested size
+    const QImage img(600, 100, QImage::Format_RGB32);
+
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(600, 600), img);
+
+    const std::optional undersized = cache.find(Photo::Id(1), QSize(600, 600));
+    const std::optional matching = cache.find(Photo::Id(1), QSize(600, 100));
+
+    EXPECT_FALSE(undersized.has_value());
+    ASSERT_TRUE(matching.has_value());
+    EXPECT_EQ(matching->size(), QSize(600, 100));
+}
+
+
+TEST(ThumbnailsCacheTest, smallestCoveringLevelIsUsed)
+{
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(256, 256), QImage(512, 256, QImage::Format_RGB32));
+    cache.store(Photo::Id(1), QSize(64, 64), QImage(128, 64, QImage::Format_RGB32));
+
+    const std::optional img = cache.find(Photo::Id(1), QSize(64, 64));
+
+    ASSERT_TRUE(img.has_value());
+    EXPECT_EQ(img->size(), QSize(128, 64));
+    EXPECT_EQ(cache.statistics()["levels"].toLongLong(), 2);       // exact match, nothing new stored
+}
+
+
+TEST(ThumbnailsCacheTest, storageParametersAreRoundedUpToLevels)
+{
+    ThumbnailsCache cache;
+
+    EXPECT_EQ(cache.storageParameters(QSize(100, 100)), IThumbnailsCache::ThumbnailParameters(QSize(128, 128)));
+    EXPECT_EQ(cache.storageParameters(QSize(128, 128)), IThumbnailsCache::ThumbnailParameters(QSize(128, 128)));
+    EXPECT_EQ(cache.storageParameters(QSize(10, 20)), IThumbnailsCache::ThumbnailParameters(QSize(32, 32)));
+    EXPECT_EQ(cache.storageParameters(QSize(600, 600)), IThumbnailsCache::ThumbnailParameters(QSize(600, 600)));
+}
+
+
+TEST(ThumbnailsCacheTest, evictsLeastRecentlyUsedWhenOverBudget)
+{
+    const QImage img(64, 64, QImage::Format_RGB32);
+
+    ThumbnailsCache cache(img.sizeInBytes() * 2);
+    cache.store(Photo::Id(1), QSize(64, 64), img);
+    cache.store(Photo::Id(2), QSize(64, 64), img);
+
+    // touch first one so second becomes least recently used
+    cache.find(Photo::Id(1), QSize(64, 64));
+
+    cache.store(Photo::Id(3), QSize(64, 64), img);
+
+    EXPECT_TRUE(cache.find(Photo::Id(1), QSize(64, 64)).has_value());
+    EXPECT_FALSE(cache.find(Photo::Id(2), QSize(64, 64)).has_value());
+    EXPECT_TRUE(cache.find(Photo::Id(3), QSize(64, 64)).has_value());
+
+    const QVariantMap stats = cache.statistics();
+    EXPECT_EQ(stats["evictions"].toLongLong(), 1);
+    EXPECT_EQ(stats["usedBytes"].toLongLong(), img.sizeInBytes() * 2);
+}
+
+
+TEST(ThumbnailsCacheTest, countsHitsAndMisses)
+{
+    const QImage img(64, 64, QImage::Format_RGB32);
+
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(64, 64), img);
+
+    cache.find(Photo::Id(1), QSize(64, 64));
+    cache.find(Photo::Id(1), QSize(32, 32));
+    cache.find(Photo::Id(2), QSize(64, 64));
+
+    const QVariantMap stats = cache.statistics();
+    EXPECT_EQ(stats["hits"].toLongLong(), 2);
+    EXPECT_EQ(stats["misses"].toLongLong(), 1);
+}
+
+
+TEST(ThumbnailsCacheTest, removesAllLevelsOfPhoto)
+{
+    const QImage img(64, 64, QImage::Format_RGB32);
+
+    ThumbnailsCache cache;
+    cache.store(Photo::Id(1), QSize(64, 64), img);
+    cache.store(Photo::Id(1), QSize(32, 32), img);
+    cache.store(Photo::Id(2), QSize(64, 64), img);
+
+    cache.remove(Photo::Id(1));
+
+    EXPECT_FALSE(cache.find(Photo::Id(1), QSize(32, 32)).has_value());
+    EXPECT_TRUE(cache.find(Photo::Id(2), QSize(64, 64)).has_value());
+    EXPECT_EQ(cache.statistics()["usedBytes"].toLongLong(), img.sizeInBytes());
+}
@@ -1,6 +1,7 @@
 
 #include <gmock/gmock.h>
 
+#include <QBuffer>
 #include <QImage>
 
 #include <core/constants.hpp>
@@ -33,6 +34,11 @@ struct NullCache: IThumbnailsCache
 
     }
 
+    void remove(const Photo::Id &) override
+    {
+
+    }
+
     void clear() override
     {
 
@@ -149,6 +155,28 @@ TEST_F(ThumbnailManagerTest, generatedThumbnailsIsBeingCached)
 }
 
 
+TEST_F(ThumbnailManagerTest, cancelledRequestIsDropped)
+{
+    const Photo::Id id(13);
+    const int height = 100;
+
+    MockResponse response;
+    EXPECT_CALL(response, result).Times(0);
+
+    MockThumbnailsGenerator generator;
+    EXPECT_CALL(generator, generate).Times(0);
+    EXPECT_CALL(generator, generateFrom).Times(0);
+
+    CancellationToken token;
+    token.cancel();
+
+    NullCache cache;
+    ThumbnailManager tm(&executor, generator, cache, std::make_unique<EmptyLogger>());
+    tm.setDatabaseCache(&db);
+    tm.fetch(id, QSize(height, height), [&response](const QImage& _img){response(_img);}, token);
+}
+
+
 TEST_F(ThumbnailManagerTest, doNotGenerateThumbnailFoundInCache)
 {
     const Photo::Id id(11);
@@ -245,3 +273,99 @@ TEST_F(ThumbnailManagerTest, cacheClearOnDbChange)
     tm.setDatabaseCache(&db);
     tm.setDatabaseCache(&db);
 }
+
+
+TEST_F(ThumbnailManagerTest, usePersistentCacheBeforeDatabase)
+{
+    const Photo::Id id(29);
+    const int height = 100;
+    QImage img(height * 2, height, QImage::Format_RGB32);
+    QImage base_img(Parameters::databaseThumbnailSize, QImage::Format_RGB32);
+
+    auto persistentCache = std::make_unique<NiceMock<MockThumbnailsCache>>();
+    EXPECT_CALL(*persistentCache, find(id, IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize))).WillOnce(Return(base_img));
+
+    EXPECT_CALL(backend, getThumbnail).Times(0);
+
+    MockThumbnailsGenerator generator;
+    EXPECT_CALL(generator, generate).Times(0);
+    EXPECT_CALL(generator, generateFrom(base_img, IThumbnailsCache::ThumbnailParameters(QSize(height, height)))).WillOnce(Return(img));
+
+    MockResponse response;
+    EXPECT_CALL(response, result(img)).Times(1);
+
+    NullCache cache;
+    ThumbnailManager tm(&executor, generator, cache, std::make_unique<EmptyLogger>());
+    tm.setDatabaseCache(&db, std::move(persistentCache));
+    tm.fetch(id, QSize(height, height), [&response](const QImage& _img){response(_img);});
+}
+
+
+TEST_F(ThumbnailManagerTest, generatedThumbnailsGoToPersistentCache)
+{
+    const Photo::Id id(31);
+    const int height = 100;
+    QImage img(height * 2, height, QImage::Format_RGB32);
+    QImage base_img(Parameters::databaseThumbnailSize, QImage::Format_RGB32);
+
+    auto persistentCache = std::make_unique<NiceMock<MockThumbnailsCache>>();
+    EXPECT_CALL(*persistentCache, store(id, IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize), base_img)).Times(1);
+
+    EXPECT_CALL(backend, setThumbnail).Times(0);
+
+    MockThumbnailsGenerator generator;
+    EXPECT_CALL(generator, generate(QString("31.jpeg"), IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize))).WillOnce(Return(base_img));
+    EXPECT_CALL(generator, generateFrom(base_img, IThumbnailsCache::ThumbnailParameters(QSize(height, height)))).WillOnce(Return(img));
+
+    NullCache cache;
+    ThumbnailManager tm(&executor, generator, cache, std::make_unique<EmptyLogger>());
+    tm.setDatabaseCache(&db, std::move(persistentCache));
+    tm.fetch(id, QSize(height, height), [](const QImage &){});
+}
+
+
+TEST_F(ThumbnailManagerTest, thumbnailsAreMovedFromDatabaseToPersistentCache)
+{
+    QImage base_img(Parameters::databaseThumbnailSize, QImage::Format_RGB32);
+    base_img.fill(Qt::blue);
+
+    QByteArray base_img_data;
+    QBuffer buf(&base_img_data);
+    base_img.save(&buf, "JPG");
+
+    const std::vector<std::pair<Photo::Id, QByteArray>> thumbnails = {
+        { Photo::Id(1), base_img_data },
+        { Photo::Id(2), base_img_data },
+    };
+
+    EXPECT_CALL(backend, takeThumbnails)
+        .WillOnce(Return(thumbnails))
+        .WillOnce(Return(std::vector<std::pair<Photo::Id, QByteArray>>{}));
+
+    auto persistentCache = std::make_unique<NiceMock<MockThumbnailsCache>>();
+    EXPECT_CALL(*persistentCache, store(Photo::Id(1), IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize), _)).Times(1);
+    EXPECT_CALL(*persistentCache, store(Photo::Id(2), IThumbnailsCache::ThumbnailParameters(Parameters::databaseThumbnailSize), _)).Times(1);
+
+    MockThumbnailsGenerator generator;
+    NullCache cache;
+    ThumbnailManager tm(&executor, generator, cache, std::make_unique<EmptyLogger>());
+    tm.setDatabaseCache(&db, std::move(persistentCache));
+}
+
+
+TEST_F(ThumbnailManagerTest, thumbnailsOfRemovedPhotosAreDropped)
+{
+    const Photo::Id id(37);
+
+    auto persistentCache = std::make_unique<NiceMock<MockThumbnailsCache>>();
+    EXPECT_CALL(*persistentCache, remove(id)).Times(1);
+
+    NiceMock<MockThumbnailsCache> cache;
+    EXPECT_CALL(cache, remove(id)).Times(1);
+
+    MockThumbnailsGenerator generator;
+    ThumbnailManager tm(&executor, generator, cache, std::make_unique<EmptyLogger>());
+    tm.setDatabaseCache(&db, std::move(persistentCache));
+
+    emit backend.photosRemoved({id});
+}
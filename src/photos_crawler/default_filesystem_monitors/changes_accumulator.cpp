@@ -0,0 +1,111 @@
+#include "changes_accumulator.hpp"
+
+
+namespace
+{
+    bool isSameOrBelow(const QString& path, const QString& dir)
+    {
+        return path.startsWith(dir) && (path.size() == dir.size() || path[dir.size()] == '/');
+    }
+
+    // replace dir part of path with newDir
+    QString rebase(const QString& path, const QString& dir, const QString& newDir)
+    {
+        return newDir + path.mid(dir.size());
+    }
+}
+
+
+void ChangesAccumulator::added(const QString& path)
+{
+    m_removed.erase(path);
+    m_added.insert(path);
+}
+
+
+void ChangesAccumulator::removed(const QString& path, bool isDirectory)
+{
+    std::erase_if(m_added, [&path](const QString& added)
+    {
+        return isSameOrBelow(added, path);
+    });
+
+    // things moved to removed location are gone, report their original locations as removed
+    std::erase_if(m_moved, [this, &path](const FileSystemChanges::Move& move)
+    {
+        const bool gone = isSameOrBelow(move.to, path);
+
+        if (gone)
+            m_removed.insert_or_assign(move.from, move.isDirectory);
+
+        return gone;
+    });
+
+    m_removed.insert_or_assign(path, isDirectory);
+}
+
+
+void ChangesAccumulator::moved(const QString& from, const QString& to, bool isDirectory)
+{
+    if (from == to)
+        return;
+
+    const bool freshlyAdded = m_added.contains(from);
+
+    // files added and then moved are just added in new place
+    std::set<QString> added;
+    for (const QString& path: m_added)
+        added.insert(isSameOrBelow(path, from)? rebase(path, from, to): path);
+
+    m_added.swap(added);
+
+    // collapse chains of moves
+    bool continuation = false;
+
+    for (FileSystemChanges::Move& move: m_moved)
+        if (isSameOrBelow(move.to, from))
+        {
+            continuation |= move.to == from;
+            move.to = rebase(move.to, from, to);
+        }
+
+    std::erase_if(m_moved, [](const FileSystemChanges::Move& move)
+    {
+        return move.from == move.to;
+    });
+
+    if (freshlyAdded == false && continuation == false)
+        m_moved.push_back({from, to, isDirectory});
+}
+
+
+void ChangesAccumulator::overflow()
+{
+    m_overflow = true;
+}
+
+
+bool ChangesAccumulator::isEmpty() const
+{
+    return m_added.empty() && m_removed.empty() && m_moved.empty() && m_overflow == false;
+}
+
+
+FileSystemChanges ChangesAccumulator::take()
+{
+    FileSystemChanges changes;
+    changes.added = QStringList(m_added.begin(), m_added.end());
+
+    for (const auto& [path, isDirectory]: m_removed)
+        changes.removed.push_back({path, isDirectory});
+
+    changes.moved = std::move(m_moved);
+    changes.overflow = m_overflow;
+
+    m_added.clear();
+    m_removed.clear();
+    m_moved.clear();
+    m_overflow = false;
+
+    return changes;
+}
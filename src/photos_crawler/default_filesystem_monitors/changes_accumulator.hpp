@@ -0,0 +1,39 @@
+#ifndef CHANGES_ACCUMULATOR_HPP
+#define CHANGES_ACCUMULATOR_HPP
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../ifile_system_monitor.hpp"
+#include "photos_crawler_export.h"
+
+
+/**
+ * \brief Coalesces file system events into a compact set of changes
+ *
+ * Events cancelling each other are dropped (file created and then removed),
+ * chains of moves are collapsed into one and moves of freshly added files
+ * are turned into additions at final location.
+ */
+class PHOTOS_CRAWLER_EXPORT ChangesAccumulator
+{
+    public:
+        void added(const QString &);
+        void removed(const QString &, bool isDirectory);
+        void moved(const QString& from, const QString& to, bool isDirectory);
+        void overflow();
+
+        bool isEmpty() const;
+
+        /// take accumulated changes and reset state
+        FileSystemChanges take();
+
+    private:
+        std::set<QString> m_added;
+        std::map<QString, bool> m_removed;             // path -> is directory
+        std::vector<FileSystemChanges::Move> m_moved;
+        bool m_overflow = false;
+};
+
+#endif
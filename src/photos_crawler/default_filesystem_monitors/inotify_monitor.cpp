@@ -0,0 +1,377 @@
+#include "inotify_monitor.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <QDir>
+#include <QFile>
+#include <QDirIterator>
+
+#include <core/thread_utils.hpp>
+
+
+namespace
+{
+    constexpr quint32 WatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+    // report changes when nothing happened for a while, but do not keep them for too long
+    constexpr std::chrono::milliseconds QuietPeriod(500);
+    constexpr std::chrono::milliseconds MaxDelay(3000);
+    constexpr std::chrono::milliseconds MinInterval(1000);
+
+    // IN_MOVED_TO comes right after IN_MOVED_FROM. If it does not, item was moved out of monitored tree
+    constexpr int PairingTime = 50;
+
+    bool isSameOrBelow(const QString& path, const QString& dir)
+    {
+        return path.startsWith(dir) && (path.size() == dir.size() || path[dir.size()] == '/');
+    }
+}
+
+
+InotifyMonitor::InotifyMonitor(std::unique_ptr<ILogger> logger)
+    : m_logger(std::move(logger))
+    , m_stopping(false)
+    , m_notifier(nullptr)
+    , m_inotify(-1)
+    , m_wakeUp(-1)
+    , m_limitReported(false)
+{
+
+}
+
+
+InotifyMonitor::~InotifyMonitor()
+{
+    stop();
+}
+
+
+void InotifyMonitor::ignorePaths(const QStringList& to_ignore)
+{
+    m_ignored.clear();
+
+    for (const QString& path: to_ignore)
+        m_ignored.append(QDir::cleanPath(path));
+}
+
+
+bool InotifyMonitor::watch(const QString& path, IFileSystemChangesNotifier* notifier)
+{
+    stop();
+
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_wakeUp = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_inotify < 0 || m_wakeUp < 0)
+    {
+        m_logger->error(QString("Could not initialize inotify: %1").arg(strerror(errno)));
+        stop();
+
+        return false;
+    }
+
+    std::promise<void> watchesReady;
+    m_watchesReady = watchesReady.get_future().share();
+
+    m_notifier = notifier;
+    m_thread = std::thread(&InotifyMonitor::run, this, QDir::cleanPath(path), std::move(watchesReady));
+
+    return true;
+}
+
+
+void InotifyMonitor::stop()
+{
+    if (m_thread.joinable())
+    {
+        m_stopping = true;
+
+        const std::uint64_t wakeUp = 1;
+        [[maybe_unused]] const auto written = write(m_wakeUp, &wakeUp, sizeof(wakeUp));
+
+        m_thread.join();
+    }
+
+    if (m_inotify >= 0)
+        close(m_inotify);
+
+    if (m_wakeUp >= 0)
+        close(m_wakeUp);
+
+    m_inotify = -1;
+    m_wakeUp = -1;
+    m_watches.clear();
+    m_pendingMove.reset();
+    m_changes.take();
+    m_notifier = nullptr;
+    m_watchesReady = {};
+    m_stopping = false;
+}
+
+
+void InotifyMonitor::waitForWatches() const
+{
+    if (m_watchesReady.valid())
+        m_watchesReady.wait();
+}
+
+
+void InotifyMonitor::run(const QString& root, std::promise<void> watchesReady)
+{
+    set_thread_name("FSMonitor");
+
+    // Registration of big trees takes a while, so it is done here rather than in watch().
+    // Each directory is watched before it is listed, so changes done meanwhile are not missed.
+    watchTree(root, false);
+    watchesReady.set_value();
+
+    m_logger->debug(QString("Watching %1 directories").arg(m_watches.size()));
+
+    Clock::time_point firstEvent;
+    Clock::time_point lastEvent;
+    Clock::time_point lastFlush;
+
+    for(;;)
+    {
+        int timeout = -1;
+
+        if (m_changes.isEmpty() == false)
+        {
+            const auto deadline = std::max(lastFlush + MinInterval, std::min(lastEvent + QuietPeriod, firstEvent + MaxDelay));
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+
+            timeout = static_cast<int>(std::max<decltype(left)>(left, 0));
+        }
+
+        if (m_pendingMove)
+            timeout = timeout < 0? PairingTime: std::min(timeout, PairingTime);
+
+        pollfd fds[2] = { {m_inotify, POLLIN, 0}, {m_wakeUp, POLLIN, 0} };
+        const int ready = poll(fds, 2, timeout);
+
+        if (ready < 0 && errno != EINTR)
+        {
+            m_logger->error(QString("Error while waiting for file system events: %1").arg(strerror(errno)));
+            break;
+        }
+
+        if (fds[1].revents & POLLIN)
+            break;
+
+        const bool hadChanges = m_changes.isEmpty() == false;
+
+        if (ready > 0 && (fds[0].revents & POLLIN))
+        {
+            readEvents();
+            lastEvent = Clock::now();
+        }
+        else if (ready == 0 && m_pendingMove)
+            resolvePendingMove();
+
+        const auto now = Clock::now();
+
+        if (hadChanges == false && m_changes.isEmpty() == false)
+            firstEvent = now;
+
+        const bool flush = m_changes.isEmpty() == false &&
+                           m_pendingMove.has_value() == false &&
+                           now >= lastFlush + MinInterval &&
+                           (now >= lastEvent + QuietPeriod || now >= firstEvent + MaxDelay);
+
+        if (flush)
+        {
+            m_notifier->changed(m_changes.take());
+            lastFlush = now;
+        }
+    }
+}
+
+
+void InotifyMonitor::readEvents()
+{
+    alignas(inotify_event) char buffer[64 * 1024];
+
+    for(;;)
+    {
+        const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+
+        if (length <= 0)
+            break;
+
+        for (const char* ptr = buffer; ptr < buffer + length; )
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event *>(ptr);
+            const QString name = event->len > 0? QFile::decodeName(event->name): QString();
+
+            process(event->wd, event->mask, event->cookie, name);
+
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+}
+
+
+void InotifyMonitor::process(int wd, quint32 mask, quint32 cookie, const QString& name)
+{
+    if (mask & IN_Q_OVERFLOW)
+    {
+        m_logger->warning("Too many file system events, some were lost");
+        m_changes.overflow();
+        return;
+    }
+
+    if (mask & IN_IGNORED)
+    {
+        m_watches.erase(wd);
+        return;
+    }
+
+    const auto it = m_watches.find(wd);
+
+    // events without name are about watched directory itself, those are handled via its parent
+    if (it == m_watches.end() || name.isEmpty())
+        return;
+
+    const QString path = it->second + '/' + name;
+    const bool isDir = mask & IN_ISDIR;
+
+    if (m_pendingMove && ((mask & IN_MOVED_TO) == 0 || cookie != m_pendingMove->cookie))
+        resolvePendingMove();
+
+    if (mask & IN_MOVED_TO)
+    {
+        if (m_pendingMove)
+        {
+            const PendingMove from = *m_pendingMove;
+            m_pendingMove.reset();
+
+            if (isIgnored(path))
+            {
+                m_changes.removed(from.path, from.isDir);
+
+                if (from.isDir)
+                    unwatchTree(from.path);
+            }
+            else
+            {
+                m_changes.moved(from.path, path, from.isDir);
+
+                if (from.isDir)
+                    renameTree(from.path, path);
+            }
+        }
+        else if (isIgnored(path) == false)
+        {
+            // moved from outside of monitored tree
+            if (isDir)
+                watchTree(path, true);
+            else
+                m_changes.added(path);
+        }
+    }
+    else if (isIgnored(path))
+        return;
+    else if (mask & IN_MOVED_FROM)
+        m_pendingMove = PendingMove{cookie, path, isDir};
+    else if ((mask & IN_CREATE) && isDir)
+        watchTree(path, true);                  // files could have been created before watch was added
+    else if (mask & IN_CLOSE_WRITE)
+        m_changes.added(path);
+    else if (mask & IN_DELETE)
+        m_changes.removed(path, isDir);         // watches of removed directories are dropped with IN_IGNORED
+}
+
+
+void InotifyMonitor::resolvePendingMove()
+{
+    m_changes.removed(m_pendingMove->path, m_pendingMove->isDir);
+
+    if (m_pendingMove->isDir)
+        unwatchTree(m_pendingMove->path);
+
+    m_pendingMove.reset();
+}
+
+
+void InotifyMonitor::watchTree(const QString& path, bool reportFiles)
+{
+    std::vector<QString> directories = { path };
+
+    while (directories.empty() == false && m_stopping == false)
+    {
+        const QString directory = directories.back();
+        directories.pop_back();
+
+        if (isIgnored(directory))
+            continue;
+
+        // add watch before listing, so no file will be missed
+        const int wd = inotify_add_watch(m_inotify, QFile::encodeName(directory).constData(), WatchMask);
+
+        if (wd < 0)
+        {
+            if (errno == ENOSPC && m_limitReported == false)
+            {
+                m_logger->warning("Limit of inotify watches reached, some changes will not be noticed. "
+                                  "Consider increasing fs.inotify.max_user_watches");
+                m_limitReported = true;
+            }
+
+            continue;
+        }
+
+        // directory reachable by many paths (symlinks)
+        if (m_watches.emplace(wd, directory).second == false)
+            continue;
+
+        QDirIterator dirIt(directory, QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+
+        while (dirIt.hasNext())
+        {
+            const QString entry = dirIt.next();
+
+            if (dirIt.fileInfo().isDir())
+                directories.push_back(entry);
+            else if (reportFiles && isIgnored(entry) == false)
+                m_changes.added(entry);
+        }
+    }
+}
+
+
+void InotifyMonitor::unwatchTree(const QString& path)
+{
+    std::erase_if(m_watches, [this, &path](const auto& watch)
+    {
+        const bool below = isSameOrBelow(watch.second, path);
+
+        if (below)
+            inotify_rm_watch(m_inotify, watch.first);
+
+        return below;
+    });
+}
+
+
+void InotifyMonitor::renameTree(const QString& from, const QString& to)
+{
+    for (auto& [wd, directory]: m_watches)
+        if (isSameOrBelow(directory, from))
+            directory = to + directory.mid(from.size());
+}
+
+
+bool InotifyMonitor::isIgnored(const QString& path) const
+{
+    return std::any_of(m_ignored.begin(), m_ignored.end(), [&path](const QString& ignored)
+    {
+        return isSameOrBelow(path, ignored);
+    });
+}
@@ -0,0 +1,80 @@
+#ifndef INOTIFY_MONITOR_HPP
+#define INOTIFY_MONITOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <core/ilogger.hpp>
+
+#include "../ifile_system_monitor.hpp"
+#include "changes_accumulator.hpp"
+#include "photos_crawler_export.h"
+
+
+/**
+ * \brief Linux file system monitor based on inotify
+ *
+ * All directories of monitored tree are registered recursively by monitoring thread
+ * (so watch() returns immediately even for big collections),
+ * new directories are registered as they appear.
+ * Events are coalesced with ChangesAccumulator and reported when there were
+ * no new events for a while, but not more frequently than once per second.
+ * Pairs of IN_MOVED_FROM / IN_MOVED_TO events are reported as moves.
+ */
+class PHOTOS_CRAWLER_EXPORT InotifyMonitor: public IFileSystemMonitor
+{
+    public:
+        explicit InotifyMonitor(std::unique_ptr<ILogger>);
+        InotifyMonitor(const InotifyMonitor &) = delete;
+        ~InotifyMonitor();
+
+        InotifyMonitor& operator=(const InotifyMonitor &) = delete;
+
+        /// Skip given paths and everything below them
+        void ignorePaths(const QStringList &);
+
+        bool watch(const QString &, IFileSystemChangesNotifier *) override;
+        void stop() override;
+
+        /// Block until all directories of monitored tree are registered
+        void waitForWatches() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingMove
+        {
+            quint32 cookie;
+            QString path;
+            bool isDir;
+        };
+
+        std::map<int, QString> m_watches;
+        ChangesAccumulator m_changes;
+        std::optional<PendingMove> m_pendingMove;
+        QStringList m_ignored;
+        std::unique_ptr<ILogger> m_logger;
+        std::thread m_thread;
+        std::shared_future<void> m_watchesReady;
+        std::atomic<bool> m_stopping;
+        IFileSystemChangesNotifier* m_notifier;
+        int m_inotify;
+        int m_wakeUp;
+        bool m_limitReported;
+
+        void run(const QString& root, std::promise<void> watchesReady);
+        void readEvents();
+        void process(int wd, quint32 mask, quint32 cookie, const QString& name);
+        void resolvePendingMove();
+        void watchTree(const QString &, bool reportFiles);
+        void unwatchTree(const QString &);
+        void renameTree(const QString& from, const QString& to);
+        bool isIgnored(const QString &) const;
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include "directories_snapshot.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+
+namespace
+{
+    constexpr quint32 SnapshotMagic = 0x50424453;       // 'PBDS'
+    constexpr quint32 SnapshotVersion = 2;
+
+    // File systems with coarse timestamps (FAT has 2s resolution) may not change
+    // directory's modification time when it is modified shortly after it was listed.
+    // Do not trust fresh timestamps.
+    constexpr qint64 TimestampResolution = 2000;
+
+    QDataStream& operator<<(QDataStream& stream, const DirectoriesSnapshot::Entry& entry)
+    {
+        return stream << entry.state.modificationTime
+                      << entry.state.inode
+                      << entry.state.entries
+                      << entry.canonicalPath
+                      << entry.subdirectories;
+    }
+
+    QDataStream& operator>>(QDataStream& stream, DirectoriesSnapshot::Entry& entry)
+    {
+        return stream >> entry.state.modificationTime
+                      >> entry.state.inode
+                      >> entry.state.entries
+                      >> entry.canonicalPath
+                      >> entry.subdirectories;
+    }
+}
+
+
+DirectoriesSnapshot::DirectoriesSnapshot()
+{
+
+}
+
+
+DirectoriesSnapshot::State DirectoriesSnapshot::stateOf(const QString& path)
+{
+    State state;
+
+    const QFileInfo info(path);
+    const QDateTime modificationTime = info.lastModified();
+
+    if (modificationTime.isValid())
+        state.modificationTime = modificationTime.toMSecsSinceEpoch();
+
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) == 0)
+        state.inode = st.st_ino;
+#endif
+
+    state.entries = QDir(path, QString(), QDir::NoSort, EntriesFilter).count();
+
+    return state;
+}
+
+
+bool DirectoriesSnapshot::load(const QString& path)
+{
+    QFile file(path);
+
+    if (file.open(QFile::ReadOnly) == false)
+        return false;
+
+    QDataStream stream(&file);
+
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+
+    if (magic != SnapshotMagic || version != SnapshotVersion)
+        return false;
+
+    std::map<QString, Entry> entries;
+    quint64 count = 0;
+    stream >> count;
+
+    for (quint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        QString directory;
+        Entry entry;
+
+        stream >> directory >> entry;
+        entries.emplace_hint(entries.end(), directory, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+    m_entries = std::move(entries);
+    m_visited.clear();
+    m_changed.clear();
+
+    return true;
+}
+
+
+bool DirectoriesSnapshot::save(const QString& path) const
+{
+    QSaveFile file(path);
+
+    if (file.open(QFile::WriteOnly) == false)
+        return false;
+
+    QDataStream stream(&file);
+
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    stream << SnapshotMagic << SnapshotVersion << static_cast<quint64>(m_visited.size());
+
+    for (const QString& directory: m_visited)
+    {
+        const auto it = m_entries.find(directory);
+        stream << directory << (it == m_entries.end()? Entry(): it->second);
+    }
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+
+bool DirectoriesSnapshot::isEmpty() const
+{
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    return m_entries.empty();
+}
+
+
+std::optional<DirectoriesSnapshot::Entry> DirectoriesSnapshot::unchanged(const QString& path, const State& state)
+{
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    const auto it = m_entries.find(path);
+
+    if (it == m_entries.end() || it->second.state.modificationTime == 0 || it->second.state != state)
+        return std::nullopt;
+
+    m_visited.insert(path);
+
+    return it->second;
+}
+
+
+void DirectoriesSnapshot::update(const QString& path, const Entry& entry)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    Entry& stored = m_entries[path];
+
+    for (const QString& subdirectory: stored.subdirectories)
+        if (entry.subdirectories.contains(subdirectory) == false)
+            forget(subdirectory);
+
+    stored = entry;
+
+    if (now - stored.state.modificationTime < TimestampResolution)
+        stored.state.modificationTime = 0;
+
+    m_visited.insert(path);
+    m_changed.insert(path);
+}
+
+
+std::optional<QString> DirectoriesSnapshot::canonicalPath(const QString& path) const
+{
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    const auto it = m_entries.find(path);
+
+    return it == m_entries.end()? std::nullopt: std::optional<QString>(it->second.canonicalPath);
+}
+
+
+QStringList DirectoriesSnapshot::changedDirectories() const
+{
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    return QStringList(m_changed.begin(), m_changed.end());
+}
+
+
+void DirectoriesSnapshot::forget(const QString& path)
+{
+    const auto it = m_entries.find(path);
+
+    if (it != m_entries.end())
+    {
+        const QStringList subdirectories = it->second.subdirectories;
+        m_entries.erase(it);
+
+        for (const QString& subdirectory: subdirectories)
+            forget(subdirectory);
+    }
+
+    m_visited.erase(path);
+    m_changed.insert(path);
+}
@@ -0,0 +1,101 @@
+#ifndef DIRECTORIES_SNAPSHOT_HPP
+#define DIRECTORIES_SNAPSHOT_HPP
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+
+#include <QDir>
+#include <QStringList>
+
+#include "photos_crawler_export.h"
+
+
+/**
+ * \brief State of directories tree remembered between scans
+ *
+ * For each visited directory its modification time, inode, number of entries
+ * and list of subdirectories is kept.
+ * As adding, removing or renaming a file changes modification time of its directory,
+ * a directory with unchanged metadata does not need to be listed again -
+ * only its subdirectories need to be checked.
+ * Number of entries is compared too, so changes not reflected by modification time
+ * (coarse timestamps, restored times) are also noticed.
+ *
+ * All methods are thread safe so snapshot can be used by many scanning threads at once.
+ */
+class PHOTOS_CRAWLER_EXPORT DirectoriesSnapshot
+{
+    public:
+        /// filter used for counting and listing directory entries
+        static constexpr QDir::Filters EntriesFilter = QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs;
+
+        struct State
+        {
+            qint64 modificationTime = 0;        ///< in ms since epoch, 0 means unknown
+            quint64 inode = 0;                  ///< 0 on platforms without inodes
+            qint64 entries = 0;                 ///< number of entries matching EntriesFilter
+
+            bool operator==(const State &) const = default;
+        };
+
+        struct Entry
+        {
+            State state;
+            QString canonicalPath;
+            QStringList subdirectories;         ///< full paths of subdirectories
+        };
+
+        DirectoriesSnapshot();
+        DirectoriesSnapshot(const DirectoriesSnapshot &) = delete;
+
+        DirectoriesSnapshot& operator=(const DirectoriesSnapshot &) = delete;
+
+        /// read state of directory from file system
+        static State stateOf(const QString& path);
+
+        bool load(const QString& path);
+
+        /**
+         * \brief store snapshot in file
+         *
+         * Only directories visited since snapshot was loaded are stored,
+         * so directories which are no longer reachable are dropped.
+         */
+        bool save(const QString& path) const;
+
+        bool isEmpty() const;
+
+        /**
+         * \brief get remembered entry for directory if its state did not change
+         * \param path directory path
+         * \param state current state of directory
+         * \return remembered entry or std::nullopt if directory is unknown or was modified
+         */
+        std::optional<Entry> unchanged(const QString& path, const State& state);
+
+        /**
+         * \brief remember fresh state of directory
+         *
+         * Directory is marked as changed.
+         * Subdirectories which disappeared since previous scan are forgotten and also marked as changed.
+         */
+        void update(const QString& path, const Entry &);
+
+        /// get remembered canonical path of directory
+        std::optional<QString> canonicalPath(const QString& path) const;
+
+        /// list of directories updated or removed since snapshot was loaded
+        QStringList changedDirectories() const;
+
+    private:
+        std::map<QString, Entry> m_entries;
+        std::set<QString> m_visited;
+        std::set<QString> m_changed;
+        mutable std::mutex m_entriesMutex;
+
+        void forget(const QString& path);
+};
+
+#endif
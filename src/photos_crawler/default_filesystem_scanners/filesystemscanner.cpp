@@ -18,38 +18,67 @@
  */
 
 
+
 #include "filesystemscanner.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include <QDir>
 #include <QDirIterator>
 
+#include <core/thread_utils.hpp>
+
+
+namespace
+{
+    constexpr qsizetype BatchSize = 256;
+}
+
 
 void FileSystemScanner::ignorePaths(const QStringList& to_ignore)
 {
-    m_ignored = to_ignore;
+    m_ignored.clear();
+
+    for (const QString& path: to_ignore)
+        m_ignored.append(QDir::cleanPath(path));
+}
+
+
+void FileSystemScanner::setSnapshot(DirectoriesSnapshot* snapshot)
+{
+    m_snapshot = snapshot;
 }
 
 
 void FileSystemScanner::getFilesFor(const QString& dir_path, IFileNotifier* notifier)
 {
     m_work = true;
+    m_notifier = notifier;
+    m_busyWorkers = 0;
 
-    QDirIterator dirIt(dir_path,
-                       QStringList(),
-                       QDir::NoDotAndDotDot | QDir::Files,
-                       QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    const QString root = QDir::cleanPath(dir_path);
+    const Directory rootDirectory{root, QFileInfo(root).canonicalFilePath()};
 
-    while (m_work && dirIt.hasNext())
-    {
-        const QString entry = dirIt.next();
-        const bool is_fine = std::none_of(m_ignored.begin(), m_ignored.end(), [&entry](const QString& ignored)
-        {
-            return entry.contains(ignored);
-        });
+    m_rootCanonicalPath = rootDirectory.canonicalPath;
+    m_directories.push_back(rootDirectory);
+    m_visited.insert(rootDirectory.canonicalPath);
 
-        if (is_fine)
-            notifier->found(entry);
-    }
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < m_threads; i++)
+        workers.emplace_back(&FileSystemScanner::walk, this);
+
+    for (std::thread& worker: workers)
+        worker.join();
+
+    if (m_pending.isEmpty() == false)
+        notifier->found(m_pending);
+
+    m_pending.clear();
+    m_directories.clear();
+    m_visited.clear();
+    m_rootCanonicalPath.clear();
+    m_notifier = nullptr;
 
     notifier->finished();
 }
@@ -58,10 +87,25 @@ void FileSystemScanner::getFilesFor(const QString& dir_path, IFileNotifier* noti
 void FileSystemScanner::stop()
 {
     m_work = false;
+
+    std::lock_guard<std::mutex> lock(m_directoriesMutex);
+    m_directoriesCondition.notify_all();
 }
 
 
-FileSystemScanner::FileSystemScanner(): m_work(true)
+unsigned FileSystemScanner::defaultThreads()
+{
+    // listing directories is mostly waiting for disk (or network), so use more threads than usual
+    return std::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+}
+
+
+FileSystemScanner::FileSystemScanner(unsigned threads)
+    : m_notifier(nullptr)
+    , m_snapshot(nullptr)
+    , m_threads(std::max(threads, 1u))
+    , m_busyWorkers(0)
+    , m_work(true)
 {
 
 }
@@ -71,3 +115,165 @@ FileSystemScanner::~FileSystemScanner()
 {
 
 }
+
+
+void FileSystemScanner::walk()
+{
+    set_thread_name("FSScanner");
+
+    std::unique_lock<std::mutex> lock(m_directoriesMutex);
+
+    for(;;)
+    {
+        // wait for work. Quit when there is none and no one is going to produce any
+        m_directoriesCondition.wait(lock, [this]
+        {
+            return m_work == false || m_directories.empty() == false || m_busyWorkers == 0;
+        });
+
+        if (m_work == false || m_directories.empty())
+            break;
+
+        const Directory directory = std::move(m_directories.front());
+        m_directories.pop_front();
+        m_busyWorkers++;
+
+        lock.unlock();
+        const std::vector<Directory> subdirectories = scan(directory);
+        lock.lock();
+
+        for (const Directory& subdirectory: subdirectories)
+            if (m_visited.insert(subdirectory.canonicalPath).second)
+                m_directories.push_back(subdirectory);
+
+        m_busyWorkers--;
+        m_directoriesCondition.notify_all();
+    }
+}
+
+
+std::vector<FileSystemScanner::Directory> FileSystemScanner::scan(const Directory& directory)
+{
+    if (m_snapshot == nullptr)
+        return list(directory, {});
+
+    // read state before listing, so modifications done during listing will be noticed by next scan
+    const DirectoriesSnapshot::State state = DirectoriesSnapshot::stateOf(directory.path);
+    const auto entry = m_snapshot->unchanged(directory.path, state);
+
+    if (entry.has_value() == false)
+        return list(directory, state);
+
+    // directory did not change, only its subdirectories need to be checked
+    std::vector<Directory> subdirectories;
+
+    for (const QString& subdirectory: entry->subdirectories)
+    {
+        if (isIgnored(subdirectory))
+            continue;
+
+        const auto canonicalPath = m_snapshot->canonicalPath(subdirectory);
+        const Directory subdir{subdirectory, canonicalPath? *canonicalPath: QFileInfo(subdirectory).canonicalFilePath()};
+
+        if (subdir.canonicalPath.isEmpty() == false)
+            subdirectories.push_back(subdir);
+    }
+
+    return subdirectories;
+}
+
+
+std::vector<FileSystemScanner::Directory> FileSystemScanner::list(const Directory& directory, const DirectoriesSnapshot::State& state)
+{
+    std::vector<Directory> subdirectories;
+    QStringList files;
+
+    QDirIterator dirIt(directory.path, DirectoriesSnapshot::EntriesFilter);
+
+    while (m_work && dirIt.hasNext())
+    {
+        const QString entry = dirIt.next();
+
+        if (isIgnored(entry))
+            continue;
+
+        const QFileInfo info = dirIt.fileInfo();
+
+        if (info.isDir())
+        {
+            // canonical path of regular subdirectory can be built without asking file system
+            const QString canonicalPath = info.isSymLink()?
+                info.canonicalFilePath():
+                QDir(directory.canonicalPath).filePath(info.fileName());
+
+            // Directory reachable directly will be visited (and reported) under its real path.
+            // Do not let the symlink win the race for it.
+            if (info.isSymLink() && isReachableDirectly(canonicalPath))
+                continue;
+
+            if (canonicalPath.isEmpty() == false)
+                subdirectories.push_back({entry, canonicalPath});
+        }
+        else
+            files.append(entry);
+    }
+
+    if (files.isEmpty() == false)
+        found(files);
+
+    // remember only complete listings
+    if (m_snapshot != nullptr && m_work)
+    {
+        DirectoriesSnapshot::Entry snapshotEntry;
+        snapshotEntry.state = state;
+        snapshotEntry.canonicalPath = directory.canonicalPath;
+
+        for (const Directory& subdirectory: subdirectories)
+            snapshotEntry.subdirectories.append(subdirectory.path);
+
+        m_snapshot->update(directory.path, snapshotEntry);
+    }
+
+    return subdirectories;
+}
+
+
+void FileSystemScanner::found(const QStringList& files)
+{
+    std::lock_guard<std::mutex> lock(m_notifierMutex);
+
+    m_pending.append(files);
+
+    if (m_pending.size() >= BatchSize)
+    {
+        m_notifier->found(m_pending);
+        m_pending.clear();
+    }
+}
+
+
+bool FileSystemScanner::isReachableDirectly(const QString& canonicalPath) const
+{
+    const QString rootPrefix = m_rootCanonicalPath.endsWith('/')? m_rootCanonicalPath: m_rootCanonicalPath + '/';
+
+    if (canonicalPath.startsWith(rootPrefix) == false)
+        return false;
+
+    // hidden directories are not listed, so anything below them is reachable only via symlinks
+    const QStringList components = canonicalPath.mid(rootPrefix.size()).split('/', Qt::SkipEmptyParts);
+
+    return std::none_of(components.begin(), components.end(), [](const QString& component)
+    {
+        return component.startsWith('.');
+    });
+}
+
+
+bool FileSystemScanner::isIgnored(const QString& path) const
+{
+    return std::any_of(m_ignored.begin(), m_ignored.end(), [&path](const QString& ignored)
+    {
+        return path.startsWith(ignored) &&
+               (path.size() == ignored.size() || path[ignored.size()] == '/' || ignored.endsWith('/'));
+    });
+}
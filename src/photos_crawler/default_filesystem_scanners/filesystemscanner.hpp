@@ -24,26 +24,76 @@
 #include "../ifile_system_scanner.hpp"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include <QStringList>
 
+#include "directories_snapshot.hpp"
 #include "photos_crawler_export.h"
 
 
+/**
+ * \brief Multithreaded file system walker
+ *
+ * Each directory is a separate work item, so directories are listed
+ * in parallel by a bounded number of threads.
+ * Symbolic links are followed, but each directory is visited only once
+ * (identified by its canonical path) which protects against link loops.
+ * Symlinks to directories inside scanned tree are skipped, so such directories
+ * are always reported under their real path.
+ * Found files are passed to IFileNotifier in batches, from one thread at a time.
+ *
+ * When DirectoriesSnapshot is provided, directories which did not change since
+ * snapshot was taken are not listed and their files are not reported.
+ */
 class PHOTOS_CRAWLER_EXPORT FileSystemScanner: public IFileSystemScanner
 {
     public:
-        FileSystemScanner();
+        explicit FileSystemScanner(unsigned threads = defaultThreads());
         virtual ~FileSystemScanner();
 
+        /// Skip given paths and everything below them
         void ignorePaths(const QStringList &);
 
+        /// Use and update snapshot of previous scan. Snapshot needs to outlive scanning.
+        void setSnapshot(DirectoriesSnapshot *);
+
         void getFilesFor(const QString &, IFileNotifier *) override;
         void stop() override;
 
+        static unsigned defaultThreads();
+
     private:
+        struct Directory
+        {
+            QString path;
+            QString canonicalPath;
+        };
+
+        std::deque<Directory> m_directories;
+        std::set<QString> m_visited;
+        std::mutex m_directoriesMutex;
+        std::condition_variable m_directoriesCondition;
+        QStringList m_pending;
+        std::mutex m_notifierMutex;
+        IFileNotifier* m_notifier;
+        DirectoriesSnapshot* m_snapshot;
+        const unsigned m_threads;
+        int m_busyWorkers;
         std::atomic<bool> m_work;
         QStringList m_ignored;
+        QString m_rootCanonicalPath;
+
+        void walk();
+        std::vector<Directory> scan(const Directory &);
+        std::vector<Directory> list(const Directory &, const DirectoriesSnapshot::State &);
+        void found(const QStringList &);
+        bool isReachableDirectly(const QString &) const;
+        bool isIgnored(const QString &) const;
 
         FileSystemScanner(const FileSystemScanner& other) = delete;
         virtual FileSystemScanner& operator=(const FileSystemScanner& other) = delete;
@@ -0,0 +1,48 @@
+#ifndef IFILE_SYSTEM_MONITOR_HPP
+#define IFILE_SYSTEM_MONITOR_HPP
+
+#include <vector>
+
+#include <QStringList>
+
+#include "photos_crawler_export.h"
+
+struct FileSystemChanges
+{
+    struct Move
+    {
+        QString from;
+        QString to;
+        bool isDirectory = false;
+    };
+
+    struct Removal
+    {
+        QString path;
+        bool isDirectory = false;   // it is too late to check it on disk when change is reported
+    };
+
+    QStringList added;              // new or modified files
+    std::vector<Removal> removed;   // removed files or directories
+    std::vector<Move> moved;        // files or directories moved within monitored tree
+    bool overflow = false;          // some changes were lost, full rescan is required
+};
+
+
+struct PHOTOS_CRAWLER_EXPORT IFileSystemChangesNotifier
+{
+    virtual ~IFileSystemChangesNotifier();
+
+    virtual void changed(const FileSystemChanges &) = 0;   // batch of coalesced changes
+};
+
+
+struct PHOTOS_CRAWLER_EXPORT IFileSystemMonitor
+{
+    virtual ~IFileSystemMonitor();
+
+    virtual bool watch(const QString &, IFileSystemChangesNotifier *) = 0;   // start monitoring in background
+    virtual void stop() = 0;
+};
+
+#endif
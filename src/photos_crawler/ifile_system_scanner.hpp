@@ -4,15 +4,15 @@
 
 #include <vector>
 
-#include "photos_crawler_export.h"
+#include <QStringList>
 
-class QString;
+#include "photos_crawler_export.h"
 
 struct PHOTOS_CRAWLER_EXPORT IFileNotifier
 {
     virtual ~IFileNotifier();
 
-    virtual void found(const QString &) = 0;
+    virtual void found(const QStringList &) = 0;       // batch of found files
     virtual void finished() = 0;
 };
 
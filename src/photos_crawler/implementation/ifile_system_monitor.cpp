@@ -0,0 +1,14 @@
+
+#include "ifile_system_monitor.hpp"
+
+
+IFileSystemChangesNotifier::~IFileSystemChangesNotifier()
+{
+
+}
+
+
+IFileSystemMonitor::~IFileSystemMonitor()
+{
+
+}
@@ -19,10 +19,16 @@ namespace
 
         FileNotifier& operator=(const FileNotifier &) = delete;
 
-        virtual void found(const QString& file) override
+        virtual void found(const QStringList& files) override
         {
-            if (m_analyzer->isMediaFile(file))
-                m_notifications->found(file);
+            QStringList mediaFiles;
+
+            for (const QString& file: files)
+                if (m_analyzer->isMediaFile(file))
+                    mediaFiles.append(file);
+
+            if (mediaFiles.isEmpty() == false)
+                m_notifications->found(mediaFiles);
         }
 
         virtual void finished() override
@@ -4,16 +4,16 @@
 
 #include <vector>
 
-#include "photos_crawler_export.h"
+#include <QStringList>
 
-class QString;
+#include "photos_crawler_export.h"
 
 
 struct PHOTOS_CRAWLER_EXPORT IMediaNotification
 {
     virtual ~IMediaNotification() = default;
 
-    virtual void found(const QString &) = 0;
+    virtual void found(const QStringList &) = 0;       // batch of found media files
     virtual void finished() = 0;
 };
 
@@ -21,7 +21,7 @@ struct PHOTOS_CRAWLER_EXPORT IPhotoCrawler
 {
     virtual ~IPhotoCrawler() = default;
 
-    virtual void crawl(const QString &, IMediaNotification *) = 0;   // find media files for given path. Notify about each result
+    virtual void crawl(const QString &, IMediaNotification *) = 0;   // find media files for given path. Notify about results in batches
     virtual void stop() = 0;                                         // stop crawling
 };
 
@@ -3,15 +3,33 @@ include(${CMAKE_SOURCE_DIR}/cmake/functions.cmake)
 
 find_package(GTest REQUIRED CONFIG)
 
+set(MONITOR_TEST_SOURCES)
+
+if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    set(MONITOR_TEST_SOURCES
+        default_filesystem_monitors/inotify_monitor.cpp
+        unit_tests/inotify_monitor_tests.cpp
+    )
+endif()
+
 addTestTarget(photos_crawler
                 SOURCES
                     default_analyzers/file_analyzer.cpp
+                    default_filesystem_monitors/changes_accumulator.cpp
+                    default_filesystem_scanners/directories_snapshot.cpp
+                    default_filesystem_scanners/filesystemscanner.cpp
+                    implementation/ifile_system_monitor.cpp
                     implementation/ifile_system_scanner.cpp
                     implementation/photo_crawler.cpp
 
                     unit_tests/analyzerTests.cpp
+                    unit_tests/changes_accumulator_tests.cpp
+                    unit_tests/directories_snapshot_tests.cpp
+                    unit_tests/filesystem_scanner_tests.cpp
                     unit_tests/photo_crawler_tests.cpp
 
+                    ${MONITOR_TEST_SOURCES}
+
                 LIBRARIES
                     core
                     Qt::Core
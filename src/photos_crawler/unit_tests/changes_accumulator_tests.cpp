@@ -0,0 +1,75 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "default_filesystem_monitors/changes_accumulator.hpp"
+#include "unit_tests_utils/file_system_helpers.hpp"
+
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+
+TEST(ChangesAccumulatorTest, fileCreatedAndRemovedIsReportedAsRemoved)
+{
+    // file could exist before and be modified, so removal is kept
+    ChangesAccumulator accumulator;
+    accumulator.added("/a.jpg");
+    accumulator.removed("/a.jpg", false);
+
+    const FileSystemChanges changes = accumulator.take();
+    EXPECT_THAT(changes.added, IsEmpty());
+    EXPECT_THAT(changes.removed, ElementsAre(IsRemoval("/a.jpg", false)));
+    EXPECT_THAT(changes.moved, IsEmpty());
+}
+
+
+TEST(ChangesAccumulatorTest, fileAddedAndMovedIsAddedAtFinalLocation)
+{
+    ChangesAccumulator accumulator;
+    accumulator.added("/a.jpg");
+    accumulator.moved("/a.jpg", "/b.jpg", false);
+    accumulator.added("/dir/c.jpg");
+    accumulator.moved("/dir", "/dir2", true);
+
+    const FileSystemChanges changes = accumulator.take();
+    EXPECT_THAT(changes.added, ElementsAre("/b.jpg", "/dir2/c.jpg"));
+    EXPECT_THAT(changes.moved, ElementsAre(IsMove("/dir", "/dir2")));
+}
+
+
+TEST(ChangesAccumulatorTest, chainOfMovesIsCollapsed)
+{
+    ChangesAccumulator accumulator;
+    accumulator.moved("/a.jpg", "/b.jpg", false);
+    accumulator.moved("/b.jpg", "/c.jpg", false);
+    accumulator.moved("/x.jpg", "/y.jpg", false);
+    accumulator.moved("/y.jpg", "/x.jpg", false);
+
+    const FileSystemChanges changes = accumulator.take();
+    EXPECT_THAT(changes.moved, ElementsAre(IsMove("/a.jpg", "/c.jpg")));
+}
+
+
+TEST(ChangesAccumulatorTest, movedAndRemovedIsReportedAsRemoved)
+{
+    ChangesAccumulator accumulator;
+    accumulator.moved("/a.jpg", "/dir/b.jpg", false);
+    accumulator.moved("/photos.jpg", "/dir/photos", true);
+    accumulator.removed("/dir", true);
+
+    const FileSystemChanges changes = accumulator.take();
+    EXPECT_THAT(changes.removed, ElementsAre(IsRemoval("/a.jpg", false), IsRemoval("/dir", true), IsRemoval("/photos.jpg", true)));
+    EXPECT_THAT(changes.moved, IsEmpty());
+}
+
+
+TEST(ChangesAccumulatorTest, isEmptyAfterTake)
+{
+    ChangesAccumulator accumulator;
+    accumulator.added("/a.jpg");
+    accumulator.overflow();
+
+    EXPECT_FALSE(accumulator.isEmpty());
+    EXPECT_TRUE(accumulator.take().overflow);
+    EXPECT_TRUE(accumulator.isEmpty());
+}
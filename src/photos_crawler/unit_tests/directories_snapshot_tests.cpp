@@ -0,0 +1,148 @@
+#include <filesystem>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "default_filesystem_scanners/directories_snapshot.hpp"
+#include "default_filesystem_scanners/filesystemscanner.hpp"
+#include "unit_tests_utils/file_system_helpers.hpp"
+
+
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+namespace
+{
+    // fresh timestamps are not trusted by snapshot, make them look old
+    void makeOld(const QString& path)
+    {
+        const auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+
+        QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            std::filesystem::last_write_time(it.next().toStdString(), past);
+
+        std::filesystem::last_write_time(path.toStdString(), past);
+    }
+
+    QStringList scan(const QString& path, DirectoriesSnapshot& snapshot)
+    {
+        FilesCollector collector;
+        FileSystemScanner scanner;
+        scanner.setSnapshot(&snapshot);
+        scanner.getFilesFor(path, &collector);
+
+        return collector.collected;
+    }
+
+    struct DirectoriesSnapshotTest: testing::Test
+    {
+        DirectoriesSnapshotTest()
+        {
+            touch(dir.filePath("a.jpg"));
+            touch(dir.filePath("1/b.jpg"));
+            touch(dir.filePath("1/2/c.jpg"));
+            touch(dir.filePath("1/2/3/d.jpg"));
+            makeOld(dir.path());
+
+            DirectoriesSnapshot snapshot;
+            scan(dir.path(), snapshot);
+            snapshot.save(snapshotPath());
+        }
+
+        QString snapshotPath() const
+        {
+            return storage.filePath("snapshot");
+        }
+
+        QTemporaryDir dir;
+        QTemporaryDir storage;
+    };
+}
+
+
+TEST(DirectoriesSnapshotInitialTest, allDirectoriesAreListedForEmptySnapshot)
+{
+    QTemporaryDir dir;
+    touch(dir.filePath("a.jpg"));
+    touch(dir.filePath("1/b.jpg"));
+
+    DirectoriesSnapshot snapshot;
+    const QStringList files = scan(dir.path(), snapshot);
+
+    EXPECT_THAT(files, UnorderedElementsAre(dir.filePath("a.jpg"), dir.filePath("1/b.jpg")));
+    EXPECT_THAT(snapshot.changedDirectories(), UnorderedElementsAre(dir.path(), dir.filePath("1")));
+}
+
+
+TEST_F(DirectoriesSnapshotTest, unchangedDirectoriesAreNotListed)
+{
+    DirectoriesSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshotPath()));
+
+    EXPECT_THAT(scan(dir.path(), snapshot), IsEmpty());
+    EXPECT_THAT(snapshot.changedDirectories(), IsEmpty());
+}
+
+
+TEST_F(DirectoriesSnapshotTest, modifiedDirectoryIsListedAgain)
+{
+    touch(dir.filePath("1/2/e.jpg"));
+
+    DirectoriesSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshotPath()));
+
+    EXPECT_THAT(scan(dir.path(), snapshot), UnorderedElementsAre(dir.filePath("1/2/c.jpg"), dir.filePath("1/2/e.jpg")));
+    EXPECT_THAT(snapshot.changedDirectories(), UnorderedElementsAre(dir.filePath("1/2")));
+}
+
+
+TEST_F(DirectoriesSnapshotTest, directoryWithDifferentNumberOfEntriesIsListedAgain)
+{
+    // simulate file system which did not update modification time
+    const std::string path = dir.filePath("1/2").toStdString();
+    const auto modificationTime = std::filesystem::last_write_time(path);
+    touch(dir.filePath("1/2/e.jpg"));
+    std::filesystem::last_write_time(path, modificationTime);
+
+    DirectoriesSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshotPath()));
+
+    EXPECT_THAT(scan(dir.path(), snapshot), UnorderedElementsAre(dir.filePath("1/2/c.jpg"), dir.filePath("1/2/e.jpg")));
+    EXPECT_THAT(snapshot.changedDirectories(), UnorderedElementsAre(dir.filePath("1/2")));
+}
+
+
+TEST_F(DirectoriesSnapshotTest, removedDirectoriesAreMarkedAsChanged)
+{
+    QDir(dir.filePath("1/2")).removeRecursively();
+
+    DirectoriesSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshotPath()));
+
+    EXPECT_THAT(scan(dir.path(), snapshot), UnorderedElementsAre(dir.filePath("1/b.jpg")));
+    EXPECT_THAT(snapshot.changedDirectories(), UnorderedElementsAre(dir.filePath("1"), dir.filePath("1/2"), dir.filePath("1/2/3")));
+}
+
+
+TEST_F(DirectoriesSnapshotTest, savesOnlyReachableDirectories)
+{
+    QDir(dir.filePath("1")).removeRecursively();
+
+    DirectoriesSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshotPath()));
+    scan(dir.path(), snapshot);
+    ASSERT_TRUE(snapshot.save(snapshotPath()));
+
+    DirectoriesSnapshot reloaded;
+    ASSERT_TRUE(reloaded.load(snapshotPath()));
+
+    EXPECT_FALSE(reloaded.canonicalPath(dir.filePath("1")).has_value());
+    EXPECT_FALSE(reloaded.canonicalPath(dir.filePath("1/2")).has_value());
+    EXPECT_TRUE(reloaded.canonicalPath(dir.path()).has_value());
+}
@@ -0,0 +1,116 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "default_filesystem_scanners/filesystemscanner.hpp"
+#include "unit_tests_utils/file_system_helpers.hpp"
+
+
+using testing::UnorderedElementsAreArray;
+
+TEST(FileSystemScannerTest, findsFilesInAllSubdirectories)
+{
+    QTemporaryDir dir;
+    const QStringList files =
+    {
+        dir.filePath("a.jpg"),
+        dir.filePath("1/b.jpg"),
+        dir.filePath("1/2/c.jpg"),
+        dir.filePath("1/2/3/d.txt"),
+        dir.filePath("4/e.png"),
+    };
+
+    for (const QString& file: files)
+        touch(file);
+
+    FilesCollector collector;
+    FileSystemScanner scanner(3);
+    scanner.getFilesFor(dir.path(), &collector);
+
+    EXPECT_TRUE(collector.done);
+    EXPECT_THAT(collector.collected, UnorderedElementsAreArray(files));
+}
+
+
+TEST(FileSystemScannerTest, skipsIgnoredPathsAndTheirContent)
+{
+    QTemporaryDir dir;
+    touch(dir.filePath("ignored/a.jpg"));
+    touch(dir.filePath("ignored/1/b.jpg"));
+    touch(dir.filePath("ignored_not/c.jpg"));
+    touch(dir.filePath("d.jpg"));
+
+    FilesCollector collector;
+    FileSystemScanner scanner;
+    scanner.ignorePaths({dir.filePath("ignored")});
+    scanner.getFilesFor(dir.path(), &collector);
+
+    EXPECT_THAT(collector.collected, UnorderedElementsAreArray({dir.filePath("ignored_not/c.jpg"), dir.filePath("d.jpg")}));
+}
+
+
+TEST(FileSystemScannerTest, reportsFilesInBatches)
+{
+    QTemporaryDir dir;
+    QStringList files;
+
+    for (int i = 0; i < 600; i++)
+    {
+        const QString file = dir.filePath(QString("%1/%2.jpg").arg(i % 20).arg(i));
+        touch(file);
+        files.append(file);
+    }
+
+    FilesCollector collector;
+    FileSystemScanner scanner;
+    scanner.getFilesFor(dir.path(), &collector);
+
+    EXPECT_THAT(collector.collected, UnorderedElementsAreArray(files));
+    EXPECT_LE(collector.batches, 3);
+}
+
+
+#ifndef Q_OS_WIN
+
+TEST(FileSystemScannerTest, visitsEachDirectoryOnceWhenSymlinksMakeLoop)
+{
+    QTemporaryDir dir;
+    touch(dir.filePath("1/a.jpg"));
+    touch(dir.filePath("1/2/b.jpg"));
+
+    QFile::link(dir.filePath("1"), dir.filePath("1/2/loop"));
+
+    FilesCollector collector;
+    FileSystemScanner scanner;
+    scanner.getFilesFor(dir.path(), &collector);
+
+    EXPECT_TRUE(collector.done);
+    EXPECT_THAT(collector.collected, UnorderedElementsAreArray({dir.filePath("1/a.jpg"), dir.filePath("1/2/b.jpg")}));
+}
+
+
+TEST(FileSystemScannerTest, reportsFilesUnderRealPathWhenDirectoryIsAlsoReachableViaSymlink)
+{
+    QTemporaryDir dir;
+    touch(dir.filePath("real/a.jpg"));
+    touch(dir.filePath("real/1/b.jpg"));
+
+    // symlinks placed so they may be reached before the real directories
+    QDir().mkpath(dir.filePath("0"));
+    QFile::link(dir.filePath("real"), dir.filePath("0/link"));
+    QFile::link(dir.filePath("real/1"), dir.filePath("link1"));
+
+    for (int i = 0; i < 10; i++)
+    {
+        FilesCollector collector;
+        FileSystemScanner scanner(4);
+        scanner.getFilesFor(dir.path(), &collector);
+
+        EXPECT_THAT(collector.collected, UnorderedElementsAreArray({dir.filePath("real/a.jpg"), dir.filePath("real/1/b.jpg")}));
+    }
+}
+
+#endif
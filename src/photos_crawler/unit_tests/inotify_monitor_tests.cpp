@@ -0,0 +1,142 @@
+#include <condition_variable>
+#include <mutex>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "default_filesystem_monitors/inotify_monitor.hpp"
+#include "unit_tests_utils/empty_logger.hpp"
+#include "unit_tests_utils/file_system_helpers.hpp"
+
+
+using testing::Contains;
+using testing::IsEmpty;
+
+namespace
+{
+    struct ChangesCollector: IFileSystemChangesNotifier
+    {
+        void changed(const FileSystemChanges& c) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            changes.push_back(c);
+            condition.notify_all();
+        }
+
+        FileSystemChanges wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, std::chrono::seconds(10), [this]{ return changes.empty() == false; });
+
+            FileSystemChanges result;
+
+            if (changes.empty() == false)
+            {
+                result = changes.front();
+                changes.erase(changes.begin());
+            }
+
+            return result;
+        }
+
+        std::vector<FileSystemChanges> changes;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+}
+
+
+TEST(InotifyMonitorTest, reportsNewFilesInNewSubdirectories)
+{
+    QTemporaryDir dir;
+    ChangesCollector collector;
+
+    InotifyMonitor monitor(std::make_unique<EmptyLogger>());
+    ASSERT_TRUE(monitor.watch(dir.path(), &collector));
+    monitor.waitForWatches();
+
+    QDir().mkpath(dir.filePath("1/2"));
+    touch(dir.filePath("1/2/a.jpg"));
+
+    const FileSystemChanges changes = collector.wait();
+    EXPECT_THAT(changes.added, Contains(dir.filePath("1/2/a.jpg")));
+}
+
+
+TEST(InotifyMonitorTest, reportsMovesAndRemovals)
+{
+    QTemporaryDir dir;
+    QTemporaryDir outside;
+    touch(dir.filePath("a.jpg"));
+    touch(dir.filePath("b.jpg"));
+
+    ChangesCollector collector;
+    InotifyMonitor monitor(std::make_unique<EmptyLogger>());
+    ASSERT_TRUE(monitor.watch(dir.path(), &collector));
+    monitor.waitForWatches();
+
+    QFile::rename(dir.filePath("a.jpg"), dir.filePath("c.jpg"));
+    QFile::rename(dir.filePath("b.jpg"), outside.filePath("b.jpg"));
+
+    const FileSystemChanges changes = collector.wait();
+    EXPECT_THAT(changes.moved, Contains(IsMove(dir.filePath("a.jpg"), dir.filePath("c.jpg"))));
+    EXPECT_THAT(changes.removed, Contains(IsRemoval(dir.filePath("b.jpg"), false)));
+    EXPECT_THAT(changes.added, IsEmpty());
+}
+
+
+TEST(InotifyMonitorTest, ignoresIgnoredPaths)
+{
+    QTemporaryDir dir;
+    QDir().mkpath(dir.filePath("internal"));
+
+    ChangesCollector collector;
+    InotifyMonitor monitor(std::make_unique<EmptyLogger>());
+    monitor.ignorePaths({dir.filePath("internal")});
+    ASSERT_TRUE(monitor.watch(dir.path(), &collector));
+    monitor.waitForWatches();
+
+    touch(dir.filePath("internal/a.jpg"));
+    touch(dir.filePath("b.jpg"));
+
+    const FileSystemChanges changes = collector.wait();
+    EXPECT_THAT(changes.added, testing::ElementsAre(dir.filePath("b.jpg")));
+}
+
+
+TEST(InotifyMonitorTest, watchesExistingSubdirectories)
+{
+    QTemporaryDir dir;
+    QDir().mkpath(dir.filePath("1/2/3"));
+
+    ChangesCollector collector;
+    InotifyMonitor monitor(std::make_unique<EmptyLogger>());
+    ASSERT_TRUE(monitor.watch(dir.path(), &collector));
+    monitor.waitForWatches();
+
+    touch(dir.filePath("1/2/3/a.jpg"));
+
+    const FileSystemChanges changes = collector.wait();
+    EXPECT_THAT(changes.added, testing::ElementsAre(dir.filePath("1/2/3/a.jpg")));
+}
+
+
+TEST(InotifyMonitorTest, reportsRemovedDirectoriesAsDirectories)
+{
+    QTemporaryDir dir;
+    QDir().mkpath(dir.filePath("photos.jpg"));          // directory named like a media file
+
+    ChangesCollector collector;
+    InotifyMonitor monitor(std::make_unique<EmptyLogger>());
+    ASSERT_TRUE(monitor.watch(dir.path(), &collector));
+    monitor.waitForWatches();
+
+    QDir().rmdir(dir.filePath("photos.jpg"));
+
+    const FileSystemChanges changes = collector.wait();
+    EXPECT_THAT(changes.removed, Contains(IsRemoval(dir.filePath("photos.jpg"), true)));
+}
@@ -80,6 +80,8 @@ QString ProjectInfo::getInternalLocation(InternalData dataType) const
     {
         case Database:          subdir = "db";          break;
         case PrivateMultimedia: subdir = "multimedia";  break;
+        case Thumbnails:        subdir = "thumbnails";  break;
+        case Cache:             subdir = "cache";       break;
     }
 
     const QString result = QString("%1/%2").arg(internalLocation).arg(subdir);
@@ -40,6 +40,8 @@ struct PROJECT_UTILS_EXPORT ProjectInfo
         {
             Database,
             PrivateMultimedia,
+            Thumbnails,
+            Cache,
         };
 
         ProjectInfo(const QString& path);
@@ -6,12 +6,14 @@ class FakeTaskExecutor: public ITaskExecutor
     public:
         void add(std::unique_ptr<ITask>&& task) override
         {
-            task->perform();
+            if (task->isCancelled() == false)
+                task->perform();
         }
 
         void addLight(std::unique_ptr<ITask>&& task) override
         {
-            task->perform();
+            if (task->isCancelled() == false)
+                task->perform();
         }
 
         int heavyWorkers() const override
@@ -0,0 +1,53 @@
+
+#ifndef FILE_SYSTEM_HELPERS_HPP
+#define FILE_SYSTEM_HELPERS_HPP
+
+#include <gmock/gmock.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <photos_crawler/ifile_system_monitor.hpp>
+#include <photos_crawler/ifile_system_scanner.hpp>
+
+
+MATCHER_P2(IsMove, from, to, "")
+{
+    return arg.from == from && arg.to == to;
+}
+
+MATCHER_P2(IsRemoval, path, isDirectory, "")
+{
+    return arg.path == path && arg.isDirectory == isDirectory;
+}
+
+struct FilesCollector: IFileNotifier
+{
+    void found(const QStringList& files) override
+    {
+        batches++;
+        collected.append(files);
+    }
+
+    void finished() override
+    {
+        done = true;
+    }
+
+    QStringList collected;
+    int batches = 0;
+    bool done = false;
+};
+
+/// create empty file (and missing parent directories)
+inline void touch(const QString& path)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    file.open(QFile::WriteOnly);
+}
+
+#endif
@@ -23,11 +23,14 @@ struct MockBackend: public Database::IBackend
   MOCK_METHOD(bool, update, (const std::vector<Photo::DataDelta> &), (override));
 
   MOCK_METHOD(std::vector<TagValue>, listTagValues, (const Tag::Types &, const Database::Filter &), (override));
+  MOCK_METHOD((std::map<QDate, int>), getDatesHistogram, (), (override));
   MOCK_METHOD0(getAllPhotos,
       std::vector<Photo::Id>());
   MOCK_METHOD1(getPhoto,
       Photo::Data(const Photo::Id &));
   MOCK_METHOD(Photo::DataDelta, getPhotoDelta, (const Photo::Id &, const std::set<Photo::Field> &), (override));
+  MOCK_METHOD(std::vector<Photo::DataDelta>, getPhotoDeltas, (const std::vector<Photo::Id> &, const std::set<Photo::Field> &), (override));
+  MOCK_METHOD(std::vector<Photo::DataDelta>, getPhotoDeltas, (const Database::Filter &, const std::set<Photo::Field> &), (override));
   MOCK_METHOD(int, getPhotosCount, (const Database::Filter &), (override));
   MOCK_METHOD0(listPeople,
       std::vector<PersonName>());
@@ -39,10 +42,12 @@ struct MockBackend: public Database::IBackend
       void(const Photo::Id &, const QString &, int value));
   MOCK_METHOD2(get,
       std::optional<int>(const Photo::Id &, const QString &));
+  MOCK_METHOD((std::map<Photo::Id, int>), getFlagValues, (const QString &), (override));
   MOCK_METHOD(void, setBits, (const Photo::Id& id, const QString& name, int bits), (override));
   MOCK_METHOD(void, clearBits, (const Photo::Id& id, const QString& name, int bits), (override));
   MOCK_METHOD(void, setThumbnail, (const Photo::Id &, const QByteArray &), (override));
   MOCK_METHOD(QByteArray, getThumbnail, (const Photo::Id &), (override));
+  MOCK_METHOD((std::vector<std::pair<Photo::Id, QByteArray>>), takeThumbnails, (int), (override));
   MOCK_METHOD0(markStagedAsReviewed,
       std::vector<Photo::Id>());
   MOCK_METHOD1(init,
@@ -1,5 +1,6 @@
 
 #include <gmock/gmock.h>
+#include <QImageReader>
 
 #include <core/imedia_information.hpp>
 
@@ -7,4 +8,5 @@ class MediaInformationMock: public IMediaInformation
 {
 public:
     MOCK_METHOD(FileInformation, getInformation, (const QString &), (const, override));
+    MOCK_METHOD(FileInformation, getInformation, (const QString &, QImageReader &), (const, override));
 };
@@ -7,5 +7,6 @@ struct MockThumbnailsCache: IThumbnailsCache
 {
     MOCK_METHOD(std::optional<QImage>, find, (const Photo::Id &, const IThumbnailsCache::ThumbnailParameters& params), (override));
     MOCK_METHOD(void, store, (const Photo::Id &, const IThumbnailsCache::ThumbnailParameters& params, const QImage &), (override));
+    MOCK_METHOD(void, remove, (const Photo::Id &), (override));
     MOCK_METHOD(void, clear, (), (override));
 };